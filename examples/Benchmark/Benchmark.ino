@@ -0,0 +1,501 @@
+//======================================================================================//
+/**
+ * @file Benchmark.ino
+ * @brief Replays a recorded NMEA log through the library and prints the throughput and the
+ * worst-case latency of each stage. Also compares the fixed-point NMEA_Decoder against the
+ * String toFloat() conversion. On Linux, also prints the scaling of the NMEA_Batch_Parser
+ * with the number of threads. Finally replays the log mixed with UBX and RTCM 3 frames and
+ * prints the throughput of each protocol. No GNSS module is required, so the results can be
+ * compared between the library versions as a performance baseline. Build it on a Linux
+ * host with extras/host, which also counts the heap allocations of each stage.
+ * @date +05:30 10:02:18 AM 17-10-2026, Saturday
+ * @version 1.4.0
+ * @author Vishnu Mohanan (@vishnumaiea)
+ * @par GitHub Repository: https://github.com/CIRCUITSTATE/CSE_GNSS
+ * @par MIT License
+ *
+ */
+//======================================================================================//
+
+#include <Arduino.h>
+#include <CSE_GNSS.h>
+
+// The host build replaces operator new to count the allocations. There is no portable way
+// to count them on the boards, where String uses malloc(), so they are only printed on the
+// host.
+#if defined(CSE_GNSS_HOST)
+  #include <Allocation_Counter.h>
+#endif
+
+//======================================================================================//
+
+#define   PORT_DEBUG_SERIAL       Serial    // Debug serial port
+#define   VAL_DEBUG_BAUDRATE      115200
+
+#define   VAL_ITERATIONS          1000      // Number of times the decoder test is repeated
+#define   VAL_REPLAY_COUNT        100       // Number of times the log is replayed
+#define   VAL_CHUNK_LENGTH        1024      // Number of bytes delivered per read
+#define   VAL_BATCH_REPLAY_COUNT  20000     // Number of copies of the log parsed by the batch parser (Linux)
+
+//======================================================================================//
+// Forward declarations
+
+void setup();
+void loop();
+void runReplayBenchmark();
+void runDecodeBenchmark();
+void runBatchBenchmark();
+void runDemuxBenchmark();
+uint32_t countAllocations();
+
+//======================================================================================//
+/**
+ * @brief The timing results of a single benchmark stage.
+ *
+ */
+struct Benchmark_Stage {
+  const char* name; // The stage name
+  uint32_t callCount; // Number of timed calls
+  uint32_t totalTime; // Total time in microseconds
+  uint32_t maxTime; // Worst-case time of a single call in microseconds
+  uint32_t allocationCount; // Heap allocations made by the calls. Only counted on the host.
+};
+
+//======================================================================================//
+
+// A recorded log from a u-blox receiver, including a sentence with a bad checksum and a
+// proprietary sentence. Replace it with your own recording to benchmark your receiver.
+const char NMEA_Log[] =
+  "$GNRMC,083559.00,A,4717.11437,N,00833.91522,E,0.004,77.52,091202,,,A,V*33\r\n"
+  "$GNGGA,092725.00,4717.11399,N,00833.91590,E,1,08,1.01,499.6,M,48.0,M,,*45\r\n"
+  "$GPGSV,3,1,10,23,38,230,44,29,71,156,47,07,29,116,41,08,09,081,36*7F\r\n"
+  "$GPGSV,3,2,10,10,07,189,,05,05,220,,09,34,274,42,18,25,309,44*72\r\n"
+  "$GPGSV,3,3,10,26,82,187,47,28,43,056,46*77\r\n"
+  "$GNGSA,A,3,23,29,07,08,09,18,26,28,,,,,1.94,1.18,1.54,1*0E\r\n"
+  "$GNVTG,77.52,T,,M,0.004,N,0.008,K,A*18\r\n"
+  "$GNGLL,4717.11364,N,00833.91565,E,092321.00,A,A*7E\r\n"
+  "$GNZDA,082710.00,16,09,2002,00,00*7A\r\n"
+  "$GPTXT,01,01,02,ANTSTATUS=OK*3B\r\n"
+  "$GNRMC,083559.00,A,4717.11437,N,00833.91522,E,0.004,77.52,091202,,,A,V*32\r\n";
+
+const uint16_t NMEA_Log_Sentences = 10; // Valid sentences in one replay of the log
+
+// An RTCM 3 message 1005 (base station position) with its CRC-24Q
+const uint8_t RTCM_Log[] = {
+  0xD3, 0x00, 0x13, 0x3E, 0xD7, 0xD3, 0x02, 0x02, 0x98, 0x0E, 0xDE, 0xEF, 0x34,
+  0xB4, 0xBD, 0x62, 0xAC, 0x09, 0x41, 0x98, 0x6F, 0x33, 0x36, 0x0B, 0x98
+};
+
+// The NMEA log, a UBX-NAV-PVT frame and the RTCM message, built by runDemuxBenchmark()
+uint8_t Mixed_Log [sizeof (NMEA_Log) - 1 + UBX_Nav_Pvt::Length + 8 + sizeof (RTCM_Log)];
+
+// The log is read through a memory source instead of a serial port.
+NMEA_Memory_Source NMEA_Log_Source;
+CSE_GNSS GNSS_Module (&NMEA_Log_Source, &PORT_DEBUG_SERIAL);
+
+NMEA_Sentence <NMEA_RMC> NMEA_GNRMC;
+NMEA_Sentence <NMEA_GGA> NMEA_GNGGA;
+NMEA_Sentence <NMEA_GSA> NMEA_GNGSA;
+NMEA_Sentence <NMEA_GSV> NMEA_GPGSV ("GP");
+NMEA_Sentence <NMEA_VTG> NMEA_GNVTG;
+NMEA_Sentence <NMEA_GLL> NMEA_GNGLL;
+NMEA_Sentence <NMEA_ZDA> NMEA_GNZDA;
+
+volatile int32_t sinkInteger; // Keeps the compiler from removing the test loops
+volatile float sinkFloat;
+
+uint32_t stageAllocations; // The allocation count when the timed call started
+
+//======================================================================================//
+/**
+ * @brief Setup the serial ports and run the benchmarks.
+ *
+ */
+void setup() {
+  PORT_DEBUG_SERIAL.begin (VAL_DEBUG_BAUDRATE);
+  delay (1000);
+
+  PORT_DEBUG_SERIAL.println();
+  PORT_DEBUG_SERIAL.println ("--- CSE_GNSS [Benchmark] ---");
+
+  GNSS_Module.begin();
+  GNSS_Module.addData (&NMEA_GNRMC);
+  GNSS_Module.addData (&NMEA_GNGGA);
+  GNSS_Module.addData (&NMEA_GNGSA);
+  GNSS_Module.addData (&NMEA_GPGSV);
+  GNSS_Module.addData (&NMEA_GNVTG);
+  GNSS_Module.addData (&NMEA_GNGLL);
+  GNSS_Module.addData (&NMEA_GNZDA);
+
+  runReplayBenchmark();
+  runDecodeBenchmark();
+  runBatchBenchmark();
+  runDemuxBenchmark();
+}
+
+//======================================================================================//
+/**
+ * @brief Runs indefinitely.
+ *
+ */
+void loop() {
+  delay (1000);
+}
+
+//======================================================================================//
+/**
+ * @brief Starts timing a call.
+ *
+ * @return uint32_t The start time.
+ */
+static inline uint32_t startStage() {
+  stageAllocations = countAllocations();
+  return micros();
+}
+
+//======================================================================================//
+/**
+ * @brief Ends timing a call and updates the stage.
+ *
+ * @param stage The stage to update.
+ * @param startTime The time returned by startStage().
+ */
+static inline void endStage (Benchmark_Stage& stage, uint32_t startTime) {
+  uint32_t elapsed = micros() - startTime;
+
+  stage.callCount++;
+  stage.totalTime += elapsed;
+  stage.allocationCount += countAllocations() - stageAllocations;
+
+  if (elapsed > stage.maxTime) {
+    stage.maxTime = elapsed;
+  }
+}
+
+//======================================================================================//
+/**
+ * @brief Prints the results of a stage.
+ *
+ * @param stage The stage to print.
+ * @param byteCount The number of bytes processed by the stage.
+ * @param sentenceCount The number of sentences processed by the stage.
+ */
+void printStage (const Benchmark_Stage& stage, uint32_t byteCount, uint32_t sentenceCount) {
+  float seconds = stage.totalTime / 1000000.0f;
+
+  PORT_DEBUG_SERIAL.print (stage.name);
+  PORT_DEBUG_SERIAL.print (": ");
+  PORT_DEBUG_SERIAL.print (stage.totalTime);
+  PORT_DEBUG_SERIAL.print (" us, ");
+
+  if (seconds > 0) {
+    PORT_DEBUG_SERIAL.print (sentenceCount / seconds, 0);
+    PORT_DEBUG_SERIAL.print (" sentences/s, ");
+    PORT_DEBUG_SERIAL.print (byteCount / seconds, 0);
+    PORT_DEBUG_SERIAL.print (" bytes/s, ");
+  }
+
+  PORT_DEBUG_SERIAL.print ("worst call ");
+  PORT_DEBUG_SERIAL.print (stage.maxTime);
+  PORT_DEBUG_SERIAL.print (" us");
+
+  #if defined(CSE_GNSS_HOST)
+    PORT_DEBUG_SERIAL.print (", ");
+    PORT_DEBUG_SERIAL.print ((float) stage.allocationCount / sentenceCount);
+    PORT_DEBUG_SERIAL.print (" allocations/sentence");
+  #endif
+
+  PORT_DEBUG_SERIAL.println();
+}
+
+//======================================================================================//
+/**
+ * @brief Replays the log through the two ways of using the library. The legacy path reads
+ * each chunk from the memory source with read(), then calls extractNMEA() and find() +
+ * parse() for every sentence type. The streaming path passes the same chunks to feed(),
+ * which frames, dispatches and parses in a single pass.
+ *
+ */
+void runReplayBenchmark() {
+  const uint32_t logLength = sizeof (NMEA_Log) - 1;
+  const uint32_t totalBytes = logLength * VAL_REPLAY_COUNT;
+  const uint32_t totalSentences = (uint32_t) NMEA_Log_Sentences * VAL_REPLAY_COUNT;
+  const uint16_t chunkLength = (VAL_CHUNK_LENGTH < CONST_SERIAL_BUFFER_LENGTH) ? VAL_CHUNK_LENGTH : (CONST_SERIAL_BUFFER_LENGTH - 1);
+
+  Benchmark_Stage readStage = {"read()", 0, 0, 0, 0};
+  Benchmark_Stage extractStage = {"extractNMEA()", 0, 0, 0, 0};
+  Benchmark_Stage findStage = {"find() + parse()", 0, 0, 0, 0};
+  Benchmark_Stage feedStage = {"feed()", 0, 0, 0, 0};
+
+  // The log is delivered in chunks, as the serial port would, so the sentences are cut
+  // at arbitrary points.
+  for (uint16_t replay = 0; replay < VAL_REPLAY_COUNT; replay++) {
+    NMEA_Log_Source.set (NMEA_Log, logLength);
+
+    for (uint32_t offset = 0; offset < logLength; offset += chunkLength) {
+      uint16_t length = ((logLength - offset) < chunkLength) ? (logLength - offset) : chunkLength;
+
+      // Legacy path
+      uint32_t startTime = startStage();
+      GNSS_Module.read (length);
+      endStage (readStage, startTime);
+
+      startTime = startStage();
+      GNSS_Module.extractNMEA();
+      endStage (extractStage, startTime);
+
+      String lines = GNSS_Module.getNmeaDataString();
+
+      for (int i = 0; i < GNSS_Module.getDataCount(); i++) {
+        startTime = startStage();
+        GNSS_Module.getDataRef (i).find (lines);
+        endStage (findStage, startTime);
+      }
+
+      // Streaming path
+      startTime = startStage();
+      GNSS_Module.feed (NMEA_Log + offset, length);
+      endStage (feedStage, startTime);
+    }
+  }
+
+  PORT_DEBUG_SERIAL.print ("Replayed ");
+  PORT_DEBUG_SERIAL.print (totalBytes);
+  PORT_DEBUG_SERIAL.print (" bytes, ");
+  PORT_DEBUG_SERIAL.print (totalSentences);
+  PORT_DEBUG_SERIAL.println (" sentences.");
+
+  printStage (readStage, totalBytes, totalSentences);
+  printStage (extractStage, totalBytes, totalSentences);
+  printStage (findStage, totalBytes, totalSentences);
+  printStage (feedStage, totalBytes, totalSentences);
+
+  PORT_DEBUG_SERIAL.println();
+}
+
+//======================================================================================//
+/**
+ * @brief Decodes the latitude, longitude, time, speed and course of an RMC sentence with
+ * NMEA_Decoder and with String::toFloat(), and prints the average time for each.
+ *
+ */
+void runDecodeBenchmark() {
+  NMEA_GNRMC.set (NMEA_RMC::Sample);
+  NMEA_GNRMC.parse();
+
+  NMEA_Fix fix = {};
+  uint32_t startTime = micros();
+
+  for (uint16_t i = 0; i < VAL_ITERATIONS; i++) {
+    NMEA_GNRMC.decode (fix);
+    sinkInteger = fix.latitude;
+  }
+
+  uint32_t fixedTime = micros() - startTime;
+
+  // The same fields converted with String. The minutes are converted to degrees as most
+  // applications would do.
+  String latitude = NMEA_GNRMC.get <NMEA_RMC::Latitude>().toString();
+  String longitude = NMEA_GNRMC.get <NMEA_RMC::Longitude>().toString();
+  String time = NMEA_GNRMC.get <NMEA_RMC::UTC>().toString();
+  String speed = NMEA_GNRMC.get <NMEA_RMC::Speed>().toString();
+  String course = NMEA_GNRMC.get <NMEA_RMC::Course>().toString();
+
+  startTime = micros();
+
+  for (uint16_t i = 0; i < VAL_ITERATIONS; i++) {
+    float value = latitude.toFloat();
+    float degrees = (int) (value / 100);
+    sinkFloat = degrees + ((value - (degrees * 100)) / 60);
+
+    value = longitude.toFloat();
+    degrees = (int) (value / 100);
+    sinkFloat = degrees + ((value - (degrees * 100)) / 60);
+
+    sinkFloat = time.toFloat();
+    sinkFloat = speed.toFloat() * 0.514444f;
+    sinkFloat = course.toFloat();
+  }
+
+  uint32_t floatTime = micros() - startTime;
+
+  PORT_DEBUG_SERIAL.print ("NMEA_Decoder: ");
+  PORT_DEBUG_SERIAL.print ((float) fixedTime / VAL_ITERATIONS);
+  PORT_DEBUG_SERIAL.println (" us per sentence");
+
+  PORT_DEBUG_SERIAL.print ("String::toFloat(): ");
+  PORT_DEBUG_SERIAL.print ((float) floatTime / VAL_ITERATIONS);
+  PORT_DEBUG_SERIAL.println (" us per sentence");
+
+  PORT_DEBUG_SERIAL.print ("Latitude (deg x 10^7): ");
+  PORT_DEBUG_SERIAL.println (fix.latitude);
+  PORT_DEBUG_SERIAL.print ("Longitude (deg x 10^7): ");
+  PORT_DEBUG_SERIAL.println (fix.longitude);
+}
+
+//======================================================================================//
+/**
+ * @brief Parses many copies of the log with the NMEA_Batch_Parser, with 1, 2, 4.. threads
+ * up to the number of cores, and prints the throughput and the speedup of each. Only on
+ * Linux.
+ *
+ */
+void runBatchBenchmark() {
+  #if defined(__linux__)
+    size_t logLength = sizeof (NMEA_Log) - 1;
+    size_t batchLength = logLength * VAL_BATCH_REPLAY_COUNT;
+    char* batchLog = new char [batchLength];
+
+    for (uint32_t i = 0; i < VAL_BATCH_REPLAY_COUNT; i++) {
+      memcpy (batchLog + (i * logLength), NMEA_Log, logLength);
+    }
+
+    NMEA_Batch_Parser batchParser;
+    unsigned coreCount = batchParser.getThreadCount();
+    uint32_t singleTime = 0;
+
+    PORT_DEBUG_SERIAL.print ("Batch log: ");
+    PORT_DEBUG_SERIAL.print ((uint32_t) batchLength);
+    PORT_DEBUG_SERIAL.print (" bytes, ");
+    PORT_DEBUG_SERIAL.print (coreCount);
+    PORT_DEBUG_SERIAL.println (" cores");
+
+    for (unsigned threadCount = 1; ; threadCount *= 2) {
+      if (threadCount > coreCount) {
+        threadCount = coreCount;
+      }
+
+      batchParser.setThreadCount (threadCount);
+
+      uint32_t startTime = micros();
+      batchParser.parse (batchLog, batchLength, nullptr);
+      uint32_t batchTime = micros() - startTime;
+
+      if (threadCount == 1) {
+        singleTime = batchTime;
+      }
+
+      PORT_DEBUG_SERIAL.print ("  ");
+      PORT_DEBUG_SERIAL.print (threadCount);
+      PORT_DEBUG_SERIAL.print (" threads: ");
+      PORT_DEBUG_SERIAL.print ((float) batchLength / batchTime);
+      PORT_DEBUG_SERIAL.print (" MB/s, ");
+      PORT_DEBUG_SERIAL.print (batchParser.getSentenceCount());
+      PORT_DEBUG_SERIAL.print (" sentences, speedup x");
+      PORT_DEBUG_SERIAL.println ((float) singleTime / batchTime);
+
+      if (threadCount == coreCount) {
+        break;
+      }
+    }
+
+    delete [] batchLog;
+  #endif
+}
+
+//======================================================================================//
+/**
+ * @brief Replays the log mixed with a UBX-NAV-PVT frame and an RTCM 3 frame after every
+ * copy, as on the port of an RTK receiver. The demultiplexer splits the chunks between the
+ * three framers in a single pass. Prints the bytes, the frames and the throughput of each
+ * protocol.
+ *
+ */
+void runDemuxBenchmark() {
+  const uint32_t logLength = sizeof (NMEA_Log) - 1;
+  uint8_t* frame = Mixed_Log + logLength;
+
+  // A NAV-PVT frame with a 3D fix. The rest of the payload is 0.
+  memcpy (Mixed_Log, NMEA_Log, logLength);
+  memset (frame, 0, UBX_Nav_Pvt::Length + 8);
+  frame [0] = UBX_Frame::Sync1;
+  frame [1] = UBX_Frame::Sync2;
+  frame [2] = UBX_Nav_Pvt::Class;
+  frame [3] = UBX_Nav_Pvt::Id;
+  frame [4] = UBX_Nav_Pvt::Length;
+  frame [6 + 20] = 3; // Fix type
+  frame [6 + 21] = 0x01; // Fix OK
+
+  uint8_t checksumA = 0, checksumB = 0;
+  UBX_Framer::computeChecksum (frame + 2, UBX_Nav_Pvt::Length + 4, checksumA, checksumB);
+  frame [UBX_Nav_Pvt::Length + 6] = checksumA;
+  frame [UBX_Nav_Pvt::Length + 7] = checksumB;
+  memcpy (frame + UBX_Nav_Pvt::Length + 8, RTCM_Log, sizeof (RTCM_Log));
+
+  UBX_Framer ubxFramer;
+  RTCM_Framer rtcmFramer;
+
+  GNSS_Module.setUbxFramer (&ubxFramer);
+  GNSS_Module.setRtcmFramer (&rtcmFramer);
+
+  const GNSS_Demux& demux = GNSS_Module.getDemux();
+  const uint32_t sentenceCount = demux.getNmeaFramer()->getSentenceCount();
+  const uint32_t nmeaBytes = demux.getByteCount (GNSS_Demux::PROTOCOL_NMEA);
+  uint32_t feedTime = 0;
+
+  for (uint16_t replay = 0; replay < VAL_REPLAY_COUNT; replay++) {
+    for (uint32_t offset = 0; offset < sizeof (Mixed_Log); offset += VAL_CHUNK_LENGTH) {
+      uint32_t length = ((sizeof (Mixed_Log) - offset) < VAL_CHUNK_LENGTH) ? (sizeof (Mixed_Log) - offset) : VAL_CHUNK_LENGTH;
+      uint32_t startTime = micros();
+      GNSS_Module.feed ((const char*) Mixed_Log + offset, length);
+      feedTime += micros() - startTime;
+    }
+  }
+
+  float seconds = feedTime / 1000000.0f;
+  const char* names [] = {"NMEA", "UBX", "RTCM"};
+  uint32_t bytes [] = {
+    demux.getByteCount (GNSS_Demux::PROTOCOL_NMEA) - nmeaBytes,
+    demux.getByteCount (GNSS_Demux::PROTOCOL_UBX),
+    demux.getByteCount (GNSS_Demux::PROTOCOL_RTCM)
+  };
+  uint32_t frames [] = {
+    demux.getNmeaFramer()->getSentenceCount() - sentenceCount,
+    ubxFramer.getFrameCount(),
+    rtcmFramer.getFrameCount()
+  };
+
+  PORT_DEBUG_SERIAL.println();
+  PORT_DEBUG_SERIAL.print ("Mixed stream: ");
+  PORT_DEBUG_SERIAL.print ((uint32_t) sizeof (Mixed_Log) * VAL_REPLAY_COUNT);
+  PORT_DEBUG_SERIAL.print (" bytes in ");
+  PORT_DEBUG_SERIAL.print (feedTime);
+  PORT_DEBUG_SERIAL.println (" us");
+
+  for (uint8_t i = 0; i < 3; i++) {
+    PORT_DEBUG_SERIAL.print ("  ");
+    PORT_DEBUG_SERIAL.print (names [i]);
+    PORT_DEBUG_SERIAL.print (": ");
+    PORT_DEBUG_SERIAL.print (bytes [i]);
+    PORT_DEBUG_SERIAL.print (" bytes, ");
+    PORT_DEBUG_SERIAL.print (frames [i]);
+    PORT_DEBUG_SERIAL.print (" frames");
+
+    if (seconds > 0) {
+      PORT_DEBUG_SERIAL.print (", ");
+      PORT_DEBUG_SERIAL.print (bytes [i] / seconds, 0);
+      PORT_DEBUG_SERIAL.print (" bytes/s");
+    }
+
+    PORT_DEBUG_SERIAL.println();
+  }
+
+  GNSS_Module.setUbxFramer (nullptr);
+  GNSS_Module.setRtcmFramer (nullptr);
+}
+
+//======================================================================================//
+/**
+ * @brief Returns the number of heap allocations made so far, on the host.
+ *
+ * @return uint32_t The allocation count. 0 on the boards.
+ */
+uint32_t countAllocations() {
+  #if defined(CSE_GNSS_HOST)
+    return getAllocationCount();
+  #else
+    return 0;
+  #endif
+}
+
+//======================================================================================//
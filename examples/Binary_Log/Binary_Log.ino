@@ -0,0 +1,155 @@
+//======================================================================================//
+/**
+ * @file Binary_Log.ino
+ * @brief Groups the sentences into epochs and encodes each epoch to a compact binary record,
+ * which is sent to a second serial port, such as a radio or a serial data logger. The
+ * records are also decoded back to check them, and the size of the records is compared
+ * with the size of the NMEA text every ten seconds.
+ * @date +05:30 02:31:08 AM 17-10-2026, Saturday
+ * @version 1.0.0
+ * @author Vishnu Mohanan (@vishnumaiea)
+ * @par GitHub Repository: https://github.com/CIRCUITSTATE/CSE_GNSS
+ * @par MIT License
+ *
+ */
+//======================================================================================//
+
+#include <Arduino.h>
+#include <CSE_GNSS.h>
+
+//======================================================================================//
+
+#define   PORT_GPS_SERIAL         Serial1   // GPS serial port
+#define   PORT_LOG_SERIAL         Serial2   // Serial port of the radio or the data logger
+#define   PORT_DEBUG_SERIAL       Serial    // Debug serial port
+
+// For RP2040
+#define   PIN_GPS_SERIAL_TX       0
+#define   PIN_GPS_SERIAL_RX       1
+#define   PIN_LOG_SERIAL_TX       4
+#define   PIN_LOG_SERIAL_RX       5
+
+#define   VAL_GPS_BAUDRATE        115200
+#define   VAL_LOG_BAUDRATE        9600
+#define   VAL_DEBUG_BAUDRATE      115200
+
+//======================================================================================//
+// Forward declarations
+
+void setup();
+void loop();
+void onSentence (NMEA_0183_Data& data, void* context);
+void onEpoch (const NMEA_Fix& fix, void* context);
+void onDecodedEpoch (const NMEA_Fix& fix, void* context);
+
+//======================================================================================//
+
+CSE_GNSS GNSS_Module (&PORT_GPS_SERIAL, &PORT_DEBUG_SERIAL);
+
+NMEA_Epoch GNSS_Epoch;
+NMEA_Record_Writer Record_Writer;
+NMEA_Record_Reader Record_Reader; // Only used to check the records
+
+uint32_t textBytes = 0; // Bytes of the NMEA sentences
+uint32_t recordBytes = 0; // Bytes of the binary records
+uint32_t mismatchCount = 0; // Records that did not decode to the same fix
+
+//======================================================================================//
+/**
+ * @brief Setup the serial ports, the epoch and the handlers.
+ *
+ */
+void setup() {
+  PORT_DEBUG_SERIAL.begin (VAL_DEBUG_BAUDRATE);
+
+  PORT_GPS_SERIAL.setRX (PIN_GPS_SERIAL_RX);
+  PORT_GPS_SERIAL.setTX (PIN_GPS_SERIAL_TX);
+  PORT_GPS_SERIAL.begin (VAL_GPS_BAUDRATE, SERIAL_8N1);
+
+  PORT_LOG_SERIAL.setRX (PIN_LOG_SERIAL_RX);
+  PORT_LOG_SERIAL.setTX (PIN_LOG_SERIAL_TX);
+  PORT_LOG_SERIAL.begin (VAL_LOG_BAUDRATE, SERIAL_8N1);
+
+  GNSS_Module.begin();
+  GNSS_Module.setEpoch (&GNSS_Epoch);
+  GNSS_Module.setHandler (onSentence);
+  GNSS_Epoch.setHandler (onEpoch);
+  Record_Reader.setHandler (onDecodedEpoch);
+
+  PORT_DEBUG_SERIAL.println();
+  PORT_DEBUG_SERIAL.println ("--- CSE_GNSS [Binary_Log] ---");
+}
+
+//======================================================================================//
+/**
+ * @brief Feeds the received bytes to the library and prints the sizes every ten seconds.
+ *
+ */
+void loop() {
+  static uint32_t lastReportTime = 0;
+
+  GNSS_Module.update();
+
+  if ((millis() - lastReportTime) >= 10000) {
+    lastReportTime = millis();
+
+    PORT_DEBUG_SERIAL.print ("NMEA: ");
+    PORT_DEBUG_SERIAL.print (textBytes);
+    PORT_DEBUG_SERIAL.print (" bytes, Records: ");
+    PORT_DEBUG_SERIAL.print (recordBytes);
+    PORT_DEBUG_SERIAL.print (" bytes, Ratio: ");
+    PORT_DEBUG_SERIAL.print ((recordBytes > 0) ? ((float) textBytes / recordBytes) : 0);
+    PORT_DEBUG_SERIAL.print (", Mismatches: ");
+    PORT_DEBUG_SERIAL.println (mismatchCount);
+  }
+}
+
+//======================================================================================//
+/**
+ * @brief Counts the bytes of every sentence, including the line ending.
+ *
+ * @param data The parsed sentence.
+ * @param context Not used.
+ */
+void onSentence (NMEA_0183_Data& data, void* context) {
+  (void) context;
+  textBytes += data.sentenceLength + 2;
+}
+
+//======================================================================================//
+/**
+ * @brief Encodes each epoch to a record and sends it to the log port.
+ *
+ * @param fix The epoch.
+ * @param context Not used.
+ */
+void onEpoch (const NMEA_Fix& fix, void* context) {
+  (void) context;
+
+  uint8_t record [NMEA_Record::MaxLength];
+  uint8_t recordLength = Record_Writer.encode (fix, record);
+
+  PORT_LOG_SERIAL.write (record, recordLength);
+  recordBytes += recordLength;
+
+  // Decode the record back and compare it with the epoch.
+  Record_Reader.feed (record, recordLength);
+
+  if (Record_Reader.getFix() != fix) {
+    mismatchCount++;
+  }
+}
+
+//======================================================================================//
+/**
+ * @brief Called for each decoded record. A receiver of the records would use the fix here.
+ *
+ * @param fix The decoded fix.
+ * @param context Not used.
+ */
+void onDecodedEpoch (const NMEA_Fix& fix, void* context) {
+  (void) fix;
+  (void) context;
+}
+
+//======================================================================================//
@@ -0,0 +1,122 @@
+//======================================================================================//
+/**
+ * @file Callbacks.ino
+ * @brief Reads the GNSS module without blocking and handles each sentence as soon as it is
+ * received, using a handler for the RMC sentences and a catch-all handler for the rest.
+ * @date +05:30 12:18:32 AM 17-10-2026, Saturday
+ * @version 1.0.0
+ * @author Vishnu Mohanan (@vishnumaiea)
+ * @par GitHub Repository: https://github.com/CIRCUITSTATE/CSE_GNSS
+ * @par MIT License
+ *
+ */
+//======================================================================================//
+
+#include <Arduino.h>
+#include <CSE_GNSS.h>
+
+//======================================================================================//
+
+#define   PORT_GPS_SERIAL         Serial1   // GPS serial port
+#define   PORT_DEBUG_SERIAL       Serial    // Debug serial port
+
+// For RP2040
+#define   PIN_GPS_SERIAL_TX       0
+#define   PIN_GPS_SERIAL_RX       1
+
+// // For ESP32
+// #define   PIN_GPS_SERIAL_TX       16
+// #define   PIN_GPS_SERIAL_RX       17
+
+#define   VAL_GPS_BAUDRATE        115200
+#define   VAL_DEBUG_BAUDRATE      115200
+
+//======================================================================================//
+// Forward declarations
+
+void setup();
+void loop();
+void onRMC (NMEA_0183_Data& data, void* context);
+void onSentence (NMEA_0183_Data& data, void* context);
+
+//======================================================================================//
+
+CSE_GNSS GNSS_Module (&PORT_GPS_SERIAL, &PORT_DEBUG_SERIAL);
+
+NMEA_Sentence <NMEA_RMC> NMEA_GNRMC; // Talker ID is GN by default
+
+NMEA_Fix GNSS_Fix = {}; // The latest decoded fix
+
+//======================================================================================//
+/**
+ * @brief Setup the serial ports and the handlers.
+ *
+ */
+void setup() {
+  PORT_DEBUG_SERIAL.begin (VAL_DEBUG_BAUDRATE);
+
+  // // For ESP32 boards
+  // PORT_GPS_SERIAL.begin (VAL_GPS_BAUDRATE, SERIAL_8N1, PIN_GPS_SERIAL_RX, PIN_GPS_SERIAL_TX);
+
+  // For RP2040
+  PORT_GPS_SERIAL.setRX (PIN_GPS_SERIAL_RX);
+  PORT_GPS_SERIAL.setTX (PIN_GPS_SERIAL_TX);
+  PORT_GPS_SERIAL.begin (VAL_GPS_BAUDRATE, SERIAL_8N1);
+
+  GNSS_Module.begin();
+  GNSS_Module.addData (&NMEA_GNRMC);
+
+  NMEA_GNRMC.setHandler (onRMC, &GNSS_Fix); // Called for every valid GNRMC sentence
+  GNSS_Module.setHandler (onSentence); // Called for every valid sentence
+
+  PORT_DEBUG_SERIAL.println();
+  PORT_DEBUG_SERIAL.println ("--- CSE_GNSS [Callbacks] ---");
+}
+
+//======================================================================================//
+/**
+ * @brief Feeds the received bytes to the library. The handlers are called from here.
+ *
+ */
+void loop() {
+  GNSS_Module.update();
+}
+
+//======================================================================================//
+/**
+ * @brief Decodes the RMC sentence to the fix passed as the context and prints the position.
+ *
+ * @param data The parsed GNRMC sentence.
+ * @param context The NMEA_Fix to update.
+ */
+void onRMC (NMEA_0183_Data& data, void* context) {
+  NMEA_Fix& fix = *static_cast <NMEA_Fix*> (context);
+  static_cast <NMEA_Sentence <NMEA_RMC>&> (data).decode (fix);
+
+  if ((fix.flags & NMEA_Fix::FLAG_POSITION) && (fix.flags & NMEA_Fix::FLAG_VALID)) {
+    PORT_DEBUG_SERIAL.print ("Position (deg x 10^7): ");
+    PORT_DEBUG_SERIAL.print (fix.latitude);
+    PORT_DEBUG_SERIAL.print (", ");
+    PORT_DEBUG_SERIAL.println (fix.longitude);
+  }
+}
+
+//======================================================================================//
+/**
+ * @brief Prints the header and the number of fields of every sentence.
+ *
+ * @param data The parsed sentence.
+ * @param context Not used.
+ */
+void onSentence (NMEA_0183_Data& data, void* context) {
+  (void) context;
+
+  NMEA_Field header = data.getField (0);
+
+  PORT_DEBUG_SERIAL.write (header.data, header.length);
+  PORT_DEBUG_SERIAL.print (": ");
+  PORT_DEBUG_SERIAL.print (data.getFieldCount());
+  PORT_DEBUG_SERIAL.println (" fields");
+}
+
+//======================================================================================//
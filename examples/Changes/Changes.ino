@@ -0,0 +1,130 @@
+//======================================================================================//
+/**
+ * @file Changes.ino
+ * @brief Handles the RMC sentences only when a field other than the time and the date
+ * changed, and prints which fields did. The epochs are reported only when the position
+ * moves by more than a few metres, or the fix is lost or regained, as a mostly stationary
+ * tracker would send them to its uplink.
+ * @date +05:30 09:14:22 AM 17-10-2026, Saturday
+ * @version 1.0.0
+ * @author Vishnu Mohanan (@vishnumaiea)
+ * @par GitHub Repository: https://github.com/CIRCUITSTATE/CSE_GNSS
+ * @par MIT License
+ *
+ */
+//======================================================================================//
+
+#include <Arduino.h>
+#include <CSE_GNSS.h>
+
+//======================================================================================//
+
+#define   PORT_GPS_SERIAL         Serial1   // GPS serial port
+#define   PORT_DEBUG_SERIAL       Serial    // Debug serial port
+
+// For RP2040
+#define   PIN_GPS_SERIAL_TX       0
+#define   PIN_GPS_SERIAL_RX       1
+
+#define   VAL_GPS_BAUDRATE        115200
+#define   VAL_DEBUG_BAUDRATE      115200
+
+#define   VAL_POSITION_THRESHOLD  5000      // The distance in millimetres to report a new fix
+
+//======================================================================================//
+// Forward declarations
+
+void setup();
+void loop();
+void onRMC (NMEA_0183_Data& data, void* context);
+void onEpoch (const NMEA_Fix& fix, void* context);
+
+//======================================================================================//
+
+CSE_GNSS GNSS_Module (&PORT_GPS_SERIAL, &PORT_DEBUG_SERIAL);
+
+NMEA_Sentence <NMEA_RMC> NMEA_GNRMC; // Talker ID is GN by default
+
+// The time and the date change without the receiver moving.
+NMEA_Change_Tracker rmcChanges ((1UL << NMEA_RMC::UTC) | (1UL << NMEA_RMC::Date));
+
+NMEA_Epoch GNSS_Epoch;
+
+//======================================================================================//
+/**
+ * @brief Setup the serial ports, the change tracker and the epoch.
+ *
+ */
+void setup() {
+  PORT_DEBUG_SERIAL.begin (VAL_DEBUG_BAUDRATE);
+
+  // For RP2040
+  PORT_GPS_SERIAL.setRX (PIN_GPS_SERIAL_RX);
+  PORT_GPS_SERIAL.setTX (PIN_GPS_SERIAL_TX);
+  PORT_GPS_SERIAL.begin (VAL_GPS_BAUDRATE, SERIAL_8N1);
+
+  GNSS_Module.begin();
+  GNSS_Module.addData (&NMEA_GNRMC);
+  NMEA_GNRMC.setChangeTracker (&rmcChanges);
+  NMEA_GNRMC.setHandler (onRMC);
+
+  GNSS_Epoch.setPositionThreshold (VAL_POSITION_THRESHOLD);
+  GNSS_Epoch.setHandler (onEpoch);
+  GNSS_Module.setEpoch (&GNSS_Epoch);
+
+  PORT_DEBUG_SERIAL.println();
+  PORT_DEBUG_SERIAL.println ("--- CSE_GNSS [Changes] ---");
+}
+
+//======================================================================================//
+/**
+ * @brief Feeds the received bytes to the library.
+ *
+ */
+void loop() {
+  GNSS_Module.update();
+}
+
+//======================================================================================//
+/**
+ * @brief Prints the fields of the RMC sentence that changed. Not called for the sentences
+ * in which only the time and the date changed.
+ *
+ * @param data The parsed GNRMC sentence.
+ * @param context Not used.
+ */
+void onRMC (NMEA_0183_Data& data, void* context) {
+  (void) context;
+  PORT_DEBUG_SERIAL.print ("RMC changed:");
+
+  for (uint8_t i = 1; i < NMEA_RMC::Checksum; i++) {
+    if (data.isChanged (i) && (i != NMEA_RMC::UTC) && (i != NMEA_RMC::Date)) {
+      PORT_DEBUG_SERIAL.print (' ');
+      PORT_DEBUG_SERIAL.print (NMEA_RMC::Info.fieldNames [i]);
+    }
+  }
+
+  PORT_DEBUG_SERIAL.print (", Unchanged so far: ");
+  PORT_DEBUG_SERIAL.println (rmcChanges.getUnchangedCount());
+}
+
+//======================================================================================//
+/**
+ * @brief Prints the epochs that moved by more than the threshold.
+ *
+ * @param fix The epoch.
+ * @param context Not used.
+ */
+void onEpoch (const NMEA_Fix& fix, void* context) {
+  (void) context;
+  PORT_DEBUG_SERIAL.print ("Fix: ");
+  PORT_DEBUG_SERIAL.print (fix.latitude);
+  PORT_DEBUG_SERIAL.print (", ");
+  PORT_DEBUG_SERIAL.print (fix.longitude);
+  PORT_DEBUG_SERIAL.print (", Valid: ");
+  PORT_DEBUG_SERIAL.print ((fix.flags & NMEA_Fix::FLAG_VALID) ? "Yes" : "No");
+  PORT_DEBUG_SERIAL.print (", Skipped: ");
+  PORT_DEBUG_SERIAL.println (GNSS_Epoch.getSkippedCount());
+}
+
+//======================================================================================//
@@ -0,0 +1,122 @@
+//======================================================================================//
+/**
+ * @file Configure.ino
+ * @brief Finds the baudrate of an MTK GNSS module (eg. the Quectel L80 or the Adafruit
+ * Ultimate GPS), configures it to send only the RMC and GGA sentences at 5 Hz and 115200 bps,
+ * and then prints the RMC sentences. Change VAL_GPS_RECEIVER for u-blox or CASIC (eg.
+ * ATGM336H) modules.
+ * @date +05:30 03:41:10 AM 17-10-2026, Saturday
+ * @version 1.1.0
+ * @author Vishnu Mohanan (@vishnumaiea)
+ * @par GitHub Repository: https://github.com/CIRCUITSTATE/CSE_GNSS
+ * @par MIT License
+ *
+ */
+//======================================================================================//
+
+#include <Arduino.h>
+#include <CSE_GNSS.h>
+
+//======================================================================================//
+
+#define   PORT_GPS_SERIAL         Serial1   // GPS serial port
+#define   PORT_DEBUG_SERIAL       Serial    // Debug serial port
+
+// For RP2040
+#define   PIN_GPS_SERIAL_TX       0
+#define   PIN_GPS_SERIAL_RX       1
+
+#define   VAL_GPS_BAUDRATE        9600      // The expected baudrate of the module. Tried first by detectBaud().
+#define   VAL_GPS_NEW_BAUDRATE    115200    // The baudrate to switch to
+#define   VAL_GPS_INTERVAL        200       // The fix interval in milliseconds
+#define   VAL_GPS_RECEIVER        NMEA_Command::RECEIVER_MTK
+#define   VAL_DEBUG_BAUDRATE      115200
+
+//======================================================================================//
+// Forward declarations
+
+void setup();
+void loop();
+void printResult (const char* name, bool result);
+void onRMC (NMEA_0183_Data& data, void* context);
+
+//======================================================================================//
+
+// The port type is given, so that the library can start it again at the new baudrate.
+CSE_GNSS GNSS_Module (&PORT_GPS_SERIAL, &PORT_DEBUG_SERIAL, VAL_GPS_BAUDRATE);
+
+NMEA_Sentence <NMEA_RMC> NMEA_GNRMC; // Talker ID is GN by default
+
+//======================================================================================//
+/**
+ * @brief Setup the serial ports and configure the GNSS module.
+ *
+ */
+void setup() {
+  PORT_DEBUG_SERIAL.begin (VAL_DEBUG_BAUDRATE);
+  delay (1000);
+
+  PORT_GPS_SERIAL.setRX (PIN_GPS_SERIAL_RX);
+  PORT_GPS_SERIAL.setTX (PIN_GPS_SERIAL_TX);
+
+  GNSS_Module.begin();
+  GNSS_Module.addData (&NMEA_GNRMC);
+  NMEA_GNRMC.setHandler (onRMC);
+
+  PORT_DEBUG_SERIAL.println();
+  PORT_DEBUG_SERIAL.println ("--- CSE_GNSS [Configure] ---");
+
+  // The module may still be at the baudrate set by a previous run of this sketch.
+  uint32_t baud = GNSS_Module.detectBaud();
+
+  if (baud == 0) {
+    PORT_DEBUG_SERIAL.println ("No GNSS module found.");
+    return;
+  }
+
+  PORT_DEBUG_SERIAL.print ("Detected baudrate: ");
+  PORT_DEBUG_SERIAL.print (baud);
+  PORT_DEBUG_SERIAL.print (", first sentence after ");
+  PORT_DEBUG_SERIAL.print (GNSS_Module.getFirstSentenceTime());
+  PORT_DEBUG_SERIAL.println (" ms");
+
+  // Fewer sentences leave room for the higher rate, even at a low baudrate.
+  printResult ("Sentence mask", GNSS_Module.setSentenceMask (VAL_GPS_RECEIVER, NMEA_Command::SENTENCE_RMC | NMEA_Command::SENTENCE_GGA));
+  printResult ("Baudrate", GNSS_Module.setReceiverBaud (VAL_GPS_RECEIVER, VAL_GPS_NEW_BAUDRATE));
+  printResult ("Output rate", GNSS_Module.setOutputRate (VAL_GPS_RECEIVER, VAL_GPS_INTERVAL));
+}
+
+//======================================================================================//
+/**
+ * @brief Feeds the received bytes to the library. The handler is called from here.
+ *
+ */
+void loop() {
+  GNSS_Module.update();
+}
+
+//======================================================================================//
+/**
+ * @brief Prints each RMC sentence.
+ *
+ * @param data The parsed GNRMC sentence.
+ * @param context Not used.
+ */
+void onRMC (NMEA_0183_Data& data, void* context) {
+  (void) context;
+  data.print();
+}
+
+//======================================================================================//
+/**
+ * @brief Prints the result of a configuration step.
+ *
+ * @param name The name of the step.
+ * @param result The result.
+ */
+void printResult (const char* name, bool result) {
+  PORT_DEBUG_SERIAL.print (name);
+  PORT_DEBUG_SERIAL.println (result ? ": OK" : ": Failed");
+}
+
+//======================================================================================//
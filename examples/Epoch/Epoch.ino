@@ -0,0 +1,143 @@
+//======================================================================================//
+/**
+ * @file Epoch.ino
+ * @brief Assembles the sentences of each navigation epoch into a single fix on the first
+ * core of the RP2040, and prints every new epoch from the second core. The second core
+ * reads the epoch without any locks and always gets the values of the same epoch.
+ * @date +05:30 01:12:47 AM 17-10-2026, Saturday
+ * @version 1.0.0
+ * @author Vishnu Mohanan (@vishnumaiea)
+ * @par GitHub Repository: https://github.com/CIRCUITSTATE/CSE_GNSS
+ * @par MIT License
+ *
+ */
+//======================================================================================//
+
+#include <Arduino.h>
+#include <CSE_GNSS.h>
+
+//======================================================================================//
+
+#define   PORT_GPS_SERIAL         Serial1   // GPS serial port
+#define   PORT_DEBUG_SERIAL       Serial    // Debug serial port
+
+// For RP2040
+#define   PIN_GPS_SERIAL_TX       0
+#define   PIN_GPS_SERIAL_RX       1
+
+#define   VAL_GPS_BAUDRATE        115200
+#define   VAL_DEBUG_BAUDRATE      115200
+
+#define   VAL_LAST_SENTENCE       "GLL"     // The last sentence of each epoch sent by the receiver. "" if unknown.
+
+//======================================================================================//
+// Forward declarations
+
+void setup();
+void loop();
+void setup1();
+void loop1();
+void printFix (const NMEA_Fix& fix);
+
+//======================================================================================//
+
+CSE_GNSS GNSS_Module (&PORT_GPS_SERIAL, &PORT_DEBUG_SERIAL);
+
+// Written by core 0 and read by core 1. No data objects are needed.
+NMEA_Epoch GNSS_Epoch;
+
+//======================================================================================//
+/**
+ * @brief Setup the serial ports and the epoch on core 0.
+ *
+ */
+void setup() {
+  PORT_DEBUG_SERIAL.begin (VAL_DEBUG_BAUDRATE);
+
+  PORT_GPS_SERIAL.setRX (PIN_GPS_SERIAL_RX);
+  PORT_GPS_SERIAL.setTX (PIN_GPS_SERIAL_TX);
+  PORT_GPS_SERIAL.begin (VAL_GPS_BAUDRATE, SERIAL_8N1);
+
+  GNSS_Module.begin();
+  GNSS_Epoch.setLastSentence (VAL_LAST_SENTENCE);
+  GNSS_Module.setEpoch (&GNSS_Epoch);
+
+  PORT_DEBUG_SERIAL.println();
+  PORT_DEBUG_SERIAL.println ("--- CSE_GNSS [Epoch] ---");
+}
+
+//======================================================================================//
+/**
+ * @brief Feeds the received bytes to the library. The epochs are published from here.
+ *
+ */
+void loop() {
+  GNSS_Module.update();
+}
+
+//======================================================================================//
+/**
+ * @brief Nothing to setup on core 1.
+ *
+ */
+void setup1() {
+}
+
+//======================================================================================//
+/**
+ * @brief Prints each new epoch on core 1.
+ *
+ */
+void loop1() {
+  static NMEA_Ring_Index lastSequence = 0;
+
+  if (GNSS_Epoch.getSequence() == lastSequence) {
+    return;
+  }
+
+  NMEA_Fix fix;
+
+  if (GNSS_Epoch.read (fix)) {
+    lastSequence = GNSS_Epoch.getSequence();
+    printFix (fix);
+  }
+}
+
+//======================================================================================//
+/**
+ * @brief Prints the values of a fix that are set.
+ *
+ * @param fix The fix to print.
+ */
+void printFix (const NMEA_Fix& fix) {
+  if (fix.flags & NMEA_Fix::FLAG_TIME) {
+    PORT_DEBUG_SERIAL.print ("Time (ms): ");
+    PORT_DEBUG_SERIAL.print (fix.time);
+  }
+
+  if (fix.flags & NMEA_Fix::FLAG_POSITION) {
+    PORT_DEBUG_SERIAL.print (", Position (deg x 10^7): ");
+    PORT_DEBUG_SERIAL.print (fix.latitude);
+    PORT_DEBUG_SERIAL.print (", ");
+    PORT_DEBUG_SERIAL.print (fix.longitude);
+  }
+
+  if (fix.flags & NMEA_Fix::FLAG_ALTITUDE) {
+    PORT_DEBUG_SERIAL.print (", Altitude (mm): ");
+    PORT_DEBUG_SERIAL.print (fix.altitude);
+  }
+
+  if (fix.flags & NMEA_Fix::FLAG_DOP) {
+    PORT_DEBUG_SERIAL.print (", PDOP x 100: ");
+    PORT_DEBUG_SERIAL.print (fix.pdop);
+  }
+
+  if (fix.flags & NMEA_Fix::FLAG_SATELLITES_IN_VIEW) {
+    PORT_DEBUG_SERIAL.print (", In view: ");
+    PORT_DEBUG_SERIAL.print (fix.satellitesInView);
+  }
+
+  PORT_DEBUG_SERIAL.println();
+}
+
+//======================================================================================//
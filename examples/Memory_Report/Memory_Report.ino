@@ -0,0 +1,95 @@
+//======================================================================================//
+/**
+ * @file Memory_Report.ino
+ * @brief Prints the size of the library objects for the current board and configuration.
+ * The sizes depend on the CONST_* macros, which can be changed with build flags. No GNSS
+ * module is required.
+ * @date +05:30 11:41:05 PM 16-10-2026, Friday
+ * @version 1.0.0
+ * @author Vishnu Mohanan (@vishnumaiea)
+ * @par GitHub Repository: https://github.com/CIRCUITSTATE/CSE_GNSS
+ * @par MIT License
+ *
+ */
+//======================================================================================//
+
+#include <Arduino.h>
+#include <CSE_GNSS.h>
+
+//======================================================================================//
+
+#define   PORT_DEBUG_SERIAL       Serial    // Debug serial port
+#define   VAL_DEBUG_BAUDRATE      115200
+
+//======================================================================================//
+// Forward declarations
+
+void setup();
+void loop();
+void printSize (const char* name, size_t size);
+
+//======================================================================================//
+/**
+ * @brief Prints the configuration and the object sizes.
+ *
+ */
+void setup() {
+  PORT_DEBUG_SERIAL.begin (VAL_DEBUG_BAUDRATE);
+  delay (1000);
+
+  PORT_DEBUG_SERIAL.println();
+  PORT_DEBUG_SERIAL.println ("--- CSE_GNSS [Memory_Report] ---");
+
+  printSize ("CONST_SERIAL_BUFFER_LENGTH", CONST_SERIAL_BUFFER_LENGTH);
+  printSize ("CONST_MAX_NMEA_FIELDS_COUNT", CONST_MAX_NMEA_FIELDS_COUNT);
+  printSize ("CONST_MAX_NMEA_SENTENCE_LENGTH", CONST_MAX_NMEA_SENTENCE_LENGTH);
+  printSize ("CONST_MAX_NMEA_DATA_COUNT", CONST_MAX_NMEA_DATA_COUNT);
+  printSize ("CONST_DISPATCH_TABLE_SIZE", CONST_DISPATCH_TABLE_SIZE);
+  printSize ("CONST_MAX_UBX_PAYLOAD_LENGTH", CONST_MAX_UBX_PAYLOAD_LENGTH);
+  printSize ("CONST_MAX_RTCM_FRAME_LENGTH", CONST_MAX_RTCM_FRAME_LENGTH);
+  printSize ("CSE_GNSS_STATS_ENABLED", CSE_GNSS_STATS_ENABLED);
+  printSize ("CSE_GNSS_STATS_LATENCY", CSE_GNSS_STATS_LATENCY);
+  PORT_DEBUG_SERIAL.println();
+
+  printSize ("sizeof (CSE_GNSS)", sizeof (CSE_GNSS));
+  printSize ("sizeof (NMEA_0183_Data)", sizeof (NMEA_0183_Data));
+  printSize ("sizeof (NMEA_Sentence <NMEA_RMC>)", sizeof (NMEA_Sentence <NMEA_RMC>));
+  printSize ("sizeof (NMEA_Framer)", sizeof (NMEA_Framer));
+  printSize ("sizeof (NMEA_Fix)", sizeof (NMEA_Fix));
+  printSize ("sizeof (NMEA_Ring_Buffer <1024>)", sizeof (NMEA_Ring_Buffer <1024>));
+  printSize ("sizeof (NMEA_Epoch)", sizeof (NMEA_Epoch));
+  printSize ("sizeof (NMEA_Time_Sync)", sizeof (NMEA_Time_Sync));
+  printSize ("sizeof (NMEA_Change_Tracker)", sizeof (NMEA_Change_Tracker));
+  printSize ("sizeof (NMEA_Satellite_Table)", sizeof (NMEA_Satellite_Table));
+  printSize ("sizeof (NMEA_Record_Writer)", sizeof (NMEA_Record_Writer));
+  printSize ("sizeof (NMEA_Record_Reader)", sizeof (NMEA_Record_Reader));
+  printSize ("sizeof (NMEA_Command)", sizeof (NMEA_Command));
+  printSize ("sizeof (UBX_Framer)", sizeof (UBX_Framer));
+  printSize ("sizeof (RTCM_Framer)", sizeof (RTCM_Framer));
+  printSize ("sizeof (GNSS_Demux)", sizeof (GNSS_Demux));
+  printSize ("sizeof (GNSS_Stats)", sizeof (GNSS_Stats));
+}
+
+//======================================================================================//
+/**
+ * @brief Runs indefinitely.
+ *
+ */
+void loop() {
+  delay (1000);
+}
+
+//======================================================================================//
+/**
+ * @brief Prints a name and a size in a single line.
+ *
+ * @param name The name to print.
+ * @param size The size to print.
+ */
+void printSize (const char* name, size_t size) {
+  PORT_DEBUG_SERIAL.print (name);
+  PORT_DEBUG_SERIAL.print (": ");
+  PORT_DEBUG_SERIAL.println ((unsigned long) size);
+}
+
+//======================================================================================//
@@ -3,8 +3,8 @@
 /**
  * @file Print_GPRMC.ino
  * @brief Reads the NMEA output from the GNSS module and prints it on the serial monitor.
- * @date +05:30 12:28:39 AM 03-08-2024, Saturday
- * @version 1.0.1
+ * @date +05:30 04:12:56 AM 17-10-2026, Saturday
+ * @version 1.0.2
  * @author Vishnu Mohanan (@vishnumaiea)
  * @par GitHub Repository: https://github.com/CIRCUITSTATE/CSE_GNSS
  * @par MIT License
@@ -72,6 +72,7 @@ void setup() {
   
   GNSS_Module.begin();  // Initialize the GNSS module.
   GNSS_Module.addData (&NMEA_GPRMC); // Add the data object to the GNSS module.
+  GNSS_Module.setFilter (CSE_GNSS::FILTER_REGISTERED); // Keep only the RMC sentences in the NMEA buffer.
 
   PORT_DEBUG_SERIAL.println();
   PORT_DEBUG_SERIAL.println ("--- CSE_GNSS [Print_GPRMC] ---");
@@ -0,0 +1,128 @@
+//======================================================================================//
+/**
+ * @file Ring_Buffer.ino
+ * @brief Reads the GNSS serial port on the second core of the RP2040 and passes the bytes
+ * to the first core through a lock-free ring buffer. The first core frames and parses the
+ * sentences, so a slow loop no longer loses data. Set VAL_STRESS_TEST to 1 to replace the
+ * GNSS module with a generator that pushes sentences at the rate of a 921600 baud link.
+ * @date +05:30 11:04:18 PM 16-10-2026, Friday
+ * @version 1.0.0
+ * @author Vishnu Mohanan (@vishnumaiea)
+ * @par GitHub Repository: https://github.com/CIRCUITSTATE/CSE_GNSS
+ * @par MIT License
+ *
+ */
+//======================================================================================//
+
+#include <Arduino.h>
+#include <CSE_GNSS.h>
+
+//======================================================================================//
+
+#define   PORT_GPS_SERIAL         Serial1   // GPS serial port
+#define   PORT_DEBUG_SERIAL       Serial    // Debug serial port
+
+// For RP2040
+#define   PIN_GPS_SERIAL_TX       0
+#define   PIN_GPS_SERIAL_RX       1
+
+#define   VAL_GPS_BAUDRATE        115200
+#define   VAL_DEBUG_BAUDRATE      115200
+
+#define   VAL_STRESS_TEST         0         // 1 = Generate the sentences instead of reading the GNSS module
+#define   VAL_STRESS_BYTE_RATE    92160     // Bytes per second of a 921600 baud link
+
+//======================================================================================//
+// Forward declarations
+
+void setup();
+void loop();
+void setup1();
+void loop1();
+
+//======================================================================================//
+
+CSE_GNSS GNSS_Module (&PORT_GPS_SERIAL, &PORT_DEBUG_SERIAL);
+
+// The ring buffer between the two cores. Core 1 is the only producer and core 0 is the
+// only consumer. On other boards, push from the UART interrupt or the DMA callback instead.
+NMEA_Ring_Buffer <2048> GNSS_Ring;
+
+NMEA_Sentence <NMEA_RMC> NMEA_GNRMC;
+
+uint32_t sentenceCount = 0;
+uint32_t lastReportTime = 0;
+
+//======================================================================================//
+/**
+ * @brief Setup the serial ports on core 0.
+ *
+ */
+void setup() {
+  PORT_DEBUG_SERIAL.begin (VAL_DEBUG_BAUDRATE);
+
+  PORT_GPS_SERIAL.setRX (PIN_GPS_SERIAL_RX);
+  PORT_GPS_SERIAL.setTX (PIN_GPS_SERIAL_TX);
+  PORT_GPS_SERIAL.begin (VAL_GPS_BAUDRATE, SERIAL_8N1);
+
+  GNSS_Module.begin();
+  GNSS_Module.addData (&NMEA_GNRMC);
+
+  PORT_DEBUG_SERIAL.println();
+  PORT_DEBUG_SERIAL.println ("--- CSE_GNSS [Ring_Buffer] ---");
+}
+
+//======================================================================================//
+/**
+ * @brief Drains the ring buffer into the framer and prints the statistics every second.
+ * The delay stands in for the other work of a real application.
+ *
+ */
+void loop() {
+  sentenceCount += GNSS_Module.feed (GNSS_Ring);
+
+  if ((millis() - lastReportTime) >= 1000) {
+    lastReportTime = millis();
+
+    PORT_DEBUG_SERIAL.print ("Sentences: ");
+    PORT_DEBUG_SERIAL.print (sentenceCount);
+    PORT_DEBUG_SERIAL.print (", Overflow bytes: ");
+    PORT_DEBUG_SERIAL.println (GNSS_Ring.getOverflowCount());
+  }
+
+  delay (5);
+}
+
+//======================================================================================//
+/**
+ * @brief Nothing to setup on core 1.
+ *
+ */
+void setup1() {
+}
+
+//======================================================================================//
+/**
+ * @brief Pushes the received bytes to the ring buffer on core 1.
+ *
+ */
+void loop1() {
+  #if VAL_STRESS_TEST
+    // Push one sentence at a time, paced to the byte rate of a 921600 baud link.
+    static uint32_t startTime = micros();
+    static uint32_t bytesSent = 0;
+    static const uint16_t sentenceLength = strlen (NMEA_RMC::Sample);
+
+    if ((uint32_t) (micros() - startTime) >= (uint32_t) ((uint64_t) bytesSent * 1000000 / VAL_STRESS_BYTE_RATE)) {
+      GNSS_Ring.push (NMEA_RMC::Sample, sentenceLength);
+      GNSS_Ring.push ("\r\n", 2);
+      bytesSent += sentenceLength + 2;
+    }
+  #else
+    while (PORT_GPS_SERIAL.available() > 0) {
+      GNSS_Ring.push ((char) PORT_GPS_SERIAL.read());
+    }
+  #endif
+}
+
+//======================================================================================//
@@ -0,0 +1,130 @@
+//======================================================================================//
+/**
+ * @file Satellites.ino
+ * @brief Reassembles the GSV sentences into a satellite table and prints the satellites and
+ * the SNR statistics of each constellation every second.
+ * @date +05:30 01:46:20 AM 17-10-2026, Saturday
+ * @version 1.0.0
+ * @author Vishnu Mohanan (@vishnumaiea)
+ * @par GitHub Repository: https://github.com/CIRCUITSTATE/CSE_GNSS
+ * @par MIT License
+ *
+ */
+//======================================================================================//
+
+#include <Arduino.h>
+#include <CSE_GNSS.h>
+
+//======================================================================================//
+
+#define   PORT_GPS_SERIAL         Serial1   // GPS serial port
+#define   PORT_DEBUG_SERIAL       Serial    // Debug serial port
+
+// For RP2040
+#define   PIN_GPS_SERIAL_TX       0
+#define   PIN_GPS_SERIAL_RX       1
+
+// // For ESP32
+// #define   PIN_GPS_SERIAL_TX       16
+// #define   PIN_GPS_SERIAL_RX       17
+
+#define   VAL_GPS_BAUDRATE        115200
+#define   VAL_DEBUG_BAUDRATE      115200
+
+//======================================================================================//
+// Forward declarations
+
+void setup();
+void loop();
+void printSatellites();
+
+//======================================================================================//
+
+CSE_GNSS GNSS_Module (&PORT_GPS_SERIAL, &PORT_DEBUG_SERIAL);
+
+NMEA_Satellite_Table GNSS_Satellites;
+
+const char* systemNames [NMEA_Satellite_Table::SYSTEM_COUNT] = {"GPS", "GLONASS", "Galileo", "BeiDou", "QZSS"};
+
+//======================================================================================//
+/**
+ * @brief Setup the serial ports and the satellite table.
+ *
+ */
+void setup() {
+  PORT_DEBUG_SERIAL.begin (VAL_DEBUG_BAUDRATE);
+
+  // // For ESP32 boards
+  // PORT_GPS_SERIAL.begin (VAL_GPS_BAUDRATE, SERIAL_8N1, PIN_GPS_SERIAL_RX, PIN_GPS_SERIAL_TX);
+
+  // For RP2040
+  PORT_GPS_SERIAL.setRX (PIN_GPS_SERIAL_RX);
+  PORT_GPS_SERIAL.setTX (PIN_GPS_SERIAL_TX);
+  PORT_GPS_SERIAL.begin (VAL_GPS_BAUDRATE, SERIAL_8N1);
+
+  GNSS_Module.begin();
+  GNSS_Module.setSatelliteTable (&GNSS_Satellites);
+
+  PORT_DEBUG_SERIAL.println();
+  PORT_DEBUG_SERIAL.println ("--- CSE_GNSS [Satellites] ---");
+}
+
+//======================================================================================//
+/**
+ * @brief Feeds the received bytes to the library and prints the table every second.
+ *
+ */
+void loop() {
+  static uint32_t lastReportTime = 0;
+
+  GNSS_Module.update();
+
+  if ((millis() - lastReportTime) >= 1000) {
+    lastReportTime = millis();
+    printSatellites();
+  }
+}
+
+//======================================================================================//
+/**
+ * @brief Prints the satellites in the table and the SNR statistics of each constellation.
+ *
+ */
+void printSatellites() {
+  const uint16_t* prns = GNSS_Satellites.getPrns();
+  const uint8_t* snrs = GNSS_Satellites.getSnrs();
+  const uint8_t* systems = GNSS_Satellites.getSystems();
+
+  PORT_DEBUG_SERIAL.println();
+
+  for (uint8_t i = 0; i < GNSS_Satellites.getCount(); i++) {
+    PORT_DEBUG_SERIAL.print (systemNames [systems [i]]);
+    PORT_DEBUG_SERIAL.print (" ");
+    PORT_DEBUG_SERIAL.print (prns [i]);
+    PORT_DEBUG_SERIAL.print (": ");
+    PORT_DEBUG_SERIAL.print (snrs [i]);
+    PORT_DEBUG_SERIAL.println (" dB-Hz");
+  }
+
+  for (uint8_t system = 0; system < NMEA_Satellite_Table::SYSTEM_COUNT; system++) {
+    const NMEA_Snr_Stats& stats = GNSS_Satellites.getSnrStats (system);
+
+    if (stats.inView == 0) {
+      continue;
+    }
+
+    PORT_DEBUG_SERIAL.print (systemNames [system]);
+    PORT_DEBUG_SERIAL.print (": In view ");
+    PORT_DEBUG_SERIAL.print (stats.inView);
+    PORT_DEBUG_SERIAL.print (", Tracked ");
+    PORT_DEBUG_SERIAL.print (stats.tracked);
+    PORT_DEBUG_SERIAL.print (", SNR min/mean/max ");
+    PORT_DEBUG_SERIAL.print (stats.minSnr);
+    PORT_DEBUG_SERIAL.print ("/");
+    PORT_DEBUG_SERIAL.print (stats.meanSnr);
+    PORT_DEBUG_SERIAL.print ("/");
+    PORT_DEBUG_SERIAL.println (stats.maxSnr);
+  }
+}
+
+//======================================================================================//
@@ -0,0 +1,140 @@
+//======================================================================================//
+/**
+ * @file Statistics.ino
+ * @brief Reads the GNSS module without blocking and prints the runtime statistics of the
+ * library every few seconds, to find out why fixes are missing or late. Build with
+ * -DCSE_GNSS_STATS_LATENCY=1 to also print the latency percentiles.
+ * @date +05:30 07:02:36 AM 17-10-2026, Saturday
+ * @version 1.0.0
+ * @author Vishnu Mohanan (@vishnumaiea)
+ * @par GitHub Repository: https://github.com/CIRCUITSTATE/CSE_GNSS
+ * @par MIT License
+ *
+ */
+//======================================================================================//
+
+#include <Arduino.h>
+#include <CSE_GNSS.h>
+
+//======================================================================================//
+
+#define   PORT_GPS_SERIAL         Serial1   // GPS serial port
+#define   PORT_DEBUG_SERIAL       Serial    // Debug serial port
+
+// For RP2040
+#define   PIN_GPS_SERIAL_TX       0
+#define   PIN_GPS_SERIAL_RX       1
+
+#define   VAL_GPS_BAUDRATE        115200
+#define   VAL_DEBUG_BAUDRATE      115200
+
+#define   VAL_REPORT_INTERVAL     5000      // The time between the reports in milliseconds
+
+//======================================================================================//
+// Forward declarations
+
+void setup();
+void loop();
+void printStats (const GNSS_Stats& stats);
+void printCount (const char* name, uint32_t count);
+
+//======================================================================================//
+
+CSE_GNSS GNSS_Module (&PORT_GPS_SERIAL, &PORT_DEBUG_SERIAL);
+
+NMEA_Sentence <NMEA_RMC> NMEA_GNRMC; // Talker ID is GN by default
+NMEA_Sentence <NMEA_GGA> NMEA_GNGGA;
+
+//======================================================================================//
+/**
+ * @brief Setup the serial ports and the data objects.
+ *
+ */
+void setup() {
+  PORT_DEBUG_SERIAL.begin (VAL_DEBUG_BAUDRATE);
+
+  // For RP2040
+  PORT_GPS_SERIAL.setRX (PIN_GPS_SERIAL_RX);
+  PORT_GPS_SERIAL.setTX (PIN_GPS_SERIAL_TX);
+  PORT_GPS_SERIAL.begin (VAL_GPS_BAUDRATE, SERIAL_8N1);
+
+  GNSS_Module.begin();
+  GNSS_Module.addData (&NMEA_GNRMC);
+  GNSS_Module.addData (&NMEA_GNGGA);
+
+  PORT_DEBUG_SERIAL.println();
+  PORT_DEBUG_SERIAL.println ("--- CSE_GNSS [Statistics] ---");
+}
+
+//======================================================================================//
+/**
+ * @brief Feeds the received bytes to the library and prints the statistics periodically.
+ *
+ */
+void loop() {
+  static uint32_t lastReportTime = 0;
+
+  GNSS_Module.update();
+
+  if ((millis() - lastReportTime) >= VAL_REPORT_INTERVAL) {
+    lastReportTime = millis();
+    printStats (GNSS_Module.getStats());
+  }
+}
+
+//======================================================================================//
+/**
+ * @brief Prints the counts, the high-water marks and the latency percentiles.
+ *
+ * @param stats The statistics to print.
+ */
+void printStats (const GNSS_Stats& stats) {
+  static const char* typeNames [GNSS_Stats::TYPE_COUNT] = {
+    "GGA", "GLL", "GSA", "GSV", "RMC", "VTG", "ZDA", "Other"
+  };
+
+  PORT_DEBUG_SERIAL.println();
+  printCount ("Bytes in", stats.bytesIn);
+  printCount ("Bytes unframed", stats.bytesUnframed);
+  printCount ("Bytes dropped", stats.bytesDropped);
+  printCount ("Sentences", stats.sentenceCount);
+
+  for (uint8_t i = 0; i < GNSS_Stats::TYPE_COUNT; i++) {
+    if (stats.typeCounts [i] > 0) {
+      PORT_DEBUG_SERIAL.print ("  ");
+      printCount (typeNames [i], stats.typeCounts [i]);
+    }
+  }
+
+  printCount ("Checksum errors", stats.checksumErrorCount);
+  printCount ("Oversize", stats.oversizeCount);
+  printCount ("Truncated", stats.truncatedCount);
+  printCount ("Filtered", stats.filteredCount);
+  printCount ("Longest sentence", stats.sentenceHighWater);
+  printCount ("Most bytes waiting", stats.availableHighWater);
+  printCount ("Since last sentence (ms)", (stats.lastSentenceTime == 0) ? 0 : (millis() - stats.lastSentenceTime));
+
+  #if CSE_GNSS_STATS_LATENCY
+    printCount ("Framing p50", stats.framing.getPercentile (50));
+    printCount ("Framing p99", stats.framing.getPercentile (99));
+    printCount ("Framing max", stats.framing.maxTime);
+    printCount ("Parsing p50", stats.parsing.getPercentile (50));
+    printCount ("Parsing p99", stats.parsing.getPercentile (99));
+    printCount ("Parsing max", stats.parsing.maxTime);
+  #endif
+}
+
+//======================================================================================//
+/**
+ * @brief Prints a name and a count in a single line.
+ *
+ * @param name The name to print.
+ * @param count The count to print.
+ */
+void printCount (const char* name, uint32_t count) {
+  PORT_DEBUG_SERIAL.print (name);
+  PORT_DEBUG_SERIAL.print (": ");
+  PORT_DEBUG_SERIAL.println (count);
+}
+
+//======================================================================================//
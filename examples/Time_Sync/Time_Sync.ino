@@ -0,0 +1,136 @@
+//======================================================================================//
+/**
+ * @file Time_Sync.ino
+ * @brief Stamps the arrival of each sentence and relates it to the UTC time in the
+ * sentences. Prints how late the RMC sentences arrive and, if the PPS output of the GNSS
+ * module is connected, the end-to-end latency from the start of each UTC second.
+ * @date +05:30 08:26:49 AM 17-10-2026, Saturday
+ * @version 1.0.0
+ * @author Vishnu Mohanan (@vishnumaiea)
+ * @par GitHub Repository: https://github.com/CIRCUITSTATE/CSE_GNSS
+ * @par MIT License
+ *
+ */
+//======================================================================================//
+
+#include <Arduino.h>
+#include <CSE_GNSS.h>
+
+//======================================================================================//
+
+#define   PORT_GPS_SERIAL         Serial1   // GPS serial port
+#define   PORT_DEBUG_SERIAL       Serial    // Debug serial port
+
+// For RP2040
+#define   PIN_GPS_SERIAL_TX       0
+#define   PIN_GPS_SERIAL_RX       1
+#define   PIN_GPS_PPS             2         // The PPS output of the GNSS module. Optional.
+
+#define   VAL_GPS_BAUDRATE        115200
+#define   VAL_DEBUG_BAUDRATE      115200
+
+//======================================================================================//
+// Forward declarations
+
+void setup();
+void loop();
+void onPps();
+void onRMC (NMEA_0183_Data& data, void* context);
+
+//======================================================================================//
+
+CSE_GNSS GNSS_Module (&PORT_GPS_SERIAL, &PORT_DEBUG_SERIAL);
+
+NMEA_Sentence <NMEA_RMC> NMEA_GNRMC; // Talker ID is GN by default
+
+NMEA_Time_Sync GNSS_Time; // Relates the arrival times to UTC
+
+volatile uint32_t ppsTime = 0; // The clock time of the last PPS edge
+volatile bool ppsReceived = false; // True when a PPS edge has not been handled yet
+
+//======================================================================================//
+/**
+ * @brief Setup the serial ports, the time sync and the PPS interrupt.
+ *
+ */
+void setup() {
+  PORT_DEBUG_SERIAL.begin (VAL_DEBUG_BAUDRATE);
+
+  // For RP2040
+  PORT_GPS_SERIAL.setRX (PIN_GPS_SERIAL_RX);
+  PORT_GPS_SERIAL.setTX (PIN_GPS_SERIAL_TX);
+  PORT_GPS_SERIAL.begin (VAL_GPS_BAUDRATE, SERIAL_8N1);
+
+  GNSS_Module.begin();
+  GNSS_Module.addData (&NMEA_GNRMC);
+  GNSS_Module.setTimeSync (&GNSS_Time);
+  NMEA_GNRMC.setHandler (onRMC);
+
+  pinMode (PIN_GPS_PPS, INPUT);
+  attachInterrupt (digitalPinToInterrupt (PIN_GPS_PPS), onPps, RISING);
+
+  PORT_DEBUG_SERIAL.println();
+  PORT_DEBUG_SERIAL.println ("--- CSE_GNSS [Time_Sync] ---");
+}
+
+//======================================================================================//
+/**
+ * @brief Feeds the received bytes as soon as they arrive, so that the arrival times are
+ * accurate. Measures the latency at each PPS edge.
+ *
+ */
+void loop() {
+  GNSS_Module.update();
+
+  if (!ppsReceived || !GNSS_Time.isValid()) {
+    return;
+  }
+
+  noInterrupts();
+  uint32_t edgeTime = ppsTime;
+  ppsReceived = false;
+  interrupts();
+
+  // The edge marks the start of the UTC second that follows the converted time, which is
+  // behind UTC by the latency as long as it is not set.
+  uint32_t utcTime;
+  GNSS_Time.setLatency (0);
+  GNSS_Time.toUtc (edgeTime, utcTime);
+  uint32_t edgeUtc = (((utcTime / 1000) + 1) * 1000) % 86400000;
+
+  int32_t latency = GNSS_Time.getLatency (edgeUtc, edgeTime);
+  GNSS_Time.setLatency (latency);
+
+  PORT_DEBUG_SERIAL.print ("PPS latency (us): ");
+  PORT_DEBUG_SERIAL.println (latency);
+}
+
+//======================================================================================//
+/**
+ * @brief Stamps the PPS edge with the same clock as the sentences.
+ *
+ */
+void onPps() {
+  ppsTime = NMEA_Framer::getTime();
+  ppsReceived = true;
+}
+
+//======================================================================================//
+/**
+ * @brief Prints the arrival time of each RMC sentence and its delay from the least
+ * delayed sentence.
+ *
+ * @param data The parsed GNRMC sentence.
+ * @param context Not used.
+ */
+void onRMC (NMEA_0183_Data& data, void* context) {
+  (void) context;
+  PORT_DEBUG_SERIAL.print ("RMC arrived at (us): ");
+  PORT_DEBUG_SERIAL.print (data.arrivalTime);
+  PORT_DEBUG_SERIAL.print (", Delay (us): ");
+  PORT_DEBUG_SERIAL.print (GNSS_Time.getDelay());
+  PORT_DEBUG_SERIAL.print (", Max delay (us): ");
+  PORT_DEBUG_SERIAL.println (GNSS_Time.getMaxDelay());
+}
+
+//======================================================================================//
@@ -0,0 +1,120 @@
+//======================================================================================//
+/**
+ * @file UBX_PVT.ino
+ * @brief Switches a u-blox receiver from NMEA to the binary UBX-NAV-PVT message at 10 Hz,
+ * and prints the fixes decoded from it. A NAV-PVT message has the whole fix in 100 bytes
+ * and needs no text conversion.
+ * @date +05:30 05:02:37 AM 17-10-2026, Saturday
+ * @version 1.0.0
+ * @author Vishnu Mohanan (@vishnumaiea)
+ * @par GitHub Repository: https://github.com/CIRCUITSTATE/CSE_GNSS
+ * @par MIT License
+ *
+ */
+//======================================================================================//
+
+#include <Arduino.h>
+#include <CSE_GNSS.h>
+
+//======================================================================================//
+
+#define   PORT_GPS_SERIAL         Serial1   // GPS serial port
+#define   PORT_DEBUG_SERIAL       Serial    // Debug serial port
+
+// For RP2040
+#define   PIN_GPS_SERIAL_TX       0
+#define   PIN_GPS_SERIAL_RX       1
+
+#define   VAL_GPS_BAUDRATE        115200
+#define   VAL_DEBUG_BAUDRATE      115200
+
+#define   VAL_GPS_INTERVAL        100       // The fix interval in milliseconds
+
+//======================================================================================//
+// Forward declarations
+
+void setup();
+void loop();
+void onFrame (const UBX_Frame& frame, void* context);
+
+//======================================================================================//
+
+CSE_GNSS GNSS_Module (&PORT_GPS_SERIAL, &PORT_DEBUG_SERIAL, VAL_GPS_BAUDRATE);
+
+UBX_Framer GNSS_Ubx;
+
+//======================================================================================//
+/**
+ * @brief Setup the serial ports and switch the receiver to NAV-PVT.
+ *
+ */
+void setup() {
+  PORT_DEBUG_SERIAL.begin (VAL_DEBUG_BAUDRATE);
+  delay (1000);
+
+  PORT_GPS_SERIAL.setRX (PIN_GPS_SERIAL_RX);
+  PORT_GPS_SERIAL.setTX (PIN_GPS_SERIAL_TX);
+
+  GNSS_Module.begin();
+  GNSS_Module.setUbxFramer (&GNSS_Ubx);
+  GNSS_Ubx.setHandler (onFrame);
+
+  PORT_DEBUG_SERIAL.println();
+  PORT_DEBUG_SERIAL.println ("--- CSE_GNSS [UBX_PVT] ---");
+
+  // Turn off the standard NMEA messages (class 0xF0): GGA, GLL, GSA, GSV, RMC and VTG.
+  for (uint8_t id = 0x00; id <= 0x05; id++) {
+    GNSS_Module.setUbxMessageRate (0xF0, id, 0);
+  }
+
+  // Turn on NAV-PVT for every fix, and set the fix interval. Both wait for the UBX ACK.
+  bool pvtSet = GNSS_Module.setUbxMessageRate (UBX_Nav_Pvt::Class, UBX_Nav_Pvt::Id, 1);
+  bool rateSet = GNSS_Module.setOutputRate (NMEA_Command::RECEIVER_UBLOX, VAL_GPS_INTERVAL);
+
+  PORT_DEBUG_SERIAL.print ("NAV-PVT: ");
+  PORT_DEBUG_SERIAL.print (pvtSet ? "OK" : "Failed");
+  PORT_DEBUG_SERIAL.print (", Rate: ");
+  PORT_DEBUG_SERIAL.println (rateSet ? "OK" : "Failed");
+}
+
+//======================================================================================//
+/**
+ * @brief Feeds the received bytes to the library. The frame handler is called from here.
+ *
+ */
+void loop() {
+  GNSS_Module.update();
+}
+
+//======================================================================================//
+/**
+ * @brief Decodes and prints each NAV-PVT frame.
+ *
+ * @param frame The UBX frame.
+ * @param context Not used.
+ */
+void onFrame (const UBX_Frame& frame, void* context) {
+  (void) context;
+
+  UBX_Nav_Pvt pvt (frame);
+
+  if (!pvt.isValid()) {
+    return;
+  }
+
+  NMEA_Fix fix = {};
+  pvt.decode (fix);
+
+  PORT_DEBUG_SERIAL.print ("Time (ms): ");
+  PORT_DEBUG_SERIAL.print (fix.time);
+  PORT_DEBUG_SERIAL.print (", Position (deg x 10^7): ");
+  PORT_DEBUG_SERIAL.print (fix.latitude);
+  PORT_DEBUG_SERIAL.print (", ");
+  PORT_DEBUG_SERIAL.print (fix.longitude);
+  PORT_DEBUG_SERIAL.print (", Satellites: ");
+  PORT_DEBUG_SERIAL.print (fix.satellites);
+  PORT_DEBUG_SERIAL.print (", Accuracy (mm): ");
+  PORT_DEBUG_SERIAL.println (pvt.getHorizontalAccuracy());
+}
+
+//======================================================================================//
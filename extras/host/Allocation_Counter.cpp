@@ -0,0 +1,63 @@
+//======================================================================================//
+/**
+ * @file Allocation_Counter.cpp
+ * @brief Replaces the global operator new and operator delete to count the allocations.
+ * @date +05:30 10:02:18 AM 17-10-2026, Saturday
+ * @version 1.0.0
+ * @author Vishnu Mohanan (@vishnumaiea)
+ * @par GitHub Repository: https://github.com/CIRCUITSTATE/CSE_GNSS
+ * @par MIT License
+ *
+ */
+//======================================================================================//
+
+#include "Allocation_Counter.h"
+#include <atomic>
+#include <new>
+#include <stdlib.h>
+
+//======================================================================================//
+
+static std::atomic <uint32_t> allocationCount (0); // The number of allocations since the start
+
+//======================================================================================//
+/**
+ * @brief Returns the number of allocations made with new since the start.
+ *
+ * @return uint32_t The allocation count.
+ */
+uint32_t getAllocationCount() {
+  return allocationCount.load (std::memory_order_relaxed);
+}
+
+//======================================================================================//
+/**
+ * @brief Allocates and counts a block.
+ *
+ * @param size The size of the block.
+ * @return void* The block. Throws std::bad_alloc if out of memory.
+ */
+static void* allocate (size_t size) {
+  allocationCount.fetch_add (1, std::memory_order_relaxed);
+  void* block = malloc ((size > 0) ? size : 1);
+
+  if (block == nullptr) {
+    throw std::bad_alloc();
+  }
+
+  return block;
+}
+
+//======================================================================================//
+// The replaceable allocation functions.
+
+void* operator new (size_t size) { return allocate (size); }
+void* operator new[] (size_t size) { return allocate (size); }
+void* operator new (size_t size, const std::nothrow_t&) noexcept { allocationCount.fetch_add (1, std::memory_order_relaxed); return malloc ((size > 0) ? size : 1); }
+void* operator new[] (size_t size, const std::nothrow_t&) noexcept { allocationCount.fetch_add (1, std::memory_order_relaxed); return malloc ((size > 0) ? size : 1); }
+void operator delete (void* block) noexcept { free (block); }
+void operator delete[] (void* block) noexcept { free (block); }
+void operator delete (void* block, size_t) noexcept { free (block); }
+void operator delete[] (void* block, size_t) noexcept { free (block); }
+
+//======================================================================================//
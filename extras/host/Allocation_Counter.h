@@ -0,0 +1,27 @@
+//======================================================================================//
+/**
+ * @file Allocation_Counter.h
+ * @brief Counts the heap allocations of the host build. The global operator new and
+ * operator delete are replaced in Allocation_Counter.cpp, so every allocation made with
+ * new, including the ones of the host String, is counted.
+ * @date +05:30 10:02:18 AM 17-10-2026, Saturday
+ * @version 1.0.0
+ * @author Vishnu Mohanan (@vishnumaiea)
+ * @par GitHub Repository: https://github.com/CIRCUITSTATE/CSE_GNSS
+ * @par MIT License
+ *
+ */
+//======================================================================================//
+
+#ifndef CSE_GNSS_HOST_ALLOCATION_COUNTER_H
+#define CSE_GNSS_HOST_ALLOCATION_COUNTER_H
+
+#include <stdint.h>
+
+//======================================================================================//
+
+uint32_t getAllocationCount(); // Get the number of allocations made by all the threads since the start
+
+#endif
+
+//======================================================================================//
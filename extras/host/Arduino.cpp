@@ -0,0 +1,327 @@
+//======================================================================================//
+/**
+ * @file Arduino.cpp
+ * @brief The host implementation of the minimal Arduino core in Arduino.h.
+ * @date +05:30 10:02:18 AM 17-10-2026, Saturday
+ * @version 1.0.0
+ * @author Vishnu Mohanan (@vishnumaiea)
+ * @par GitHub Repository: https://github.com/CIRCUITSTATE/CSE_GNSS
+ * @par MIT License
+ *
+ */
+//======================================================================================//
+
+#include "Arduino.h"
+#include <time.h>
+
+//======================================================================================//
+
+HardwareSerial Serial (true);
+HardwareSerial Serial1;
+HardwareSerial Serial2;
+
+//======================================================================================//
+/**
+ * @brief Returns the monotonic time in microseconds, wrapping at 2^32 like micros().
+ *
+ * @return unsigned long The time in microseconds.
+ */
+unsigned long micros() {
+  struct timespec now;
+  clock_gettime (CLOCK_MONOTONIC, &now);
+  return (uint32_t) (((uint64_t) now.tv_sec * 1000000) + (now.tv_nsec / 1000));
+}
+
+//======================================================================================//
+/**
+ * @brief Returns the monotonic time in milliseconds, wrapping at 2^32 like millis().
+ *
+ * @return unsigned long The time in milliseconds.
+ */
+unsigned long millis() {
+  struct timespec now;
+  clock_gettime (CLOCK_MONOTONIC, &now);
+  return (uint32_t) (((uint64_t) now.tv_sec * 1000) + (now.tv_nsec / 1000000));
+}
+
+//======================================================================================//
+/**
+ * @brief Sleeps for the given time.
+ *
+ * @param ms The time in milliseconds.
+ */
+void delay (unsigned long ms) {
+  struct timespec time = {(time_t) (ms / 1000), (long) ((ms % 1000) * 1000000)};
+  nanosleep (&time, nullptr);
+}
+
+//======================================================================================//
+/**
+ * @brief Sleeps for the given time.
+ *
+ * @param us The time in microseconds.
+ */
+void delayMicroseconds (unsigned int us) {
+  struct timespec time = {(time_t) (us / 1000000), (long) ((us % 1000000) * 1000)};
+  nanosleep (&time, nullptr);
+}
+
+//======================================================================================//
+// String
+
+String:: String (const char* str) : buffer (nullptr), capacity (0), len (0) {
+  if (str != nullptr) {
+    copy (str, strlen (str));
+  }
+}
+
+String:: String (const char* str, unsigned int length) : buffer (nullptr), capacity (0), len (0) {
+  copy (str, length);
+}
+
+String:: String (const String& str) : buffer (nullptr), capacity (0), len (0) {
+  copy (str.c_str(), str.len);
+}
+
+String:: String (String&& str) : buffer (str.buffer), capacity (str.capacity), len (str.len) {
+  str.buffer = nullptr;
+  str.capacity = 0;
+  str.len = 0;
+}
+
+String:: String (char c) : buffer (nullptr), capacity (0), len (0) {
+  copy (&c, 1);
+}
+
+String:: String (int value, unsigned char base) : String ((long) value, base) {}
+
+String:: String (unsigned int value, unsigned char base) : String ((unsigned long) value, base) {}
+
+String:: String (long value, unsigned char base) : buffer (nullptr), capacity (0), len (0) {
+  char text [34];
+  snprintf (text, sizeof (text), (base == HEX) ? "%lx" : "%ld", value);
+  copy (text, strlen (text));
+}
+
+String:: String (unsigned long value, unsigned char base) : buffer (nullptr), capacity (0), len (0) {
+  char text [34];
+  snprintf (text, sizeof (text), (base == HEX) ? "%lx" : "%lu", value);
+  copy (text, strlen (text));
+}
+
+String:: ~String() {
+  delete [] buffer;
+}
+
+String& String:: operator= (const String& str) {
+  if (this != &str) {
+    copy (str.c_str(), str.len);
+  }
+
+  return *this;
+}
+
+String& String:: operator= (String&& str) {
+  if (this != &str) {
+    delete [] buffer;
+    buffer = str.buffer;
+    capacity = str.capacity;
+    len = str.len;
+    str.buffer = nullptr;
+    str.capacity = 0;
+    str.len = 0;
+  }
+
+  return *this;
+}
+
+String& String:: operator= (const char* str) {
+  copy (str, (str != nullptr) ? strlen (str) : 0);
+  return *this;
+}
+
+// Like the Arduino String, the buffer is only grown, never shrunk.
+bool String:: reserve (unsigned int size) {
+  if ((buffer != nullptr) && (capacity >= size)) {
+    return true;
+  }
+
+  char* grown = new char [size + 1];
+
+  if (buffer != nullptr) {
+    memcpy (grown, buffer, len + 1);
+    delete [] buffer;
+  }
+  else {
+    grown [0] = '\0';
+  }
+
+  buffer = grown;
+  capacity = size;
+  return true;
+}
+
+void String:: copy (const char* str, unsigned int length) {
+  if (length == 0) {
+    if (buffer != nullptr) {
+      buffer [0] = '\0';
+    }
+
+    len = 0;
+    return;
+  }
+
+  reserve (length);
+  memmove (buffer, str, length);
+  buffer [length] = '\0';
+  len = length;
+}
+
+void String:: append (const char* str, unsigned int length) {
+  if (length == 0) {
+    return;
+  }
+
+  // The source may be this string.
+  if ((buffer != nullptr) && (str >= buffer) && (str < (buffer + capacity + 1))) {
+    String source (str, length);
+    append (source.c_str(), length);
+    return;
+  }
+
+  reserve (len + length);
+  memcpy (buffer + len, str, length);
+  len += length;
+  buffer [len] = '\0';
+}
+
+bool String:: startsWith (const String& prefix) const {
+  return (prefix.len <= len) && (memcmp (c_str(), prefix.c_str(), prefix.len) == 0);
+}
+
+int String:: indexOf (char c, unsigned int from) const {
+  for (unsigned int i = from; i < len; i++) {
+    if (buffer [i] == c) {
+      return (int) i;
+    }
+  }
+
+  return -1;
+}
+
+int String:: indexOf (const String& str, unsigned int from) const {
+  if (from >= len) {
+    return -1;
+  }
+
+  const char* found = strstr (c_str() + from, str.c_str());
+  return (found == nullptr) ? -1 : (int) (found - c_str());
+}
+
+String String:: substring (unsigned int from, unsigned int to) const {
+  if (from > to) {
+    unsigned int swap = from;
+    from = to;
+    to = swap;
+  }
+
+  if (from >= len) {
+    return String();
+  }
+
+  if (to > len) {
+    to = len;
+  }
+
+  return String (c_str() + from, to - from);
+}
+
+String operator+ (const String& a, const String& b) {
+  String sum (a);
+  sum += b;
+  return sum;
+}
+
+String operator+ (const String& a, const char* b) {
+  String sum (a);
+  sum += b;
+  return sum;
+}
+
+String operator+ (const String& a, char b) {
+  String sum (a);
+  sum += b;
+  return sum;
+}
+
+//======================================================================================//
+// Print and Stream
+
+size_t Print:: write (const uint8_t* data, size_t length) {
+  size_t count = 0;
+
+  while (length-- > 0) {
+    count += write (*data++);
+  }
+
+  return count;
+}
+
+size_t Print:: print (long value, int base) {
+  char text [34];
+  snprintf (text, sizeof (text), (base == HEX) ? "%lX" : "%ld", value);
+  return write (text);
+}
+
+size_t Print:: print (unsigned long value, int base) {
+  char text [34];
+  snprintf (text, sizeof (text), (base == HEX) ? "%lX" : "%lu", value);
+  return write (text);
+}
+
+size_t Print:: print (double value, int digits) {
+  char text [64];
+  snprintf (text, sizeof (text), "%.*f", digits, value);
+  return write (text);
+}
+
+size_t Stream:: readBytes (char* buffer, size_t length) {
+  size_t count = 0;
+
+  while (count < length) {
+    int c = read();
+
+    if (c < 0) {
+      break;
+    }
+
+    buffer [count++] = (char) c;
+  }
+
+  return count;
+}
+
+//======================================================================================//
+// HardwareSerial
+
+HardwareSerial:: HardwareSerial (bool echo) : input (nullptr), inputLength (0), inputPosition (0), baud (0), echo (echo) {
+}
+
+void HardwareSerial:: setInput (const void* data, size_t length) {
+  input = (const uint8_t*) data;
+  inputLength = length;
+  inputPosition = 0;
+}
+
+size_t HardwareSerial:: write (uint8_t c) {
+  if (echo) {
+    fputc (c, stdout);
+  }
+  else {
+    output += (char) c;
+  }
+
+  return 1;
+}
+
+//======================================================================================//
@@ -0,0 +1,216 @@
+//======================================================================================//
+/**
+ * @file Arduino.h
+ * @brief A minimal Arduino core for building the library, the Benchmark example and the
+ * tests on a Linux host. Only the parts that CSE_GNSS and its examples use are provided:
+ * String, Print, Stream, HardwareSerial and the timing functions. Like the String of the
+ * AVR core, the String here keeps its characters on the heap, so the allocations counted
+ * on the host are the ones a board would make.
+ * @date +05:30 10:02:18 AM 17-10-2026, Saturday
+ * @version 1.0.0
+ * @author Vishnu Mohanan (@vishnumaiea)
+ * @par GitHub Repository: https://github.com/CIRCUITSTATE/CSE_GNSS
+ * @par MIT License
+ *
+ */
+//======================================================================================//
+
+#ifndef CSE_GNSS_HOST_ARDUINO_H
+#define CSE_GNSS_HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+//======================================================================================//
+
+#define   CSE_GNSS_HOST           1         // Set when building on the host
+
+#define   DEC                     10
+#define   HEX                     16
+#define   SERIAL_8N1              0x06
+#define   INPUT                   0x0
+#define   OUTPUT                  0x1
+#define   LOW                     0x0
+#define   HIGH                    0x1
+#define   RISING                  0x3
+
+#define   digitalPinToInterrupt(pin)    (pin)
+
+unsigned long millis();
+unsigned long micros();
+void delay (unsigned long ms);
+void delayMicroseconds (unsigned int us);
+inline void yield() {}
+inline void pinMode (uint8_t pin, uint8_t mode) { (void) pin; (void) mode; }
+inline void digitalWrite (uint8_t pin, uint8_t value) { (void) pin; (void) value; }
+inline int digitalRead (uint8_t pin) { (void) pin; return LOW; }
+inline void attachInterrupt (uint8_t interrupt, void (*handler)(), int mode) { (void) interrupt; (void) handler; (void) mode; }
+inline void noInterrupts() {}
+inline void interrupts() {}
+
+//======================================================================================//
+/**
+ * @brief A String with the interface of the Arduino String. The characters are kept in a
+ * heap buffer that is allocated with new, for every non-empty string.
+ *
+ */
+class String {
+  private:
+    char* buffer; // The null terminated characters. nullptr if the string is empty.
+    unsigned int capacity; // The number of characters the buffer can hold
+    unsigned int len; // The number of characters in the string
+
+    void copy (const char* str, unsigned int length);
+    void append (const char* str, unsigned int length);
+
+  public:
+    String (const char* str = "");
+    String (const char* str, unsigned int length);
+    String (const String& str);
+    String (String&& str);
+    explicit String (char c);
+    explicit String (int value, unsigned char base = DEC);
+    explicit String (unsigned int value, unsigned char base = DEC);
+    explicit String (long value, unsigned char base = DEC);
+    explicit String (unsigned long value, unsigned char base = DEC);
+    ~String();
+
+    String& operator= (const String& str);
+    String& operator= (String&& str);
+    String& operator= (const char* str);
+
+    bool reserve (unsigned int size);
+    unsigned int length() const { return len; }
+    const char* c_str() const { return (buffer != nullptr) ? buffer : ""; }
+    char charAt (unsigned int index) const { return (index < len) ? buffer [index] : 0; }
+    char operator[] (unsigned int index) const { return charAt (index); }
+
+    bool concat (const String& str) { append (str.c_str(), str.len); return true; }
+    bool concat (const char* str) { append (str, strlen (str)); return true; }
+    bool concat (char c) { append (&c, 1); return true; }
+    String& operator+= (const String& str) { concat (str); return *this; }
+    String& operator+= (const char* str) { concat (str); return *this; }
+    String& operator+= (char c) { concat (c); return *this; }
+
+    bool equals (const String& str) const { return (len == str.len) && (memcmp (c_str(), str.c_str(), len) == 0); }
+    bool equals (const char* str) const { return strcmp (c_str(), str) == 0; }
+    bool operator== (const String& str) const { return equals (str); }
+    bool operator== (const char* str) const { return equals (str); }
+    bool operator!= (const String& str) const { return !equals (str); }
+    bool operator!= (const char* str) const { return !equals (str); }
+    bool startsWith (const String& prefix) const;
+
+    int indexOf (char c, unsigned int from = 0) const;
+    int indexOf (const String& str, unsigned int from = 0) const;
+    String substring (unsigned int from) const { return substring (from, len); }
+    String substring (unsigned int from, unsigned int to) const;
+    long toInt() const { return atol (c_str()); }
+    float toFloat() const { return (float) atof (c_str()); }
+
+    friend String operator+ (const String& a, const String& b);
+    friend String operator+ (const String& a, const char* b);
+    friend String operator+ (const String& a, char b);
+};
+
+//======================================================================================//
+/**
+ * @brief The text output functions of the Arduino Print class.
+ *
+ */
+class Print {
+  public:
+    virtual ~Print() {}
+    virtual size_t write (uint8_t c) = 0;
+    virtual size_t write (const uint8_t* data, size_t length);
+    virtual void flush() {}
+
+    size_t write (const char* data, size_t length) { return write ((const uint8_t*) data, length); }
+    size_t write (const char* str) { return (str == nullptr) ? 0 : write ((const uint8_t*) str, strlen (str)); }
+
+    size_t print (const char* str) { return write (str); }
+    size_t print (const String& str) { return write (str.c_str(), str.length()); }
+    size_t print (char c) { return write ((uint8_t) c); }
+    size_t print (unsigned char value, int base = DEC) { return print ((unsigned long) value, base); }
+    size_t print (int value, int base = DEC) { return print ((long) value, base); }
+    size_t print (unsigned int value, int base = DEC) { return print ((unsigned long) value, base); }
+    size_t print (long value, int base = DEC);
+    size_t print (unsigned long value, int base = DEC);
+    size_t print (long long value, int base = DEC) { return print ((long) value, base); }
+    size_t print (unsigned long long value, int base = DEC) { return print ((unsigned long) value, base); }
+    size_t print (double value, int digits = 2);
+
+    size_t println() { return write ("\r\n"); }
+
+    template <typename T>
+    size_t println (const T& value) {
+      size_t n = print (value);
+      return n + println();
+    }
+
+    template <typename T>
+    size_t println (const T& value, int format) {
+      size_t n = print (value, format);
+      return n + println();
+    }
+};
+
+//======================================================================================//
+/**
+ * @brief The byte input functions of the Arduino Stream class.
+ *
+ */
+class Stream : public Print {
+  public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+
+    size_t readBytes (char* buffer, size_t length);
+    size_t readBytes (uint8_t* buffer, size_t length) { return readBytes ((char*) buffer, length); }
+};
+
+//======================================================================================//
+/**
+ * @brief A serial port. The bytes to receive are set with setInput(). The bytes written
+ * are saved, or printed to the standard output if echo is set.
+ *
+ */
+class HardwareSerial : public Stream {
+  private:
+    const uint8_t* input; // The bytes to receive. Not copied.
+    size_t inputLength; // The number of bytes to receive
+    size_t inputPosition; // The number of bytes received
+    unsigned long baud; // The baudrate given to begin()
+
+  public:
+    bool echo; // True to print the bytes written to the standard output
+    String output; // The bytes written, when echo is not set
+
+    HardwareSerial (bool echo = false);
+    void begin (unsigned long baud, uint16_t config = SERIAL_8N1) { this->baud = baud; (void) config; }
+    void end() {}
+    void setRX (uint8_t pin) { (void) pin; }
+    void setTX (uint8_t pin) { (void) pin; }
+    void setFIFOSize (size_t size) { (void) size; }
+    unsigned long getBaud() const { return baud; }
+    void setInput (const void* data, size_t length);
+
+    int available() override { return (int) (inputLength - inputPosition); }
+    int read() override { return (inputPosition < inputLength) ? input [inputPosition++] : -1; }
+    int peek() override { return (inputPosition < inputLength) ? input [inputPosition] : -1; }
+    size_t write (uint8_t c) override;
+    using Print::write;
+    operator bool() const { return true; }
+};
+
+extern HardwareSerial Serial; // Prints to the standard output
+extern HardwareSerial Serial1;
+extern HardwareSerial Serial2;
+
+#endif
+
+//======================================================================================//
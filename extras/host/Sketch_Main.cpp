@@ -0,0 +1,44 @@
+//======================================================================================//
+/**
+ * @file Sketch_Main.cpp
+ * @brief Runs a sketch on the host. setup() is called once, and loop() is called the
+ * given number of times, so that the sketches that do all their work in setup(), such as
+ * the Benchmark example, return when they are done.
+ * @date +05:30 10:02:18 AM 17-10-2026, Saturday
+ * @version 1.0.0
+ * @author Vishnu Mohanan (@vishnumaiea)
+ * @par GitHub Repository: https://github.com/CIRCUITSTATE/CSE_GNSS
+ * @par MIT License
+ *
+ */
+//======================================================================================//
+
+#include "Arduino.h"
+
+//======================================================================================//
+
+void setup();
+void loop();
+
+//======================================================================================//
+/**
+ * @brief Runs the sketch.
+ *
+ * @param argc The number of arguments.
+ * @param argv The number of times to call loop(). 0 by default.
+ * @return int 0
+ */
+int main (int argc, char* argv[]) {
+  long loopCount = (argc > 1) ? atol (argv [1]) : 0;
+
+  setup();
+
+  for (long i = 0; i < loopCount; i++) {
+    loop();
+  }
+
+  fflush (stdout);
+  return 0;
+}
+
+//======================================================================================//
@@ -0,0 +1,35 @@
+//======================================================================================//
+/**
+ * @file Host_Test.h
+ * @brief A minimal check macro for the host tests. A failed check prints its location and
+ * the expression, and the test returns the number of failed checks from main(), so that
+ * ctest reports any non-zero count as a failure.
+ * @date +05:30 10:34:05 AM 17-10-2026, Saturday
+ * @version 1.0.0
+ * @author Vishnu Mohanan (@vishnumaiea)
+ * @par GitHub Repository: https://github.com/CIRCUITSTATE/CSE_GNSS
+ * @par MIT License
+ *
+ */
+//======================================================================================//
+
+#ifndef CSE_GNSS_HOST_TEST_H
+#define CSE_GNSS_HOST_TEST_H
+
+#include <stdio.h>
+
+//======================================================================================//
+
+static int testFailureCount = 0; // The number of failed checks
+
+#define CHECK(expression) \
+  do { \
+    if (!(expression)) { \
+      printf ("%s:%d: CHECK (%s) failed\n", __FILE__, __LINE__, #expression); \
+      testFailureCount++; \
+    } \
+  } while (0)
+
+#endif
+
+//======================================================================================//
@@ -0,0 +1,105 @@
+//======================================================================================//
+/**
+ * @file Test_Allocations.cpp
+ * @brief Checks that framing and parsing a $GNRMC sentence does not allocate. The sentence
+ * is fed to CSE_GNSS in a chunk and byte by byte, and is also set and parsed directly on an
+ * NMEA_Sentence. The allocations are counted by the replaced operator new.
+ * @date +05:30 10:34:05 AM 17-10-2026, Saturday
+ * @version 1.0.0
+ * @author Vishnu Mohanan (@vishnumaiea)
+ * @par GitHub Repository: https://github.com/CIRCUITSTATE/CSE_GNSS
+ * @par MIT License
+ *
+ */
+//======================================================================================//
+
+#include <Arduino.h>
+#include <CSE_GNSS.h>
+#include <Allocation_Counter.h>
+#include "Host_Test.h"
+
+//======================================================================================//
+
+#define   VAL_REPEAT_COUNT        100       // Number of times each path is repeated
+
+const char GNRMC_Sentence[] = "$GNRMC,083559.00,A,4717.11437,N,00833.91522,E,0.004,77.52,091202,,,A,V*33\r\n";
+const size_t GNRMC_Length = sizeof (GNRMC_Sentence) - 1;
+
+NMEA_Memory_Source GNSS_Source;
+CSE_GNSS GNSS_Module (&GNSS_Source, &Serial1);
+NMEA_Sentence <NMEA_RMC> NMEA_GNRMC;
+
+//======================================================================================//
+/**
+ * @brief Checks the fields of the last parsed sentence.
+ *
+ */
+void checkFields() {
+  NMEA_Fix fix = NMEA_Fix();
+
+  CHECK (NMEA_GNRMC.isParsed());
+  CHECK (NMEA_GNRMC.get <NMEA_RMC::Latitude>().equals ("4717.11437"));
+  CHECK (NMEA_GNRMC.get <NMEA_RMC::NavigationStatus>().equals ("V"));
+  CHECK (NMEA_GNRMC.get <NMEA_RMC::Checksum>().equals ("33"));
+  CHECK (NMEA_GNRMC.decode (fix));
+  CHECK (fix.latitude == 472852395);
+}
+
+//======================================================================================//
+/**
+ * @brief Feeds and parses the sentence on each path and checks the allocation counts.
+ *
+ * @return int The number of failed checks.
+ */
+int main() {
+  CHECK (GNSS_Module.begin());
+  GNSS_Module.addData (&NMEA_GNRMC);
+
+  // The first sentence sets up everything that is allocated only once.
+  CHECK (GNSS_Module.feed (GNRMC_Sentence, GNRMC_Length) == 1);
+  checkFields();
+
+  // A chunk
+  uint32_t allocationCount = getAllocationCount();
+
+  for (int i = 0; i < VAL_REPEAT_COUNT; i++) {
+    CHECK (GNSS_Module.feed (GNRMC_Sentence, GNRMC_Length) == 1);
+    checkFields();
+  }
+
+  printf ("feed (chunk): %u allocations\n", (unsigned) (getAllocationCount() - allocationCount));
+  CHECK (getAllocationCount() == allocationCount);
+
+  // Byte by byte
+  allocationCount = getAllocationCount();
+
+  for (int i = 0; i < VAL_REPEAT_COUNT; i++) {
+    uint16_t sentenceCount = 0;
+
+    for (size_t j = 0; j < GNRMC_Length; j++) {
+      sentenceCount += GNSS_Module.feed (GNRMC_Sentence [j]);
+    }
+
+    CHECK (sentenceCount == 1);
+    checkFields();
+  }
+
+  printf ("feed (byte): %u allocations\n", (unsigned) (getAllocationCount() - allocationCount));
+  CHECK (getAllocationCount() == allocationCount);
+
+  // set() and parse() without the framer. The line ending is not part of the sentence.
+  allocationCount = getAllocationCount();
+
+  for (int i = 0; i < VAL_REPEAT_COUNT; i++) {
+    CHECK (NMEA_GNRMC.set (GNRMC_Sentence, GNRMC_Length - 2));
+    CHECK (NMEA_GNRMC.parse());
+    checkFields();
+  }
+
+  printf ("set() + parse(): %u allocations\n", (unsigned) (getAllocationCount() - allocationCount));
+  CHECK (getAllocationCount() == allocationCount);
+
+  return testFailureCount;
+}
+
+//======================================================================================//
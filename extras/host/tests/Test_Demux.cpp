@@ -0,0 +1,452 @@
+//======================================================================================//
+/**
+ * @file Test_Demux.cpp
+ * @brief Checks that GNSS_Demux finds the same frames however the stream is chunked. A
+ * stream of NMEA, UBX and RTCM 3 frames mixed with noise, broken frames and false UBX and
+ * RTCM headers is fed in one chunk, byte by byte and in random chunks, and the frames
+ * passed to the handlers, the error counts and the byte counts must be the same each
+ * time. Every intact frame of the stream must be passed to a handler.
+ * @date +05:30 10:58:44 AM 17-10-2026, Saturday
+ * @version 1.0.0
+ * @author Vishnu Mohanan (@vishnumaiea)
+ * @par GitHub Repository: https://github.com/CIRCUITSTATE/CSE_GNSS
+ * @par MIT License
+ *
+ */
+//======================================================================================//
+
+#include <Arduino.h>
+#include <CSE_GNSS.h>
+#include <vector>
+#include "Host_Test.h"
+
+//======================================================================================//
+
+#define   VAL_STREAM_COUNT        200       // Number of random streams
+#define   VAL_STREAM_PARTS        60        // Number of frames and noise runs in a stream
+#define   VAL_STREAM_TAIL         CONST_MAX_RTCM_FRAME_LENGTH // Bytes after the last part, so that every declared frame ends
+
+//======================================================================================//
+/**
+ * @brief The frames found in a stream and the counters after it.
+ *
+ */
+struct Demux_Result {
+  std::vector <uint32_t> frames; // A hash of each frame passed to a handler, in order
+  uint32_t nmeaCount; // Valid NMEA sentences
+  uint32_t ubxCount; // Valid UBX frames
+  uint32_t rtcmCount; // Valid RTCM frames
+  uint32_t errorCounts [3]; // The checksum and CRC errors of the NMEA, UBX and RTCM framers
+  uint32_t byteCounts [GNSS_Demux::PROTOCOL_COUNT]; // The byte counts of the demux
+
+  bool operator== (const Demux_Result& result) const {
+    return (frames == result.frames) && (nmeaCount == result.nmeaCount) && (ubxCount == result.ubxCount) &&
+      (rtcmCount == result.rtcmCount) && (memcmp (errorCounts, result.errorCounts, sizeof (errorCounts)) == 0) &&
+      (memcmp (byteCounts, result.byteCounts, sizeof (byteCounts)) == 0);
+  }
+};
+
+//======================================================================================//
+/**
+ * @brief Returns the FNV-1a hash of the bytes, starting from a tag of the protocol.
+ *
+ * @param tag The protocol tag.
+ * @param data The bytes.
+ * @param length The number of bytes.
+ * @return uint32_t The hash.
+ */
+static uint32_t hashBytes (uint8_t tag, const uint8_t* data, size_t length) {
+  uint32_t hash = 2166136261u ^ tag;
+
+  for (size_t i = 0; i < length; i++) {
+    hash = (hash ^ data [i]) * 16777619u;
+  }
+
+  return hash;
+}
+
+//======================================================================================//
+/**
+ * @brief Returns the hash of a UBX frame, from its class, ID and payload.
+ *
+ * @param messageClass The class.
+ * @param id The ID.
+ * @param payload The payload.
+ * @param length The payload length.
+ * @return uint32_t The hash.
+ */
+static uint32_t hashUbxFrame (uint8_t messageClass, uint8_t id, const uint8_t* payload, uint16_t length) {
+  return hashBytes ('U', payload, length) ^ ((messageClass << 8) | id);
+}
+
+//======================================================================================//
+// The handlers record a hash of each frame.
+
+void onSentence (const char* sentence, uint16_t length, void* context) {
+  ((Demux_Result*) context)->frames.push_back (hashBytes ('N', (const uint8_t*) sentence, length));
+}
+
+void onUbxFrame (const UBX_Frame& frame, void* context) {
+  ((Demux_Result*) context)->frames.push_back (hashUbxFrame (frame.messageClass, frame.id, frame.payload, frame.length));
+}
+
+void onRtcmFrame (const uint8_t* frame, uint16_t length, void* context) {
+  ((Demux_Result*) context)->frames.push_back (hashBytes ('R', frame, length));
+}
+
+//======================================================================================//
+/**
+ * @brief Feeds a stream to a new demux with all three framers, in chunks of the given
+ * lengths.
+ *
+ * @param stream The stream.
+ * @param chunkLengths The length of each chunk. The last one is repeated. 0 for one chunk.
+ * @return Demux_Result The frames and the counters.
+ */
+Demux_Result runDemux (const std::vector <uint8_t>& stream, const std::vector <size_t>& chunkLengths) {
+  Demux_Result result = Demux_Result();
+  NMEA_Framer nmeaFramer;
+  UBX_Framer ubxFramer;
+  RTCM_Framer rtcmFramer;
+  GNSS_Demux demux;
+
+  nmeaFramer.setHandler (onSentence, &result);
+  ubxFramer.setHandler (onUbxFrame, &result);
+  rtcmFramer.setHandler (onRtcmFrame, &result);
+  demux.setNmeaFramer (&nmeaFramer);
+  demux.setUbxFramer (&ubxFramer);
+  demux.setRtcmFramer (&rtcmFramer);
+
+  size_t position = 0;
+  size_t chunkIndex = 0;
+
+  while (position < stream.size()) {
+    size_t length = chunkLengths [chunkIndex];
+
+    if ((chunkIndex + 1) < chunkLengths.size()) {
+      chunkIndex++;
+    }
+
+    if ((length == 0) || (length > (stream.size() - position))) {
+      length = stream.size() - position;
+    }
+
+    if (length == 1) {
+      demux.feed (stream [position]);
+    }
+    else {
+      demux.feed (stream.data() + position, length);
+    }
+
+    position += length;
+  }
+
+  result.nmeaCount = nmeaFramer.getSentenceCount();
+  result.ubxCount = ubxFramer.getFrameCount();
+  result.rtcmCount = rtcmFramer.getFrameCount();
+  result.errorCounts [0] = nmeaFramer.getChecksumErrorCount();
+  result.errorCounts [1] = ubxFramer.getChecksumErrorCount();
+  result.errorCounts [2] = rtcmFramer.getCrcErrorCount();
+
+  for (uint8_t i = 0; i < GNSS_Demux::PROTOCOL_COUNT; i++) {
+    result.byteCounts [i] = demux.getByteCount ((GNSS_Demux::Protocol) i);
+  }
+
+  return result;
+}
+
+//======================================================================================//
+// The stream builders. The random numbers are from a fixed seed, so every run tests the
+// same streams.
+
+static uint32_t randomState = 2463534242u; // The xorshift32 state
+
+static uint32_t getRandom (uint32_t range) {
+  randomState ^= randomState << 13;
+  randomState ^= randomState >> 17;
+  randomState ^= randomState << 5;
+  return randomState % range;
+}
+
+void addUbxFrame (std::vector <uint8_t>& stream, uint8_t messageClass, uint8_t id, uint16_t length) {
+  size_t start = stream.size();
+  uint8_t checksumA = 0;
+  uint8_t checksumB = 0;
+
+  stream.push_back ((uint8_t) UBX_Frame::Sync1);
+  stream.push_back ((uint8_t) UBX_Frame::Sync2);
+  stream.push_back (messageClass);
+  stream.push_back (id);
+  stream.push_back (length & 0xFF);
+  stream.push_back (length >> 8);
+
+  for (uint16_t i = 0; i < length; i++) {
+    stream.push_back ((uint8_t) getRandom (256));
+  }
+
+  UBX_Framer::computeChecksum (stream.data() + start + 2, length + 4, checksumA, checksumB);
+  stream.push_back (checksumA);
+  stream.push_back (checksumB);
+}
+
+void addRtcmFrame (std::vector <uint8_t>& stream, uint16_t length) {
+  size_t start = stream.size();
+
+  stream.push_back ((uint8_t) RTCM_Framer::Preamble);
+  stream.push_back (length >> 8);
+  stream.push_back (length & 0xFF);
+
+  for (uint16_t i = 0; i < length; i++) {
+    stream.push_back ((uint8_t) getRandom (256));
+  }
+
+  uint32_t crc = RTCM_Framer::computeCrc (stream.data() + start, length + RTCM_Framer::HeaderLength);
+  stream.push_back (crc >> 16);
+  stream.push_back ((crc >> 8) & 0xFF);
+  stream.push_back (crc & 0xFF);
+}
+
+void addSentence (std::vector <uint8_t>& stream) {
+  char body [48];
+  char sentence [64];
+
+  snprintf (body, sizeof (body), "GPTXT,01,01,02,%lu", (unsigned long) getRandom (1000000));
+  snprintf (sentence, sizeof (sentence), "$%s*%02X\r\n", body, NMEA_Framer::computeChecksum (body, strlen (body)));
+  stream.insert (stream.end(), sentence, sentence + strlen (sentence));
+}
+
+void addNoise (std::vector <uint8_t>& stream) {
+  const uint8_t startBytes[] = {'$', UBX_Frame::Sync1, RTCM_Framer::Preamble, '*', '\r', '\n', 0x00};
+  uint32_t length = 1 + getRandom (20);
+
+  for (uint32_t i = 0; i < length; i++) {
+    stream.push_back (getRandom (3) == 0 ? startBytes [getRandom (sizeof (startBytes))] : (uint8_t) getRandom (256));
+  }
+}
+
+//======================================================================================//
+/**
+ * @brief Builds a random stream of frames and noise. Some of the frames are corrupted or
+ * cut short, and some UBX and RTCM headers are false ones with a short length whose
+ * declared frame covers the next frames. The stream ends with bytes that start no frame,
+ * so that the frames covered by a false header near the end are looked at again.
+ *
+ * @param frames Set to the hash of each frame left intact, in order.
+ * @return std::vector <uint8_t> The stream.
+ */
+std::vector <uint8_t> buildStream (std::vector <uint32_t>& frames) {
+  std::vector <uint8_t> stream;
+
+  frames.clear();
+
+  for (int part = 0; part < VAL_STREAM_PARTS; part++) {
+    size_t start = stream.size();
+    uint32_t hash = 0;
+    bool isFrame = true;
+
+    switch (getRandom (6)) {
+      case 0:
+        addSentence (stream);
+        hash = hashBytes ('N', stream.data() + start, stream.size() - start - 2); // Without the line ending
+        break;
+
+      case 1:
+        addUbxFrame (stream, 0x01, 0x07, getRandom (100));
+        hash = hashUbxFrame (0x01, 0x07, stream.data() + start + UBX_Frame::HeaderLength,
+          stream.size() - start - UBX_Frame::HeaderLength - UBX_Frame::ChecksumLength);
+        break;
+
+      case 2:
+        addRtcmFrame (stream, getRandom (120));
+        hash = hashBytes ('R', stream.data() + start, stream.size() - start);
+        break;
+
+      case 3:
+        // A false preamble
+        stream.push_back ((uint8_t) RTCM_Framer::Preamble);
+        stream.push_back (0x00);
+        stream.push_back ((uint8_t) (10 + getRandom (100)));
+        isFrame = false;
+        break;
+
+      case 4:
+        // False sync characters
+        stream.push_back ((uint8_t) UBX_Frame::Sync1);
+        stream.push_back ((uint8_t) UBX_Frame::Sync2);
+        stream.push_back (0x01);
+        stream.push_back (0x07);
+        stream.push_back ((uint8_t) (10 + getRandom (100)));
+        stream.push_back (0x00);
+        isFrame = false;
+        break;
+
+      default:
+        addNoise (stream);
+        isFrame = false;
+        break;
+    }
+
+    // Corrupt or cut short some of the frames.
+    if ((stream.size() - start) > 4) {
+      uint32_t action = getRandom (10);
+
+      if (action == 0) {
+        stream [start + 1 + getRandom (stream.size() - start - 1)] ^= (uint8_t) (1 + getRandom (255));
+        isFrame = false;
+      }
+      else if (action == 1) {
+        stream.resize (start + 1 + getRandom (stream.size() - start - 1));
+        isFrame = false;
+      }
+    }
+
+    if (isFrame) {
+      frames.push_back (hash);
+    }
+  }
+
+  stream.insert (stream.end(), VAL_STREAM_TAIL, 0x00);
+  return stream;
+}
+
+//======================================================================================//
+/**
+ * @brief Checks that the frames appear in the found frames in the same order. Other
+ * frames can be found between them, eg. in the noise.
+ *
+ * @param frames The frames that must be found.
+ * @param found The frames passed to the handlers.
+ * @return true All the frames were found.
+ */
+bool containsFrames (const std::vector <uint32_t>& frames, const std::vector <uint32_t>& found) {
+  size_t j = 0;
+
+  for (size_t i = 0; i < frames.size(); i++) {
+    while ((j < found.size()) && (found [j] != frames [i])) {
+      j++;
+    }
+
+    if (j == found.size()) {
+      return false;
+    }
+
+    j++;
+  }
+
+  return true;
+}
+
+//======================================================================================//
+/**
+ * @brief Checks a false RTCM preamble with a short length, whose declared frame covers a
+ * valid UBX frame. The UBX frame must be found whether the stream is fed in one chunk,
+ * byte by byte or split inside the false frame.
+ *
+ */
+void testFalsePreamble() {
+  std::vector <uint8_t> stream = {(uint8_t) RTCM_Framer::Preamble, 0x00, 0x3C};
+
+  for (int i = 0; i < 10; i++) {
+    stream.push_back ((uint8_t) (0x10 + i));
+  }
+
+  addUbxFrame (stream, 0x01, 0x07, 22);
+  stream.insert (stream.end(), 30, 0x00); // The rest of the declared frame
+
+  Demux_Result whole = runDemux (stream, {0});
+  Demux_Result bytewise = runDemux (stream, {1});
+  Demux_Result split = runDemux (stream, {20, 0});
+
+  CHECK (whole.ubxCount == 1);
+  CHECK (whole.errorCounts [2] == 1);
+  CHECK (bytewise == whole);
+  CHECK (split == whole);
+}
+
+//======================================================================================//
+/**
+ * @brief Checks false UBX sync characters with a short length, whose declared frame covers
+ * a valid UBX frame and an NMEA sentence. Both must be found whether the stream is fed in
+ * one chunk, byte by byte or split inside the false frame.
+ *
+ */
+void testFalseUbxSync() {
+  std::vector <uint8_t> stream = {(uint8_t) UBX_Frame::Sync1, (uint8_t) UBX_Frame::Sync2, 0x01, 0x07, 0x00, 0x00};
+
+  for (int i = 0; i < 10; i++) {
+    stream.push_back ((uint8_t) (0x10 + i));
+  }
+
+  addUbxFrame (stream, 0x01, 0x07, 22);
+  addSentence (stream);
+  stream [4] = (uint8_t) (stream.size() - UBX_Frame::HeaderLength + 20);
+  stream.insert (stream.end(), 20 + UBX_Frame::ChecksumLength, 0x00); // The rest of the declared frame
+
+  Demux_Result whole = runDemux (stream, {0});
+  Demux_Result bytewise = runDemux (stream, {1});
+  Demux_Result split = runDemux (stream, {20, 0});
+
+  CHECK (whole.ubxCount == 1);
+  CHECK (whole.nmeaCount == 1);
+  CHECK (whole.errorCounts [1] == 1);
+  CHECK (bytewise == whole);
+  CHECK (split == whole);
+}
+
+//======================================================================================//
+/**
+ * @brief Feeds each random stream in one chunk, byte by byte and in random chunks, and
+ * compares the results. The intact frames must be found in each.
+ *
+ */
+void testRandomStreams() {
+  uint32_t mismatchCount = 0;
+  uint32_t missedCount = 0;
+  uint32_t frameCount = 0;
+
+  for (int i = 0; i < VAL_STREAM_COUNT; i++) {
+    std::vector <uint32_t> frames;
+    std::vector <uint8_t> stream = buildStream (frames);
+    std::vector <size_t> chunkLengths;
+
+    for (int j = 0; j < 64; j++) {
+      chunkLengths.push_back (1 + getRandom (48));
+    }
+
+    Demux_Result whole = runDemux (stream, {0});
+    Demux_Result bytewise = runDemux (stream, {1});
+    Demux_Result chunked = runDemux (stream, chunkLengths);
+
+    if (!(bytewise == whole) || !(chunked == whole)) {
+      mismatchCount++;
+    }
+
+    if (!containsFrames (frames, whole.frames)) {
+      missedCount++;
+    }
+
+    frameCount += whole.frames.size();
+  }
+
+  printf ("%d random streams, %u frames, %u mismatches, %u with missed frames\n", VAL_STREAM_COUNT, (unsigned) frameCount,
+    (unsigned) mismatchCount, (unsigned) missedCount);
+  CHECK (frameCount > 0);
+  CHECK (mismatchCount == 0);
+  CHECK (missedCount == 0);
+}
+
+//======================================================================================//
+/**
+ * @brief Runs the tests.
+ *
+ * @return int The number of failed checks.
+ */
+int main() {
+  testFalsePreamble();
+  testFalseUbxSync();
+  testRandomStreams();
+
+  return testFailureCount;
+}
+
+//======================================================================================//
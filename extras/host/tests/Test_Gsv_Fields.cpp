@@ -0,0 +1,88 @@
+//======================================================================================//
+/**
+ * @file Test_Gsv_Fields.cpp
+ * @brief Checks the get<>() fields of NMEA_Sentence <NMEA_GSV> on the GSV variants. The
+ * last sentence of a group can have fewer than 4 satellites, with or without the signal ID
+ * of NMEA 4.10, so the SignalId must be found after the last satellite and the missing
+ * satellites must be empty.
+ * @date +05:30 11:16:02 AM 17-10-2026, Saturday
+ * @version 1.0.0
+ * @author Vishnu Mohanan (@vishnumaiea)
+ * @par GitHub Repository: https://github.com/CIRCUITSTATE/CSE_GNSS
+ * @par MIT License
+ *
+ */
+//======================================================================================//
+
+#include <Arduino.h>
+#include <CSE_GNSS.h>
+#include "Host_Test.h"
+
+//======================================================================================//
+
+NMEA_Sentence <NMEA_GSV> NMEA_GPGSV ("GP");
+
+//======================================================================================//
+/**
+ * @brief Adds the checksum to a sentence body and parses it.
+ *
+ * @param body The sentence without the '$' and the checksum.
+ * @return true The sentence was parsed.
+ */
+bool parseGsv (const char* body) {
+  char line [CONST_MAX_NMEA_SENTENCE_LENGTH + 1];
+  int length = snprintf (line, sizeof (line), "$%s*%02X", body, NMEA_Framer::computeChecksum (body, strlen (body)));
+
+  return NMEA_GPGSV.set (line, (uint16_t) length) && NMEA_GPGSV.parse();
+}
+
+//======================================================================================//
+/**
+ * @brief Runs the tests.
+ *
+ * @return int The number of failed checks.
+ */
+int main() {
+  // A short last sentence with 2 satellites, whose signal ID follows the second block
+  CHECK (parseGsv ("GPGSV,3,3,10,23,38,230,44,29,71,156,47,1"));
+  CHECK (NMEA_GPGSV.get <NMEA_GSV::MessageNumber>().equals ("3"));
+  CHECK (NMEA_GPGSV.get <NMEA_GSV::PRN2>().equals ("29"));
+  CHECK (NMEA_GPGSV.get <NMEA_GSV::SNR2>().equals ("47"));
+  CHECK (NMEA_GPGSV.get <NMEA_GSV::PRN3>().isEmpty());
+  CHECK (NMEA_GPGSV.get <NMEA_GSV::SNR4>().isEmpty());
+  CHECK (NMEA_GPGSV.get <NMEA_GSV::SignalId>().equals ("1"));
+  CHECK (NMEA_GPGSV.get <NMEA_GSV::Checksum>().length == 2);
+
+  // The same without a signal ID
+  CHECK (parseGsv ("GPGSV,3,3,10,23,38,230,44,29,71,156,47"));
+  CHECK (NMEA_GPGSV.get <NMEA_GSV::SNR2>().equals ("47"));
+  CHECK (NMEA_GPGSV.get <NMEA_GSV::PRN3>().isEmpty());
+  CHECK (NMEA_GPGSV.get <NMEA_GSV::SignalId>().isEmpty());
+
+  // 4 satellites with and without a signal ID
+  CHECK (parseGsv ("GPGSV,3,1,10,23,38,230,44,29,71,156,47,07,29,116,41,08,09,081,36,1"));
+  CHECK (NMEA_GPGSV.get <NMEA_GSV::PRN4>().equals ("08"));
+  CHECK (NMEA_GPGSV.get <NMEA_GSV::SNR4>().equals ("36"));
+  CHECK (NMEA_GPGSV.get <NMEA_GSV::SignalId>().equals ("1"));
+
+  CHECK (parseGsv ("GPGSV,3,1,10,23,38,230,44,29,71,156,47,07,29,116,41,08,09,081,36"));
+  CHECK (NMEA_GPGSV.get <NMEA_GSV::SNR4>().equals ("36"));
+  CHECK (NMEA_GPGSV.get <NMEA_GSV::SignalId>().isEmpty());
+
+  // A satellite with an empty SNR, and no satellites at all
+  CHECK (parseGsv ("GPGSV,1,1,01,10,07,189,,7"));
+  CHECK (NMEA_GPGSV.get <NMEA_GSV::Azimuth1>().equals ("189"));
+  CHECK (NMEA_GPGSV.get <NMEA_GSV::SNR1>().isEmpty());
+  CHECK (NMEA_GPGSV.get <NMEA_GSV::PRN2>().isEmpty());
+  CHECK (NMEA_GPGSV.get <NMEA_GSV::SignalId>().equals ("7"));
+
+  CHECK (parseGsv ("GPGSV,1,1,00"));
+  CHECK (NMEA_GPGSV.get <NMEA_GSV::SatellitesInView>().equals ("00"));
+  CHECK (NMEA_GPGSV.get <NMEA_GSV::PRN1>().isEmpty());
+  CHECK (NMEA_GPGSV.get <NMEA_GSV::SignalId>().isEmpty());
+  CHECK (NMEA_GPGSV.get <NMEA_GSV::Checksum>().length == 2);
+
+  return testFailureCount;
+}
+
+//======================================================================================//
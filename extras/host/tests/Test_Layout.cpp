@@ -0,0 +1,40 @@
+//======================================================================================//
+/**
+ * @file Test_Layout.cpp
+ * @brief Checks that CSE_GNSS::begin() fails when the caller was built with other CONST_*
+ * values than the library. This file is built with a larger CONST_MAX_NMEA_DATA_COUNT, as
+ * if the sketch had defined it, so that its CSE_GNSS is larger than the one the library
+ * constructs in it.
+ * @date +05:30 02:18:53 PM 17-10-2026, Saturday
+ * @version 1.0.0
+ * @author Vishnu Mohanan (@vishnumaiea)
+ * @par GitHub Repository: https://github.com/CIRCUITSTATE/CSE_GNSS
+ * @par MIT License
+ *
+ */
+//======================================================================================//
+
+#include <Arduino.h>
+#include <CSE_GNSS.h>
+#include "Host_Test.h"
+
+//======================================================================================//
+
+NMEA_Memory_Source GNSS_Source;
+CSE_GNSS GNSS_Module (&GNSS_Source, &Serial1);
+
+//======================================================================================//
+/**
+ * @brief Runs the tests.
+ *
+ * @return int The number of failed checks.
+ */
+int main() {
+  CHECK (CONST_MAX_NMEA_DATA_COUNT == 32);
+  CHECK (!GNSS_Module.begin());
+  CHECK (!GNSS_Module.begin (0));
+
+  return testFailureCount;
+}
+
+//======================================================================================//
@@ -0,0 +1,92 @@
+//======================================================================================//
+/**
+ * @file Test_Parse.cpp
+ * @brief Checks the validation of NMEA_0183_Data::parse(). A sentence set by the user must
+ * have a matching checksum and a valid number of fields. A sentence that a framer has
+ * verified is not checksummed again, so its fields are only indexed once. A sentence
+ * without the '$' is also typed correctly by the epoch and the statistics.
+ * @date +05:30 03:04:11 PM 17-10-2026, Saturday
+ * @version 1.0.0
+ * @author Vishnu Mohanan (@vishnumaiea)
+ * @par GitHub Repository: https://github.com/CIRCUITSTATE/CSE_GNSS
+ * @par MIT License
+ *
+ */
+//======================================================================================//
+
+#include <Arduino.h>
+#include <CSE_GNSS.h>
+#include "Host_Test.h"
+
+//======================================================================================//
+
+const char GNRMC_Sentence[] = "$GNRMC,083559.00,A,4717.11437,N,00833.91522,E,0.004,77.52,091202,,,A,V*33";
+const char GNRMC_Corrupt[] = "$GNRMC,083559.00,A,4717.11437,N,00833.91522,E,0.004,77.52,091202,,,A,V*34";
+const char GNRMC_Short[] = "$GNRMC,083559.00,A,4717.11437,N*6D";
+
+NMEA_Sentence <NMEA_RMC> NMEA_GNRMC ("GN");
+
+//======================================================================================//
+/**
+ * @brief Sets and parses a sentence in both the modes.
+ *
+ * @param line The sentence.
+ * @param verified True to set it as verified by a framer.
+ * @param lazy True for the lazy mode.
+ * @return true The sentence was parsed.
+ */
+bool parseSentence (const char* line, bool verified, bool lazy) {
+  NMEA_GNRMC.setLazy (lazy);
+  return NMEA_GNRMC.set (line, strlen (line), verified) && NMEA_GNRMC.parse();
+}
+
+//======================================================================================//
+/**
+ * @brief Runs the tests.
+ *
+ * @return int The number of failed checks.
+ */
+int main() {
+  for (int lazy = 0; lazy < 2; lazy++) {
+    CHECK (parseSentence (GNRMC_Sentence, false, lazy));
+    CHECK (NMEA_GNRMC.get <NMEA_RMC::Longitude>().equals ("00833.91522"));
+    CHECK (NMEA_GNRMC.get <NMEA_RMC::Checksum>().equals ("33"));
+
+    // The checksum of the user sentences is computed.
+    CHECK (!parseSentence (GNRMC_Corrupt, false, lazy));
+    CHECK (!NMEA_GNRMC.isParsed());
+
+    // The framed sentences are trusted.
+    CHECK (parseSentence (GNRMC_Corrupt, true, lazy));
+
+    // The header and the '*' are checked either way.
+    CHECK (!parseSentence ("$GPRMC,083559.00,A*33", true, lazy));
+    CHECK (!parseSentence ("$GNRMC,083559.00,A,33", true, lazy));
+  }
+
+  // Only the normal mode checks the number of fields.
+  CHECK (!parseSentence (GNRMC_Short, false, false));
+  CHECK (!parseSentence (GNRMC_Short, true, false));
+  CHECK (parseSentence (GNRMC_Short, false, true));
+  CHECK (NMEA_GNRMC.get <NMEA_RMC::Latitude>().equals ("4717.11437"));
+  CHECK (NMEA_GNRMC.get <NMEA_RMC::Date>().isEmpty());
+
+  // A sentence without the '$' is accepted.
+  CHECK (parseSentence (GNRMC_Sentence + 1, false, false));
+  CHECK (NMEA_GNRMC.get <NMEA_RMC::Status>().equals ("A"));
+  CHECK (NMEA_GNRMC.getFieldCount() == NMEA_RMC::FieldCount);
+  CHECK (GNSS_Stats::getType (GNRMC_Sentence + 1, strlen (GNRMC_Sentence + 1)) == GNSS_Stats::TYPE_RMC);
+  CHECK (GNSS_Stats::getType (GNRMC_Sentence, strlen (GNRMC_Sentence)) == GNSS_Stats::TYPE_RMC);
+
+  NMEA_Epoch epoch;
+  NMEA_Fix fix;
+
+  epoch.setLastSentence ("RMC");
+  epoch.add (NMEA_GNRMC);
+  CHECK (epoch.getSequence() == 1);
+  CHECK (epoch.read (fix) && (fix.flags & NMEA_Fix::FLAG_TIME));
+
+  return testFailureCount;
+}
+
+//======================================================================================//
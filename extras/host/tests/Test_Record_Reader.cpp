@@ -0,0 +1,167 @@
+//======================================================================================//
+/**
+ * @file Test_Record_Reader.cpp
+ * @brief Checks that NMEA_Record_Reader recovers from false sync bytes. The records are
+ * written with NMEA_Record_Writer between runs of noise that contain the sync byte, and
+ * every record must be decoded back to the same fix, whether the stream is fed in one
+ * chunk or byte by byte.
+ * @date +05:30 11:42:37 AM 17-10-2026, Saturday
+ * @version 1.0.0
+ * @author Vishnu Mohanan (@vishnumaiea)
+ * @par GitHub Repository: https://github.com/CIRCUITSTATE/CSE_GNSS
+ * @par MIT License
+ *
+ */
+//======================================================================================//
+
+#include <Arduino.h>
+#include <CSE_GNSS.h>
+#include <vector>
+#include "Host_Test.h"
+
+//======================================================================================//
+
+#define   VAL_RECORD_COUNT        500       // Number of records in the random stream
+
+//======================================================================================//
+
+static uint32_t randomState = 2463534242u; // The xorshift32 state
+
+static uint32_t getRandom (uint32_t range) {
+  randomState ^= randomState << 13;
+  randomState ^= randomState >> 17;
+  randomState ^= randomState << 5;
+  return randomState % range;
+}
+
+// Keeps each decoded fix.
+void onFix (const NMEA_Fix& fix, void* context) {
+  ((std::vector <NMEA_Fix>*) context)->push_back (fix);
+}
+
+//======================================================================================//
+/**
+ * @brief Returns a fix with random values.
+ *
+ * @return NMEA_Fix The fix.
+ */
+NMEA_Fix getRandomFix() {
+  NMEA_Fix fix = NMEA_Fix();
+
+  fix.flags = NMEA_Fix::FLAG_VALID | NMEA_Fix::FLAG_POSITION | NMEA_Fix::FLAG_TIME | NMEA_Fix::FLAG_QUALITY;
+  fix.latitude = (int32_t) getRandom (1800000000) - 900000000;
+  fix.longitude = (int32_t) getRandom (2000000000) - 1000000000;
+  fix.time = getRandom (86400000);
+  fix.quality = 1 + getRandom (5);
+  fix.satellites = getRandom (40);
+  fix.hdop = getRandom (1000);
+  return fix;
+}
+
+//======================================================================================//
+/**
+ * @brief Feeds a stream to a new reader.
+ *
+ * @param stream The stream.
+ * @param bytewise True to feed one byte at a time.
+ * @return std::vector <NMEA_Fix> The decoded fixes.
+ */
+std::vector <NMEA_Fix> runReader (const std::vector <uint8_t>& stream, bool bytewise) {
+  std::vector <NMEA_Fix> fixes;
+  NMEA_Record_Reader reader;
+
+  reader.setHandler (onFix, &fixes);
+
+  if (bytewise) {
+    for (size_t i = 0; i < stream.size(); i++) {
+      reader.feed (stream [i]);
+    }
+  }
+  else {
+    reader.feed (stream.data(), stream.size());
+  }
+
+  return fixes;
+}
+
+//======================================================================================//
+/**
+ * @brief A false sync whose declared record covers a real record.
+ *
+ */
+void testFalseSync() {
+  NMEA_Record_Writer writer;
+  NMEA_Fix fix = getRandomFix();
+  uint8_t record [NMEA_Record::MaxLength];
+  uint8_t recordLength = writer.encode (fix, record);
+  std::vector <uint8_t> stream = {(uint8_t) NMEA_Record::Sync, 0x30};
+
+  stream.insert (stream.end(), record, record + recordLength);
+  stream.insert (stream.end(), 0x30 + 2, 0x00); // The rest of the false record
+
+  std::vector <NMEA_Fix> whole = runReader (stream, false);
+  std::vector <NMEA_Fix> bytewise = runReader (stream, true);
+
+  CHECK (whole.size() == 1);
+  CHECK ((whole.size() == 1) && (whole [0] == fix));
+  CHECK (bytewise.size() == whole.size());
+}
+
+//======================================================================================//
+/**
+ * @brief Key records between runs of noise.
+ *
+ */
+void testNoise() {
+  NMEA_Record_Writer writer (1); // Every record is a key record
+  std::vector <NMEA_Fix> written;
+  std::vector <uint8_t> stream;
+
+  for (int i = 0; i < VAL_RECORD_COUNT; i++) {
+    uint32_t noiseLength = getRandom (12);
+
+    for (uint32_t j = 0; j < noiseLength; j++) {
+      stream.push_back ((getRandom (3) == 0) ? (uint8_t) NMEA_Record::Sync : (uint8_t) getRandom (256));
+    }
+
+    NMEA_Fix fix = getRandomFix();
+    uint8_t record [NMEA_Record::MaxLength];
+    uint8_t recordLength = writer.encode (fix, record);
+
+    stream.insert (stream.end(), record, record + recordLength);
+    written.push_back (fix);
+  }
+
+  // A false record in the noise before the last record waits for more bytes.
+  stream.insert (stream.end(), NMEA_Record::MaxLength, 0x00);
+
+  std::vector <NMEA_Fix> whole = runReader (stream, false);
+  std::vector <NMEA_Fix> bytewise = runReader (stream, true);
+  uint32_t matchCount = 0;
+
+  for (size_t i = 0; (i < whole.size()) && (i < written.size()); i++) {
+    if (whole [i] == written [i]) {
+      matchCount++;
+    }
+  }
+
+  printf ("%u records written, %u decoded, %u matched\n", (unsigned) written.size(), (unsigned) whole.size(), (unsigned) matchCount);
+  CHECK (whole.size() == written.size());
+  CHECK (matchCount == written.size());
+  CHECK (bytewise.size() == whole.size());
+}
+
+//======================================================================================//
+/**
+ * @brief Runs the tests.
+ *
+ * @return int The number of failed checks.
+ */
+int main() {
+  testFalseSync();
+  testNoise();
+
+  return testFailureCount;
+}
+
+//======================================================================================//
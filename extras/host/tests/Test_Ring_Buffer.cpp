@@ -0,0 +1,218 @@
+//======================================================================================//
+/**
+ * @file Test_Ring_Buffer.cpp
+ * @brief Stress test of NMEA_Ring_Buffer with a producer and a consumer thread. The first
+ * run pushes chunks at the byte rate of a 921600 baud link to a consumer that stalls like
+ * a busy loop(), and must not lose any byte. The second run pushes single bytes as fast as
+ * possible to a slower consumer, so that the buffer overflows. In both runs, every byte
+ * that push() accepted must arrive intact and in order, and the overflow count must match
+ * the bytes that push() rejected.
+ * @date +05:30 10:41:27 AM 17-10-2026, Saturday
+ * @version 1.0.0
+ * @author Vishnu Mohanan (@vishnumaiea)
+ * @par GitHub Repository: https://github.com/CIRCUITSTATE/CSE_GNSS
+ * @par MIT License
+ *
+ */
+//======================================================================================//
+
+#include <Arduino.h>
+#include <CSE_GNSS.h>
+#include <atomic>
+#include <thread>
+#include "Host_Test.h"
+
+//======================================================================================//
+
+#define   VAL_BYTE_RATE           92160     // Bytes per second of a 921600 baud link
+#define   VAL_PACED_DURATION      1000000   // Length of the paced run in microseconds
+#define   VAL_CHUNK_LENGTH        64        // Bytes pushed at a time in the paced run, like a DMA block
+#define   VAL_CONSUMER_STALL      2000      // Time the consumer spends on other work in microseconds
+#define   VAL_FLOOD_LENGTH        4000000   // Bytes pushed in the overflowing run
+
+//======================================================================================//
+
+/**
+ * @brief The result of a run, as seen by each side.
+ *
+ */
+struct Ring_Run {
+  uint32_t pushedCount; // Bytes accepted by push()
+  uint32_t rejectedCount; // Bytes rejected by push()
+  uint32_t receivedCount; // Bytes read by the consumer
+  uint32_t corruptCount; // Bytes read by the consumer that were not the expected ones
+  uint32_t overflowCount; // The overflow count of the buffer
+};
+
+//======================================================================================//
+/**
+ * @brief Returns the byte at a position of the accepted stream. The upper bits of the
+ * position are mixed in, so that a byte left over from an earlier lap of the buffer does
+ * not match.
+ *
+ * @param position The position in the stream.
+ * @return char The byte.
+ */
+static inline char getPatternByte (uint32_t position) {
+  return (char) (position ^ (position >> 8) ^ (position >> 16));
+}
+
+//======================================================================================//
+/**
+ * @brief Drains the buffer and checks each byte, until the producer is done and the buffer
+ * is empty.
+ *
+ * @param ring The buffer.
+ * @param done Set by the producer after its last push.
+ * @param run The run to update.
+ * @param stall The time to sleep after each drain in microseconds.
+ */
+template <size_t Capacity>
+void consume (NMEA_Ring_Buffer <Capacity>& ring, std::atomic <bool>& done, Ring_Run& run, uint32_t stall) {
+  while (true) {
+    bool finished = done.load (std::memory_order_acquire);
+    const char* data;
+    size_t length;
+
+    while ((length = ring.peek (data)) > 0) {
+      for (size_t i = 0; i < length; i++) {
+        if (data [i] != getPatternByte (run.receivedCount)) {
+          run.corruptCount++;
+        }
+
+        run.receivedCount++;
+      }
+
+      ring.consume (length);
+    }
+
+    if (finished) {
+      break;
+    }
+
+    if (stall > 0) {
+      delayMicroseconds (stall);
+    }
+  }
+}
+
+//======================================================================================//
+/**
+ * @brief Pushes chunks at VAL_BYTE_RATE while a stalling consumer drains them.
+ *
+ * @return Ring_Run The result.
+ */
+Ring_Run runPaced() {
+  static NMEA_Ring_Buffer <4096> ring;
+  std::atomic <bool> done (false);
+  Ring_Run run = Ring_Run();
+
+  std::thread consumer (consume <4096>, std::ref (ring), std::ref (done), std::ref (run), VAL_CONSUMER_STALL);
+
+  uint32_t startTime = micros();
+  uint32_t totalLength = (uint64_t) VAL_BYTE_RATE * VAL_PACED_DURATION / 1000000;
+  uint32_t producedCount = 0;
+  char chunk [VAL_CHUNK_LENGTH];
+
+  while (producedCount < totalLength) {
+    // The bytes that have arrived on the link since the start.
+    uint32_t dueCount = (uint64_t) (micros() - startTime) * VAL_BYTE_RATE / 1000000;
+
+    if (dueCount > totalLength) {
+      dueCount = totalLength;
+    }
+
+    if (((dueCount - producedCount) < VAL_CHUNK_LENGTH) && (dueCount < totalLength)) {
+      delayMicroseconds (100);
+      continue;
+    }
+
+    size_t length = ((dueCount - producedCount) < VAL_CHUNK_LENGTH) ? (dueCount - producedCount) : VAL_CHUNK_LENGTH;
+
+    for (size_t i = 0; i < length; i++) {
+      chunk [i] = getPatternByte (run.pushedCount + i);
+    }
+
+    size_t count = ring.push (chunk, length);
+
+    run.pushedCount += count;
+    run.rejectedCount += length - count;
+    producedCount += length;
+  }
+
+  done.store (true, std::memory_order_release);
+  consumer.join();
+
+  run.overflowCount = ring.getOverflowCount();
+  return run;
+}
+
+//======================================================================================//
+/**
+ * @brief Pushes single bytes as fast as possible while a stalling consumer drains them.
+ *
+ * @return Ring_Run The result.
+ */
+Ring_Run runFlood() {
+  static NMEA_Ring_Buffer <1024> ring;
+  std::atomic <bool> done (false);
+  Ring_Run run = Ring_Run();
+
+  std::thread consumer (consume <1024>, std::ref (ring), std::ref (done), std::ref (run), 50);
+
+  for (uint32_t i = 0; i < VAL_FLOOD_LENGTH; i++) {
+    if (ring.push (getPatternByte (run.pushedCount))) {
+      run.pushedCount++;
+    }
+    else {
+      run.rejectedCount++;
+    }
+  }
+
+  done.store (true, std::memory_order_release);
+  consumer.join();
+
+  run.overflowCount = ring.getOverflowCount();
+  return run;
+}
+
+//======================================================================================//
+/**
+ * @brief Prints a run.
+ *
+ * @param name The name of the run.
+ * @param run The run.
+ */
+void printRun (const char* name, const Ring_Run& run) {
+  printf ("%s: %u pushed, %u rejected, %u received, %u corrupt, %u overflow\n", name, (unsigned) run.pushedCount,
+    (unsigned) run.rejectedCount, (unsigned) run.receivedCount, (unsigned) run.corruptCount, (unsigned) run.overflowCount);
+}
+
+//======================================================================================//
+/**
+ * @brief Runs both the tests.
+ *
+ * @return int The number of failed checks.
+ */
+int main() {
+  Ring_Run paced = runPaced();
+  printRun ("921600 baud", paced);
+
+  CHECK (paced.pushedCount == (uint64_t) VAL_BYTE_RATE * VAL_PACED_DURATION / 1000000);
+  CHECK (paced.rejectedCount == 0);
+  CHECK (paced.overflowCount == 0);
+  CHECK (paced.receivedCount == paced.pushedCount);
+  CHECK (paced.corruptCount == 0);
+
+  Ring_Run flood = runFlood();
+  printRun ("Overflow", flood);
+
+  CHECK (flood.rejectedCount > 0);
+  CHECK (flood.overflowCount == flood.rejectedCount);
+  CHECK (flood.receivedCount == flood.pushedCount);
+  CHECK (flood.corruptCount == 0);
+
+  return testFailureCount;
+}
+
+//======================================================================================//
@@ -13,257 +13,6085 @@
 //======================================================================================//
 
 #include "CSE_GNSS.h"
+#include <limits.h>
+
+#if defined(__linux__)
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <time.h>
+  #include <unistd.h>
+  #include <thread>
+  #include <vector>
+#endif
+
+//======================================================================================//
+/**
+ * @brief Checks if the character is a valid hexadecimal digit (0-9, A-F, a-f).
+ * 
+ * @param c The character to check.
+ * @return true The character is a hex digit.
+ * @return false The character is not a hex digit.
+ */
+static inline bool isHexChar (char c) {
+  return ((c >= '0') && (c <= '9')) || ((c >= 'A') && (c <= 'F')) || ((c >= 'a') && (c <= 'f'));
+}
+
+//======================================================================================//
+/**
+ * @brief Converts a hexadecimal digit to its value. The character must be a valid hex digit.
+ * 
+ * @param c The hex digit.
+ * @return uint8_t The value from 0 to 15.
+ */
+static inline uint8_t hexValue (char c) {
+  if (c <= '9') {
+    return c - '0';
+  }
+
+  return (c & ~0x20) - 'A' + 10; // Convert to uppercase first
+}
+
+#if CSE_GNSS_SWAR_ENABLED
+//======================================================================================//
+// Word-at-a-time helpers. Each byte lane of a word is tested in parallel using the
+// carry tricks from "Bit Twiddling Hacks". The results are only used as true/false.
+
+typedef uintptr_t NMEA_Word;
+
+static const NMEA_Word WORD_ONES = ~((NMEA_Word) 0) / 0xFF; // 0x0101..01
+static const NMEA_Word WORD_HIGHS = WORD_ONES * 0x80; // 0x8080..80
+
+/**
+ * @brief Checks if any byte in the word is less than n. n must not exceed 128.
+ */
+static inline NMEA_Word wordHasLess (NMEA_Word x, uint8_t n) {
+  return (x - (WORD_ONES * n)) & ~x & WORD_HIGHS;
+}
+
+/**
+ * @brief Checks if any byte in the word is greater than n. n must not exceed 127.
+ */
+static inline NMEA_Word wordHasMore (NMEA_Word x, uint8_t n) {
+  return ((x + (WORD_ONES * (127 - n))) | x) & WORD_HIGHS;
+}
+
+/**
+ * @brief Checks if any byte in the word is equal to c.
+ */
+static inline NMEA_Word wordHasByte (NMEA_Word x, char c) {
+  return wordHasLess (x ^ (WORD_ONES * (uint8_t) c), 1);
+}
+
+/**
+ * @brief Checks if all the bytes in the word are plain sentence body characters. That is,
+ * printable ASCII other than '$' and '*'.
+ */
+static inline bool wordIsPlain (NMEA_Word x) {
+  return (wordHasLess (x, 0x20) | wordHasMore (x, 0x7E) | wordHasByte (x, '$') | wordHasByte (x, '*')) == 0;
+}
+
+/**
+ * @brief Folds the bytes of a word into a single byte with XOR.
+ */
+static inline uint8_t wordFoldXor (NMEA_Word x) {
+  for (uint8_t shift = (sizeof (NMEA_Word) * 8) / 2; shift >= 8; shift /= 2) {
+    x ^= x >> shift;
+  }
+
+  return (uint8_t) x;
+}
+#endif
+
+//======================================================================================//
+/**
+ * @brief NMEA_Framer constructor. The framer starts in the idle state and waits for a '$'.
+ * 
+ * @return NMEA_Framer:: 
+ */
+NMEA_Framer:: NMEA_Framer() {
+  handler = nullptr;
+  handlerContext = nullptr;
+  filter = nullptr;
+  filterContext = nullptr;
+  timeSource = getTime;
+  sentenceTime = 0;
+  chunkFeeding = false;
+  chunkStamped = false;
+  resetCounts();
+  reset();
+}
+
+//======================================================================================//
+/**
+ * @brief Computes the NMEA checksum of the given bytes, which is the XOR of all of them.
+ * Pass the characters between the '$' and the '*'.
+ * 
+ * @param data The bytes.
+ * @param length The number of bytes.
+ * @return uint8_t The checksum.
+ */
+uint8_t NMEA_Framer:: computeChecksum (const char* data, size_t length) {
+  uint8_t checksum = 0;
+  size_t i = 0;
+
+  #if CSE_GNSS_SWAR_ENABLED
+    NMEA_Word wordChecksum = 0;
+
+    for (; (i + sizeof (NMEA_Word)) <= length; i += sizeof (NMEA_Word)) {
+      NMEA_Word word;
+      memcpy (&word, data + i, sizeof (NMEA_Word));
+      wordChecksum ^= word;
+    }
+
+    checksum = wordFoldXor (wordChecksum);
+  #endif
+
+  for (; i < length; i++) {
+    checksum ^= (uint8_t) data [i];
+  }
+
+  return checksum;
+}
+
+//======================================================================================//
+/**
+ * @brief Sets the function to call when a complete sentence is framed.
+ * 
+ * @param handler The handler function. Can be nullptr.
+ * @param context A user pointer that will be passed to the handler.
+ */
+void NMEA_Framer:: setHandler (NMEA_Sentence_Handler handler, void* context) {
+  this->handler = handler;
+  handlerContext = context;
+}
+
+//======================================================================================//
+/**
+ * @brief Sets the function that decides whether a sentence is kept, as soon as its first
+ * HeaderLength characters are received. A rejected sentence is not copied any further, and
+ * the framer skips to the next '$'. Its checksum is not verified.
+ * 
+ * @param filter The filter function. nullptr to keep all the sentences.
+ * @param context A user pointer that will be passed to the filter.
+ */
+void NMEA_Framer:: setFilter (NMEA_Sentence_Filter filter, void* context) {
+  this->filter = filter;
+  filterContext = context;
+}
+
+//======================================================================================//
+/**
+ * @brief Sets the clock that stamps each sentence when its '$' is fed. The stamp is only as
+ * close to the actual arrival as the bytes are fed, so feed them as soon as they are
+ * received, eg. with CSE_GNSS::update(), instead of in large batches.
+ * 
+ * @param clock The clock. getTime() by default. nullptr to not stamp the sentences.
+ */
+void NMEA_Framer:: setClock (NMEA_Clock clock) {
+  timeSource = clock;
+}
+
+//======================================================================================//
+/**
+ * @brief Returns the time of the default arrival clock. It is micros(), except on Linux,
+ * where it is CLOCK_MONOTONIC, which does not jump when the system time is set. Use the
+ * same clock to stamp the samples of other sensors.
+ * 
+ * @return uint32_t The time in microseconds. Wraps at 2^32.
+ */
+uint32_t NMEA_Framer:: getTime() {
+  #if defined(__linux__)
+    struct timespec now;
+    clock_gettime (CLOCK_MONOTONIC, &now);
+    return (uint32_t) (((uint64_t) now.tv_sec * 1000000) + (now.tv_nsec / 1000));
+  #else
+    return micros();
+  #endif
+}
+
+//======================================================================================//
+/**
+ * @brief Marks the start of a chunk of bytes that were received together. The sentences
+ * that start in the chunk get the time of the first of them, so the clock is read only
+ * once per chunk. feed() and GNSS_Demux::feed() call this for each chunk.
+ * 
+ */
+void NMEA_Framer:: beginChunk() {
+  chunkFeeding = true;
+  chunkStamped = false;
+}
+
+//======================================================================================//
+/**
+ * @brief Marks the end of a chunk. Each sentence reads the clock again when its '$' is fed.
+ * 
+ */
+void NMEA_Framer:: endChunk() {
+  chunkFeeding = false;
+  chunkStamped = false;
+}
+
+//======================================================================================//
+/**
+ * @brief Discards any partially framed sentence and waits for the next '$'.
+ * 
+ */
+void NMEA_Framer:: reset() {
+  state = STATE_IDLE;
+  sentenceLength = 0;
+  sentenceBuffer [0] = 0;
+  checksum = 0;
+  receivedChecksum = 0;
+}
+
+//======================================================================================//
+/**
+ * @brief Feeds a single byte to the framer. A sentence is complete when the two checksum
+ * characters after the '*' are received. The checksum is computed as the bytes arrive and
+ * is compared at that point. Sentences with a wrong checksum are dropped and counted.
+ * Otherwise the handler is called and the sentence stays available through getSentence()
+ * until the next '$' arrives. Binary data, line endings before the checksum and oversized
+ * sentences discard the partial sentence, and are counted. So do the sentences rejected
+ * by the filter.
+ * 
+ * @param c The byte to feed.
+ * @return true A sentence was completed by this byte.
+ * @return false No sentence was completed.
+ */
+bool NMEA_Framer:: feed (char c) {
+  // A '$' always starts a new sentence, even if the previous one was not complete.
+  if (c == '$') {
+    if (state != STATE_IDLE) {
+      truncatedCount++;
+      droppedByteCount += sentenceLength;
+    }
+
+    // The sentences that start in the same chunk arrived together, so the clock is read
+    // only for the first of them.
+    if (!chunkStamped) {
+      sentenceTime = (timeSource != nullptr) ? timeSource() : 0;
+      chunkStamped = chunkFeeding;
+    }
+
+    sentenceBuffer [0] = c;
+    sentenceLength = 1;
+    checksum = 0;
+    state = STATE_BODY;
+    return false;
+  }
+
+  if (state == STATE_IDLE) {
+    return false;
+  }
+
+  // Only printable ASCII characters can be part of a sentence.
+  if (((uint8_t) c < 0x20) || ((uint8_t) c > 0x7E)) {
+    drop (truncatedCount);
+    return false;
+  }
+
+  if (sentenceLength >= CONST_MAX_NMEA_SENTENCE_LENGTH) {
+    drop (oversizeCount);
+    return false;
+  }
+
+  switch (state) {
+    case STATE_BODY:
+      if (c == '*') {
+        state = STATE_CHECKSUM_1;
+      }
+      else {
+        checksum ^= (uint8_t) c;
+      }
+      break;
+
+    case STATE_CHECKSUM_1:
+      if (!isHexChar (c)) {
+        drop (truncatedCount);
+        return false;
+      }
+      receivedChecksum = hexValue (c) << 4;
+      state = STATE_CHECKSUM_2;
+      break;
+
+    case STATE_CHECKSUM_2:
+      if (!isHexChar (c)) {
+        drop (truncatedCount);
+        return false;
+      }
+      receivedChecksum |= hexValue (c);
+
+      // Drop the sentence before anyone looks at its fields.
+      if (receivedChecksum != checksum) {
+        drop (checksumErrorCount);
+        droppedByteCount++; // The last checksum character
+        return false;
+      }
+
+      sentenceBuffer [sentenceLength++] = c;
+      sentenceBuffer [sentenceLength] = 0;
+      state = STATE_IDLE;
+      sentenceCount++;
+
+      if (handler != nullptr) {
+        handler (sentenceBuffer, sentenceLength, handlerContext);
+      }
+      return true;
+
+    default:
+      break;
+  }
+
+  sentenceBuffer [sentenceLength++] = c;
+
+  if ((sentenceLength == HeaderLength) && (filter != nullptr) && (state == STATE_BODY) && !filter (sentenceBuffer, filterContext)) {
+    filteredCount++;
+    reset();
+  }
+
+  return false;
+}
+
+//======================================================================================//
+/**
+ * @brief Feeds a chunk of bytes to the framer. Each byte is visited only once. The handler
+ * is called for every sentence completed inside the chunk.
+ * 
+ * The bytes between the sentences, including the rest of the sentences rejected by the
+ * filter, are skipped with memchr() to the next '$'. The sentences are framed with
+ * feedFrame().
+ * 
+ * @param data The bytes to feed.
+ * @param length The number of bytes.
+ * @return uint16_t The number of sentences completed.
+ */
+uint16_t NMEA_Framer:: feed (const char* data, size_t length) {
+  uint32_t startCount = sentenceCount;
+  size_t i = 0;
+
+  beginChunk();
+
+  while (i < length) {
+    if (state == STATE_IDLE) {
+      const char* next = (const char*) memchr (data + i, '$', length - i);
+
+      if (next == nullptr) {
+        break;
+      }
+
+      i = next - data;
+    }
+
+    i += feedFrame (data + i, length - i);
+  }
+
+  endChunk();
+  return sentenceCount - startCount;
+}
+
+//======================================================================================//
+/**
+ * @brief Feeds the bytes of a single sentence, from its '$' or from where the previous
+ * call stopped, and stops as soon as the sentence is completed or dropped. The bytes after
+ * it are left to the caller, which is how a GNSS_Demux shares a stream between framers.
+ * 
+ * When SWAR is enabled, the sentence body after the header is copied and checksummed a
+ * whole word at a time for as long as the word has no special characters. The remaining
+ * bytes take the regular byte-at-a-time path.
+ * 
+ * @param data The bytes to feed.
+ * @param length The number of bytes.
+ * @return size_t The number of bytes used, at least 1 if length is not 0.
+ */
+size_t NMEA_Framer:: feedFrame (const char* data, size_t length) {
+  size_t i = 0;
+
+  while (i < length) {
+    #if CSE_GNSS_SWAR_ENABLED
+      // The header goes through feed (char), so that the filter sees it.
+      if ((state == STATE_BODY) && ((filter == nullptr) || (sentenceLength >= HeaderLength))) {
+        NMEA_Word wordChecksum = 0;
+        bool wordsCopied = false;
+
+        while (((i + sizeof (NMEA_Word)) <= length) && ((sentenceLength + sizeof (NMEA_Word)) <= CONST_MAX_NMEA_SENTENCE_LENGTH)) {
+          NMEA_Word word;
+          memcpy (&word, data + i, sizeof (NMEA_Word));
+
+          if (!wordIsPlain (word)) {
+            break;
+          }
+
+          memcpy (sentenceBuffer + sentenceLength, &word, sizeof (NMEA_Word));
+          sentenceLength += sizeof (NMEA_Word);
+          wordChecksum ^= word;
+          i += sizeof (NMEA_Word);
+          wordsCopied = true;
+        }
+
+        if (wordsCopied) {
+          checksum ^= wordFoldXor (wordChecksum);
+          continue;
+        }
+      }
+    #endif
+
+    feed (data [i++]);
+
+    if (state == STATE_IDLE) {
+      break;
+    }
+  }
+
+  return i;
+}
+
+//======================================================================================//
+/**
+ * @brief Returns the last completed sentence as a null terminated string. The sentence
+ * is valid only until the next sentence starts.
+ * 
+ * @return const char* The sentence.
+ */
+const char* NMEA_Framer:: getSentence() const {
+  return sentenceBuffer;
+}
+
+//======================================================================================//
+/**
+ * @brief Returns the length of the last completed sentence.
+ * 
+ * @return uint16_t The length in bytes.
+ */
+uint16_t NMEA_Framer:: getSentenceLength() const {
+  return sentenceLength;
+}
+
+//======================================================================================//
+/**
+ * @brief Returns the number of valid sentences framed so far.
+ * 
+ * @return uint32_t The sentence count.
+ */
+uint32_t NMEA_Framer:: getSentenceCount() const {
+  return sentenceCount;
+}
+
+//======================================================================================//
+/**
+ * @brief Returns the number of sentences that were dropped because the received checksum
+ * did not match the computed one.
+ * 
+ * @return uint32_t The checksum error count.
+ */
+uint32_t NMEA_Framer:: getChecksumErrorCount() const {
+  return checksumErrorCount;
+}
+
+//======================================================================================//
+/**
+ * @brief Returns the number of sentences that were rejected by the filter.
+ * 
+ * @return uint32_t The filtered sentence count.
+ */
+uint32_t NMEA_Framer:: getFilteredCount() const {
+  return filteredCount;
+}
+
+//======================================================================================//
+/**
+ * @brief Sets the sentence count and all the error counters to 0.
+ * 
+ */
+void NMEA_Framer:: resetCounts() {
+  sentenceCount = 0;
+  checksumErrorCount = 0;
+  filteredCount = 0;
+  oversizeCount = 0;
+  truncatedCount = 0;
+  droppedByteCount = 0;
+}
+
+//======================================================================================//
+/**
+ * @brief Checks if the field has no characters.
+ * 
+ * @return true The field is empty.
+ * @return false The field has at least one character.
+ */
+bool NMEA_Field:: isEmpty() const {
+  return length == 0;
+}
+
+//======================================================================================//
+/**
+ * @brief Compares the field with a null terminated string.
+ * 
+ * @param str The string to compare with.
+ * @return true The field and the string are the same.
+ * @return false The field and the string are different.
+ */
+bool NMEA_Field:: equals (const char* str) const {
+  if (str == nullptr) {
+    return false;
+  }
+
+  return (strlen (str) == length) && (strncmp (data, str, length) == 0);
+}
+
+//======================================================================================//
+/**
+ * @brief Copies the field to a new String object. This allocates memory, so use it only
+ * when you actually need a String.
+ * 
+ * @return String The field as a String.
+ */
+String NMEA_Field:: toString() const {
+  String str;
+  str.reserve (length);
+
+  for (uint8_t i = 0; i < length; i++) {
+    str += data [i];
+  }
+
+  return str;
+}
+
+//======================================================================================//
+/**
+ * @brief NMEA_0183_Data constructor.
+ * 
+ * @param name The name of the NMEA sentence.eg. "GPRMC".
+ * @param dataCount The number of data fields in the NMEA sentence.
+ * @param dataNames The names of the data fields. The array is not copied and must remain valid.
+ * @param sample A sample string of the NMEA sentence.
+ * @return NMEA_0183_Data:: 
+ */
+NMEA_0183_Data:: NMEA_0183_Data (String name, String description, int dataCount, String dataNames[], String sample) : 
+  name (name),
+  description (description), 
+  sample (sample),
+  dataCount (dataCount),
+  minDataCount (dataCount),
+  schema (nullptr),
+  dataNameList (dataNames) {
+    GNSS_Parent = nullptr;
+    sentence [0] = 0;
+    sentenceLength = 0;
+    fieldCount = 0;
+    indexPosition = 0;
+    parsed = false;
+    lazy = false;
+    verified = false;
+    handler = nullptr;
+    handlerContext = nullptr;
+    changeTracker = nullptr;
+    arrivalTime = 0;
+}
+
+//======================================================================================//
+/**
+ * @brief NMEA_0183_Data constructor for the built-in sentence schemas. The names and the
+ * description are not copied, they are read from the schema when needed. You normally use
+ * the NMEA_Sentence template instead of this.
+ * 
+ * @param talker The talker ID. eg. "GN" or "GP".
+ * @param schema The schema info. eg. &NMEA_RMC::Info.
+ * @return NMEA_0183_Data:: 
+ */
+NMEA_0183_Data:: NMEA_0183_Data (const char* talker, const NMEA_Schema_Info* schema) :
+  name (talker),
+  dataCount (schema->fieldCount),
+  minDataCount (schema->minFieldCount),
+  schema (schema),
+  dataNameList (nullptr) {
+    name += schema->type;
+    GNSS_Parent = nullptr;
+    sentence [0] = 0;
+    sentenceLength = 0;
+    fieldCount = 0;
+    indexPosition = 0;
+    parsed = false;
+    lazy = false;
+    verified = false;
+    handler = nullptr;
+    handlerContext = nullptr;
+    changeTracker = nullptr;
+    arrivalTime = 0;
+}
+
+//======================================================================================//
+/**
+ * @brief Parse/extract the data from the NMEA sentence. The sentence has to be set first
+ * with the set() function. The position and length of each field is saved in a single
+ * pass, which also finds the commas and the '*'. A sentence that was not verified by a
+ * framer is read once more to compute its checksum. No memory is allocated. Use
+ * getField() to access the fields.
+ * 
+ * In the lazy mode, only the header and the checksum are checked, and the fields are
+ * indexed by getField() as far as the field that is asked for. The checksum is not computed
+ * again if the sentence was verified by a framer. The number of fields is not checked, so
+ * the missing fields are read as empty.
+ * 
+ * If a change tracker is set, it is updated with the fields of the parsed sentence.
+ * 
+ * @return true If parsing was successful.
+ * @return false If parsing was not successful.
+ */
+bool NMEA_0183_Data:: parse() {
+  parsed = false;
+  fieldCount = 0;
+  indexPosition = 0;
+
+  if (lazy) {
+    uint16_t nameLength = name.length();
+    uint16_t headerStart = ((sentenceLength > 0) && (sentence [0] == '$')) ? 1 : 0;
+    uint16_t starIndex = sentenceLength - 3;
+
+    // The checksum is the last 3 characters, as the framer leaves it.
+    if ((sentenceLength < (headerStart + nameLength + 3)) || (strncmp (sentence + headerStart, name.c_str(), nameLength) != 0) ||
+        (sentence [starIndex] != '*') || !isHexChar (sentence [starIndex + 1]) || !isHexChar (sentence [starIndex + 2])) {
+      CSE_GNSS_LOG_WARN (GNSS_Parent, "NMEA_0183_Data parse(): Invalid NMEA sentence.");
+      return false;
+    }
+
+    // The framer has already verified the checksum of the sentences it delivers, so only
+    // the header is read and the cost does not depend on the length of the sentence.
+    uint8_t receivedChecksum = (hexValue (sentence [starIndex + 1]) << 4) | hexValue (sentence [starIndex + 2]);
+
+    if (!verified && (NMEA_Framer::computeChecksum (sentence + headerStart, starIndex - headerStart) != receivedChecksum)) {
+      CSE_GNSS_LOG_WARN (GNSS_Parent, "NMEA_0183_Data parse(): Checksum mismatch.");
+      return false;
+    }
+  }
+  else {
+    CSE_GNSS_LOG_DEBUG (GNSS_Parent, "NMEA_0183_Data parse(): ", sentence);
+
+    uint16_t nameLength = name.length();
+    uint16_t headerStart = ((sentenceLength > 0) && (sentence [0] == '$')) ? 1 : 0;
+
+    if ((sentenceLength < (headerStart + nameLength)) || (strncmp (sentence + headerStart, name.c_str(), nameLength) != 0)) {
+      CSE_GNSS_LOG_WARN (GNSS_Parent, "NMEA_0183_Data parse(): Invalid NMEA sentence.");
+      return false;
+    }
+
+    // The fields are indexed in the same pass that finds the commas and the '*'.
+    if (!indexFields (dataMax)) {
+      CSE_GNSS_LOG_WARN (GNSS_Parent, "NMEA_0183_Data parse(): Too many fields.");
+      fieldCount = 0;
+      return false;
+    }
+
+    // The last field is the checksum after the '*', and the rest are separated by commas.
+    // Some sentences have shorter variants.
+    uint8_t checksumIndex = fieldCount - 1;
+    uint16_t starIndex = fieldOffsets [checksumIndex] - 1;
+
+    if ((fieldCount < 2) || (sentence [starIndex] != '*') || (fieldLengths [checksumIndex] < 2) ||
+        !isHexChar (sentence [starIndex + 1]) || !isHexChar (sentence [starIndex + 2])) {
+      CSE_GNSS_LOG_WARN (GNSS_Parent, "NMEA_0183_Data parse(): No checksum found.");
+      fieldCount = 0;
+      return false;
+    }
+
+    if ((fieldCount < minDataCount) || (fieldCount > dataCount)) {
+      CSE_GNSS_LOG_WARN (GNSS_Parent, "NMEA_0183_Data parse(): Invalid comma count.");
+      fieldCount = 0;
+      return false;
+    }
+
+    // The framer has already verified the checksum of the sentences it delivers.
+    uint8_t receivedChecksum = (hexValue (sentence [starIndex + 1]) << 4) | hexValue (sentence [starIndex + 2]);
+
+    if (!verified && (NMEA_Framer::computeChecksum (sentence + headerStart, starIndex - headerStart) != receivedChecksum)) {
+      CSE_GNSS_LOG_WARN (GNSS_Parent, "NMEA_0183_Data parse(): Checksum mismatch.");
+      fieldCount = 0;
+      return false;
+    }
+  }
+
+  parsed = true;
+
+  if (changeTracker != nullptr) {
+    changeTracker->update (*this);
+  }
+
+  CSE_GNSS_LOG_DEBUG (GNSS_Parent, "NMEA_0183_Data parse(): Completed.");
+  return true;
+}
+
+//======================================================================================//
+/**
+ * @brief Saves the position and length of the fields, from where the last call stopped up
+ * to the field with the given index, or to the end of the sentence. The fields are
+ * separated by commas, and the checksum by an asterisk.
+ * 
+ * @param index The index of the last field to index.
+ * @return true The fields were indexed.
+ * @return false The sentence has more than dataMax fields. The fields that fit are indexed.
+ */
+bool NMEA_0183_Data:: indexFields (int index) const {
+  while ((fieldCount <= index) && (indexPosition <= sentenceLength)) {
+    uint16_t end = indexPosition;
+
+    while ((end < sentenceLength) && (sentence [end] != ',') && (sentence [end] != '*')) {
+      end++;
+    }
+
+    // The last field is the checksum, or the last datum if there is no checksum.
+    if ((end < sentenceLength) && (fieldCount >= (dataMax - 1))) {
+      return false;
+    }
+
+    fieldOffsets [fieldCount] = indexPosition;
+    fieldLengths [fieldCount] = end - indexPosition;
+    fieldCount++;
+    indexPosition = end + 1;
+  }
+
+  return true;
+}
+
+//======================================================================================//
+/**
+ * @brief Set the NMEA sentence.
+ * 
+ * @param line A valid NMEA sentence. Not checked for validity.
+ * @return true If setting was successful.
+ * @return false If setting was not successful.
+ */
+bool NMEA_0183_Data:: set (String line) {
+  return set (line.c_str(), line.length());
+}
+
+//======================================================================================//
+/**
+ * @brief Set the NMEA sentence from a character buffer. The sentence is copied to the
+ * internal buffer, so the source buffer can be reused after this call. Any trailing CR or
+ * LF characters are removed.
+ * 
+ * @param line The NMEA sentence. Not checked for validity.
+ * @param length The number of characters in the sentence.
+ * @param verified True if a framer has already verified the checksum, so that parse()
+ * does not compute it again.
+ * @return true If setting was successful.
+ * @return false If the sentence is too long.
+ */
+bool NMEA_0183_Data:: set (const char* line, uint16_t length, bool verified) {
+  while ((length > 0) && ((line [length - 1] == '\r') || (line [length - 1] == '\n'))) {
+    length--;
+  }
+
+  if (length > CONST_MAX_NMEA_SENTENCE_LENGTH) {
+    CSE_GNSS_LOG_WARN (GNSS_Parent, "NMEA_0183_Data set(): Sentence is too long.");
+    sentenceLength = 0;
+    sentence [0] = 0;
+    this->verified = false;
+    return false;
+  }
+
+  memcpy (sentence, line, length);
+  sentence [length] = 0;
+  sentenceLength = length;
+  fieldCount = 0;
+  indexPosition = 0;
+  parsed = false;
+  this->verified = verified;
+  arrivalTime = 0;
+
+  CSE_GNSS_LOG_DEBUG (GNSS_Parent, "NMEA_0183_Data set(): ", sentence);
+  return true;
+}
+
+//======================================================================================//
+/**
+ * @brief Prints the GNSS data saved in the object.
+ * 
+ * @return true 
+ * @return false 
+ */
+bool NMEA_0183_Data:: print() {
+  if ((GNSS_Parent == nullptr) || (GNSS_Parent->Debug_Serial == nullptr)) {
+    return false;
+  }
+
+  GNSS_Parent->Debug_Serial->println ("NMEA_0183_Data print(): ");
+
+  GNSS_Parent->Debug_Serial->print (name);
+  GNSS_Parent->Debug_Serial->print (": ");
+
+  if (schema != nullptr) {
+    GNSS_Parent->Debug_Serial->println (schema->description);
+  }
+  else {
+    GNSS_Parent->Debug_Serial->println (description);
+  }
+
+  GNSS_Parent->Debug_Serial->print ("  ");
+
+  uint8_t count = getFieldCount();
+
+  for (int i = 0; i < count; i++) {
+    NMEA_Field field = getField (i);
+
+    if ((schema != nullptr) && (schema->fieldNames != nullptr)) {
+      // The checksum is always the last field, even in the shorter variants.
+      GNSS_Parent->Debug_Serial->print (schema->fieldNames [(i == (count - 1)) ? (dataCount - 1) : i]);
+    }
+    else if (dataNameList != nullptr) {
+      GNSS_Parent->Debug_Serial->print (dataNameList [i]);
+    }
+    else {
+      GNSS_Parent->Debug_Serial->print (i);
+    }
+
+    GNSS_Parent->Debug_Serial->print (": ");
+    GNSS_Parent->Debug_Serial->write (field.data, field.length);
+    GNSS_Parent->Debug_Serial->println();
+    GNSS_Parent->Debug_Serial->print ("  ");
+  }
+  GNSS_Parent->Debug_Serial->println();
+  return true;
+}
+
+//======================================================================================//
+/**
+ * @brief Checks the given line if it is a valid NMEA sentence.
+ * 
+ * @param line A line to check.
+ * @return true Line is a valid NMEA sentence.
+ * @return false Line is not a valid NMEA sentence.
+ */
+bool NMEA_0183_Data:: check (String line) {
+  return check (line.c_str(), line.length());
+}
+
+//======================================================================================//
+/**
+ * @brief Checks the given character buffer if it is a valid NMEA sentence.
+ * 
+ * @param line The characters to check. Does not have to be null terminated.
+ * @param length The number of characters.
+ * @return true Line is a valid NMEA sentence.
+ * @return false Line is not a valid NMEA sentence.
+ */
+bool NMEA_0183_Data:: check (const char* line, uint16_t length) {
+  CSE_GNSS_LOG_DEBUG (GNSS_Parent, "NMEA_0183_Data check(): ", NMEA_Field {line, (uint8_t) length});
+
+  // Check if the NMEA header is valid. The '$' is optional.
+  uint16_t nameLength = name.length();
+  uint16_t headerStart = ((length > 0) && (line [0] == '$')) ? 1 : 0;
+
+  if ((length < (headerStart + nameLength)) || (strncmp (line + headerStart, name.c_str(), nameLength) != 0)) {
+    CSE_GNSS_LOG_DEBUG (GNSS_Parent, "NMEA_0183_Data check(): Invalid header.");
+    return false;
+  }
+
+  // Check if the comma count is valid.
+  int commaCount = 0;
+  int starIndex = -1;
+
+  for (uint16_t i = 0; i < length; i++) {
+    if (line [i] == ',') {
+      commaCount++;
+    }
+    else if ((line [i] == '*') && (starIndex == -1)) {
+      starIndex = i;
+    }
+  }
+
+  // Return false if the comma count is not valid.
+  // The last datum of the NMEA sentence is a checksum and a parameter combined with an asterisk.
+  // So the total comma count will be 2 less. Some sentences have shorter variants.
+  if ((commaCount < (minDataCount - 2)) || (commaCount > (dataCount - 2))) {
+    CSE_GNSS_LOG_WARN (GNSS_Parent, "NMEA_0183_Data check(): Invalid comma count.");
+    return false;
+  }
+
+  // Check if the a valid checksum is present.
+  if ((starIndex == -1) || ((starIndex + 3) > length) || !isHexChar (line [starIndex + 1]) || !isHexChar (line [starIndex + 2])) {
+    CSE_GNSS_LOG_WARN (GNSS_Parent, "NMEA_0183_Data check(): No checksum found.");
+    return false;
+  }
+
+  // The checksum is the XOR of everything between the '$' and the '*'.
+  uint8_t receivedChecksum = (hexValue (line [starIndex + 1]) << 4) | hexValue (line [starIndex + 2]);
+
+  if (NMEA_Framer::computeChecksum (line + headerStart, starIndex - headerStart) != receivedChecksum) {
+    CSE_GNSS_LOG_WARN (GNSS_Parent, "NMEA_0183_Data check(): Checksum mismatch.");
+    return false;
+  }
+
+  // Return true if the NMEA sentence is valid.
+  CSE_GNSS_LOG_DEBUG (GNSS_Parent, "NMEA_0183_Data check(): Valid ", name, " sentence.");
+  return true;
+}
+
+//======================================================================================//
+/**
+ * @brief Find the particular NMEA sentence from the given lines. The lines have to 
+ * separated by a newline character. Some NMEA sentences can have multiple lines.
+ * In that case, you can specify which occurrence of the NMEA sentence you want to find.
+ * If the occurrence is not specified, the first occurrence will be returned.
+ * 
+ * @param lines The lines as a String separated by a newline character.
+ * @param occurrence The occurrence of the given NMEA line to read. Default is 1 (1st).
+ * @return true Data was successfully parsed and saved.
+ * @return false No valid line was found.
+ */
+bool NMEA_0183_Data:: find (String lines, int occurrence) {
+  if ((occurrence < 1) || (occurrence > (CONST_MAX_NMEA_LINES_COUNT - 1))) {
+    CSE_GNSS_LOG_WARN (GNSS_Parent, "NMEA_0183_Data find(): Invalid position.");
+    return false;
+  }
+
+  String splittedLines [CONST_MAX_NMEA_LINES_COUNT] = {""};
+  unsigned int startIndex = 0;
+  int lineCount = 0;  // Total number of lines.
+  int occurrenceCount = 0; // The number of instances/occurrence of the given NMEA type in the lines.
+  int occurrenceIndex = -1; // The index of the given NMEA type in the lines array.
+
+  // Split the lines to an array.
+  for (unsigned int i = 0; i < lines.length(); i++) {
+    if ((lines.charAt (i) == '\n') || (i == (lines.length() - 1))) {
+      if (lineCount >= CONST_MAX_NMEA_LINES_COUNT) {
+        break;
+      }
+      // The LF character will be dropped here.
+      splittedLines [lineCount] = lines.substring (startIndex, i);
+      startIndex = i + 1;
+      lineCount++;
+    }
+  }
+
+  // // Print the string array with special characters converted to <CR> and <LF>.
+  // GNSS_Parent->Debug_Serial->println ("NMEA_0183_Data find(): splittedLines = ");
+  // for (int i = 0; i < lineCount; i++) {
+  //   for (int j = 0; j < splittedLines [i].length(); j++) {
+  //     if (splittedLines [i].charAt (j) == '\r') {
+  //       GNSS_Parent->Debug_Serial->print ("<CR>");
+  //     }
+  //     else if (splittedLines [i].charAt (j) == '\n') {
+  //       GNSS_Parent->Debug_Serial->print ("<LF>");
+  //     }
+  //     else {
+  //       GNSS_Parent->Debug_Serial->print (splittedLines [i].charAt (j));
+  //     }
+  //   }
+  //   GNSS_Parent->Debug_Serial->println();
+  // }
+
+  // for (int i = 0; i < lineCount; i++) {
+  //   GNSS_Parent->Debug_Serial->println (splittedLines [i]);
+  // }
+
+  CSE_GNSS_LOG_DEBUG (GNSS_Parent, "NMEA_0183_Data find(): Lines to search = ", lineCount);
+
+  // Check if any lines starts with the given NMEA ID.
+  for (int i = 0; i < lineCount; i++) {
+    if ((splittedLines [i].startsWith (name)) || (splittedLines [i].startsWith (String ("$") + name))) {
+      occurrenceCount += 1;
+    }
+
+    // Break if we find the line at the same occurrence we want.
+    if (occurrenceCount == occurrence) {
+      occurrenceIndex = i;
+      break;
+    }
+  }
+
+  // Return false if no valid line was found.
+  if (occurrenceCount == -1) {
+    CSE_GNSS_LOG_INFO (GNSS_Parent, "NMEA_0183_Data find(): No valid lines found.");
+    return false;
+  }
+
+  // If the occurrenceCount is not -1, but less than the position, that means there was at least one
+  // line, but not enough to reach the position. For example if you wanted to get the 2nd
+  // GPGSV message in the lines, but there was only one, then the occurrenceCount would be 0.
+  if (occurrenceCount < occurrence) {
+    CSE_GNSS_LOG_INFO (GNSS_Parent, "NMEA_0183_Data find(): Not enough lines to find the required occurence.");
+    CSE_GNSS_LOG_INFO (GNSS_Parent, "NMEA_0183_Data find(): occurrenceCount: ", occurrenceCount);
+    return false;
+  }
+
+  // If the occurrenceCount is equal to the occurrence, then we have found the line we want.
+  if (occurrenceCount == occurrence) {
+    CSE_GNSS_LOG_DEBUG (GNSS_Parent, "NMEA_0183_Data find(): Found ", name, " line at position ", occurrenceIndex);
+    set (splittedLines [occurrenceIndex]);
+    return parse();
+  }
+
+  return false;
+}
+
+//======================================================================================//
+/**
+ * @brief Counts the number of particular NMEA sentences in the given lines.
+ * 
+ * @param lines GNSS data lines separated by newline characters.
+ * @return int The number of lines that starts with the given NMEA ID.
+ */
+int NMEA_0183_Data:: count (String lines) {
+  String splittedLines [CONST_MAX_NMEA_LINES_COUNT] = {""};
+  unsigned int startIndex = 0;
+  int lineCount = 0;
+  int instanceCount = 0;
+
+  // Split the lines to an array.
+  for (unsigned int i = 0; i < lines.length(); i++) {
+    if ((lines.charAt (i) == '\n') || (i == (lines.length() - 1))) {
+      // The LF character will be dropped here.
+      splittedLines [lineCount] = lines.substring (startIndex, i);
+      startIndex = i + 1;
+      lineCount++;
+    }
+  }
+
+  // Check if any lines starts with the given NMEA ID.
+  for (int i = 0; i < lineCount; i++) {
+    if ((splittedLines [i].startsWith (name)) || (splittedLines [i].startsWith (String ("$") + name))) {
+      instanceCount += 1;
+    }
+  }
+
+  CSE_GNSS_LOG_DEBUG (GNSS_Parent, "NMEA_0183_Data count(): Found ", instanceCount, " ", name, " lines.");
+
+  return instanceCount;
+}
+
+//======================================================================================//
+/**
+ * @brief Checks if a data named "dataName" exists in the dataName array and returns
+ * the index if it does. Useful for updating the data. You must make sure the returned
+ * index is valid and not -1, before trying to use it.
+ * 
+ * @param dataName The name of the data to search for. Eg. "Header".
+ * @return int The index position. -1 if not found.
+ */
+int NMEA_0183_Data:: getDataIndex (String dataName) const {
+  if ((schema != nullptr) && (schema->fieldNames != nullptr)) {
+    for (int i = 0; i < dataCount; i++) {
+      if (strcmp (schema->fieldNames [i], dataName.c_str()) == 0) {
+        return i;
+      }
+    }
+
+    return -1;
+  }
+
+  if (dataNameList == nullptr) {
+    return -1;
+  }
+
+  for (int i = 0; i < dataCount; i++) {
+    if (dataNameList [i] == dataName) {
+      return i;
+    }
+  }
+
+  return -1;
+}
+
+//======================================================================================//
+/**
+ * @brief Returns a view of the parsed field at the given index. The view points into the
+ * sentence buffer, so no memory is allocated. An empty field is returned if the index is
+ * not valid or the sentence is not parsed yet.
+ * 
+ * @param index The index of the field. 0 is the header.
+ * @return NMEA_Field The field view.
+ */
+NMEA_Field NMEA_0183_Data:: getField (int index) const {
+  NMEA_Field field;
+
+  if (lazy && parsed && (index >= fieldCount)) {
+    indexFields (index);
+  }
+
+  if ((index < 0) || (index >= fieldCount)) {
+    field.data = sentence + sentenceLength;
+    field.length = 0;
+    return field;
+  }
+
+  field.data = sentence + fieldOffsets [index];
+  field.length = fieldLengths [index];
+  return field;
+}
+
+//======================================================================================//
+/**
+ * @brief Returns a view of the parsed field with the given name.
+ * 
+ * @param dataName The name of the data field. Eg. "Latitude".
+ * @return NMEA_Field The field view. Empty if the name is not found.
+ */
+NMEA_Field NMEA_0183_Data:: getField (String dataName) const {
+  return getField (getDataIndex (dataName));
+}
+
+//======================================================================================//
+/**
+ * @brief Returns the number of fields in the parsed sentence, including the header and
+ * the checksum. In the lazy mode, the rest of the fields are indexed first.
+ * 
+ * @return uint8_t The number of fields. 0 if the sentence is not parsed.
+ */
+uint8_t NMEA_0183_Data:: getFieldCount() const {
+  if (lazy && parsed) {
+    indexFields (dataMax);
+  }
+
+  return fieldCount;
+}
+
+//======================================================================================//
+/**
+ * @brief Sets the lazy mode, where parse() only checks the header and the checksum, and
+ * the fields are indexed on the first access, only as far as the field asked for. Use it
+ * when only a few fields of each sentence are read. The index is kept until the next
+ * sentence is set. Takes effect from the next parse().
+ * 
+ * @param lazy true to index the fields on the first access.
+ */
+void NMEA_0183_Data:: setLazy (bool lazy) {
+  this->lazy = lazy;
+}
+
+//======================================================================================//
+/**
+ * @brief Sets a function that is called every time a sentence of this type is received
+ * through CSE_GNSS feed() or update() and parsed successfully. The handler gets this object,
+ * so the fields can be read with getField() or get<>() without copying.
+ * 
+ * @param handler The handler function. nullptr to remove.
+ * @param context A user pointer passed to the handler.
+ */
+void NMEA_0183_Data:: setHandler (NMEA_Data_Handler handler, void* context) {
+  this->handler = handler;
+  handlerContext = context;
+}
+
+//======================================================================================//
+/**
+ * @brief Sets the tracker that compares each parsed sentence with the previous one, to
+ * find the fields that changed. The tracker is reset, so the next sentence is changed in
+ * all the fields. Use one tracker per data object.
+ * 
+ * @param tracker The change tracker. nullptr to remove.
+ */
+void NMEA_0183_Data:: setChangeTracker (NMEA_Change_Tracker* tracker) {
+  changeTracker = tracker;
+
+  if (changeTracker != nullptr) {
+    changeTracker->reset();
+  }
+}
+
+//======================================================================================//
+/**
+ * @brief Checks if a field changed since the previous sentence of this type. Without a
+ * change tracker, all the fields are considered changed.
+ * 
+ * @param index The index of the field. 0 is the header.
+ * @return true The field changed, or there is no change tracker.
+ * @return false The field is the same as in the previous sentence.
+ */
+bool NMEA_0183_Data:: isChanged (int index) const {
+  return (changeTracker == nullptr) || changeTracker->isChanged (index);
+}
+
+//======================================================================================//
+/**
+ * @brief Constructs a change tracker with no previous sentence.
+ * 
+ * @param ignoredFields One bit per field index whose change does not count, eg.
+ * `1UL << NMEA_RMC::UTC`.
+ */
+NMEA_Change_Tracker:: NMEA_Change_Tracker (uint32_t ignoredFields) : fieldHashes(), changedFields (0),
+  ignoredFields (ignoredFields), unchangedCount (0), fieldCount (0), compared (false) {
+}
+
+//======================================================================================//
+/**
+ * @brief Compares the fields of a parsed sentence with those of the previous sentence and
+ * saves their hashes for the next one. A field that the previous sentence did not have,
+ * or that this one does not have, is changed. In the lazy mode, all the fields are indexed.
+ * 
+ * @param data A parsed sentence.
+ * @return true A field that is not ignored changed, or there was no previous sentence.
+ * @return false Only the ignored fields changed.
+ */
+bool NMEA_Change_Tracker:: update (const NMEA_0183_Data& data) {
+  uint8_t count = data.getFieldCount();
+
+  // The last field is the checksum.
+  count = (count > 0) ? (count - 1) : 0;
+
+  uint8_t slotCount = (count > MaxFields) ? (uint8_t) MaxFields : count;
+  uint32_t changed = compared ? 0 : 0xFFFFFFFFUL;
+  uint32_t hash = 0;
+
+  for (uint8_t i = 0; i < count; i++) {
+    // The fields from the last slot on are hashed together.
+    hash = getHash (data.getField (i), (i < MaxFields) ? 2166136261UL : hash);
+
+    if ((i >= (MaxFields - 1)) && ((i + 1) < count)) {
+      continue;
+    }
+
+    uint8_t slot = (i < MaxFields) ? i : (MaxFields - 1);
+
+    if ((slot >= fieldCount) || (fieldHashes [slot] != hash)) {
+      changed |= 1UL << slot;
+    }
+
+    fieldHashes [slot] = hash;
+  }
+
+  // The fields that the previous sentence had and this one does not.
+  for (uint8_t i = slotCount; i < fieldCount; i++) {
+    changed |= 1UL << i;
+  }
+
+  changedFields = changed;
+  fieldCount = slotCount;
+  compared = true;
+
+  if ((changed & ~ignoredFields) == 0) {
+    unchangedCount++;
+    return false;
+  }
+
+  return true;
+}
+
+//======================================================================================//
+/**
+ * @brief Forgets the previous sentence, so that all the fields of the next sentence are
+ * changed.
+ * 
+ */
+void NMEA_Change_Tracker:: reset() {
+  changedFields = 0;
+  fieldCount = 0;
+  compared = false;
+}
+
+//======================================================================================//
+/**
+ * @brief Sets the fields whose change does not count, such as the UTC time, which changes
+ * in every sentence. The changes are still saved and returned by getChangedFields().
+ * 
+ * @param mask One bit per field index, eg. `(1UL << NMEA_GGA::UTC) | (1UL << NMEA_GGA::Age)`.
+ */
+void NMEA_Change_Tracker:: setIgnoredFields (uint32_t mask) {
+  ignoredFields = mask;
+}
+
+//======================================================================================//
+/**
+ * @brief Checks if a field that is not ignored changed in the last sentence.
+ * 
+ * @return true A field changed.
+ * @return false Only the ignored fields changed, or no sentence has been compared.
+ */
+bool NMEA_Change_Tracker:: isChanged() const {
+  return (changedFields & ~ignoredFields) != 0;
+}
+
+//======================================================================================//
+/**
+ * @brief Checks if a field changed in the last sentence, whether it is ignored or not.
+ * 
+ * @param index The index of the field. The indices from MaxFields - 1 on share one bit.
+ * @return true The field changed.
+ * @return false The field is the same as in the previous sentence.
+ */
+bool NMEA_Change_Tracker:: isChanged (int index) const {
+  if (index < 0) {
+    return false;
+  }
+
+  return (changedFields & (1UL << ((index < MaxFields) ? index : (MaxFields - 1)))) != 0;
+}
+
+//======================================================================================//
+/**
+ * @brief Computes the 32-bit FNV-1a hash of the field characters followed by a comma. The
+ * hash of a field can be passed as the start of the next, to hash several fields together.
+ * 
+ * @param field The field to hash.
+ * @param hash The start value. The FNV offset basis by default.
+ * @return uint32_t The hash.
+ */
+uint32_t NMEA_Change_Tracker:: getHash (NMEA_Field field, uint32_t hash) {
+  for (uint8_t i = 0; i < field.length; i++) {
+    hash = (hash ^ (uint8_t) field.data [i]) * 16777619UL;
+  }
+
+  return (hash ^ ',') * 16777619UL;
+}
+
+//======================================================================================//
+// Built-in sentence schemas.
+
+constexpr const char* NMEA_RMC::Sample;
+constexpr const char* NMEA_GGA::Sample;
+constexpr const char* NMEA_GSA::Sample;
+constexpr const char* NMEA_GSV::Sample;
+constexpr const char* NMEA_VTG::Sample;
+constexpr const char* NMEA_GLL::Sample;
+constexpr const char* NMEA_ZDA::Sample;
+
+static const char* const RMC_Field_Names [] = {"Header", "UTC", "Status", "Latitude", "Latitude Direction", "Longitude", "Longitude Direction", "Speed", "Course", "Date", "Mag Variation", "Mag Variation Direction", "Mode", "Navigation Status", "Checksum"};
+static const char* const GGA_Field_Names [] = {"Header", "UTC", "Latitude", "Latitude Direction", "Longitude", "Longitude Direction", "Quality", "Satellites", "HDOP", "Altitude", "Altitude Unit", "Separation", "Separation Unit", "Differential Age", "Differential Station", "Checksum"};
+static const char* const GSA_Field_Names [] = {"Header", "Mode", "Fix Type", "Satellite 1", "Satellite 2", "Satellite 3", "Satellite 4", "Satellite 5", "Satellite 6", "Satellite 7", "Satellite 8", "Satellite 9", "Satellite 10", "Satellite 11", "Satellite 12", "PDOP", "HDOP", "VDOP", "System ID", "Checksum"};
+static const char* const GSV_Field_Names [] = {"Header", "Message Count", "Message Number", "Satellites In View", "PRN 1", "Elevation 1", "Azimuth 1", "SNR 1", "PRN 2", "Elevation 2", "Azimuth 2", "SNR 2", "PRN 3", "Elevation 3", "Azimuth 3", "SNR 3", "PRN 4", "Elevation 4", "Azimuth 4", "SNR 4", "Signal ID", "Checksum"};
+static const char* const VTG_Field_Names [] = {"Header", "Course True", "Course True Unit", "Course Magnetic", "Course Magnetic Unit", "Speed Knots", "Speed Knots Unit", "Speed Km/h", "Speed Km/h Unit", "Mode", "Checksum"};
+static const char* const GLL_Field_Names [] = {"Header", "Latitude", "Latitude Direction", "Longitude", "Longitude Direction", "UTC", "Status", "Mode", "Checksum"};
+static const char* const ZDA_Field_Names [] = {"Header", "UTC", "Day", "Month", "Year", "Local Zone Hours", "Local Zone Minutes", "Checksum"};
+
+static_assert ((sizeof (RMC_Field_Names) / sizeof (RMC_Field_Names [0])) == NMEA_RMC::FieldCount, "RMC_Field_Names does not match NMEA_RMC.");
+static_assert ((sizeof (GGA_Field_Names) / sizeof (GGA_Field_Names [0])) == NMEA_GGA::FieldCount, "GGA_Field_Names does not match NMEA_GGA.");
+static_assert ((sizeof (GSA_Field_Names) / sizeof (GSA_Field_Names [0])) == NMEA_GSA::FieldCount, "GSA_Field_Names does not match NMEA_GSA.");
+static_assert ((sizeof (GSV_Field_Names) / sizeof (GSV_Field_Names [0])) == NMEA_GSV::FieldCount, "GSV_Field_Names does not match NMEA_GSV.");
+static_assert ((sizeof (VTG_Field_Names) / sizeof (VTG_Field_Names [0])) == NMEA_VTG::FieldCount, "VTG_Field_Names does not match NMEA_VTG.");
+static_assert ((sizeof (GLL_Field_Names) / sizeof (GLL_Field_Names [0])) == NMEA_GLL::FieldCount, "GLL_Field_Names does not match NMEA_GLL.");
+static_assert ((sizeof (ZDA_Field_Names) / sizeof (ZDA_Field_Names [0])) == NMEA_ZDA::FieldCount, "ZDA_Field_Names does not match NMEA_ZDA.");
+
+// Format: Type, Description, Sample, Field Names, Field Count, Minimum Field Count
+// The minimum counts allow the NMEA 2.x/3.x variants without the Mode, Navigation Status,
+// System ID and Signal ID fields, and the GSV sentences with less than four satellites.
+const NMEA_Schema_Info NMEA_RMC::Info = {"RMC", "Recommended Minimum Specific GNSS Data", NMEA_RMC::Sample, RMC_Field_Names, NMEA_RMC::FieldCount, NMEA_RMC::FieldCount - 2};
+const NMEA_Schema_Info NMEA_GGA::Info = {"GGA", "Global Positioning System Fix Data", NMEA_GGA::Sample, GGA_Field_Names, NMEA_GGA::FieldCount, NMEA_GGA::FieldCount};
+const NMEA_Schema_Info NMEA_GSA::Info = {"GSA", "GNSS DOP and Active Satellites", NMEA_GSA::Sample, GSA_Field_Names, NMEA_GSA::FieldCount, NMEA_GSA::FieldCount - 1};
+const NMEA_Schema_Info NMEA_GSV::Info = {"GSV", "GNSS Satellites in View", NMEA_GSV::Sample, GSV_Field_Names, NMEA_GSV::FieldCount, NMEA_GSV::PRN1 + 1};
+const NMEA_Schema_Info NMEA_VTG::Info = {"VTG", "Course Over Ground and Ground Speed", NMEA_VTG::Sample, VTG_Field_Names, NMEA_VTG::FieldCount, NMEA_VTG::FieldCount - 1};
+const NMEA_Schema_Info NMEA_GLL::Info = {"GLL", "Geographic Position - Latitude/Longitude", NMEA_GLL::Sample, GLL_Field_Names, NMEA_GLL::FieldCount, NMEA_GLL::FieldCount - 1};
+const NMEA_Schema_Info NMEA_ZDA::Info = {"ZDA", "Time and Date", NMEA_ZDA::Sample, ZDA_Field_Names, NMEA_ZDA::FieldCount, NMEA_ZDA::FieldCount};
+
+//======================================================================================//
+/**
+ * @brief Compares two fixes field by field. The fields are compared by value, so the
+ * result does not depend on the bytes between the fields.
+ * 
+ * @param fix The fix to compare with.
+ * @return true All the fields are equal.
+ * @return false Some field is different.
+ */
+bool NMEA_Fix:: operator== (const NMEA_Fix& fix) const {
+  return (latitude == fix.latitude) && (longitude == fix.longitude) && (altitude == fix.altitude) &&
+    (time == fix.time) && (speed == fix.speed) && (date == fix.date) && (course == fix.course) &&
+    (hdop == fix.hdop) && (pdop == fix.pdop) && (vdop == fix.vdop) && (flags == fix.flags) &&
+    (quality == fix.quality) && (satellites == fix.satellites) && (fixMode == fix.fixMode) &&
+    (satellitesInView == fix.satellitesInView);
+}
+
+//======================================================================================//
+/**
+ * @brief Checks if the character is a decimal digit.
+ *
+ * @param c The character to check.
+ * @return true The character is a digit.
+ * @return false The character is not a digit.
+ */
+static inline bool isDigitChar (char c) {
+  return (c >= '0') && (c <= '9');
+}
+
+//======================================================================================//
+/**
+ * @brief Converts a decimal number like "-12.345" to an integer scaled by 10^decimals. For
+ * example, "12.345" with 2 decimals becomes 1234. The extra decimal digits are truncated.
+ *
+ * @param field The field to convert.
+ * @param decimals The number of decimal digits to keep.
+ * @param value The converted value.
+ * @return true The conversion was successful.
+ * @return false The field is empty, invalid or too large.
+ */
+bool NMEA_Decoder:: decodeFixed (NMEA_Field field, uint8_t decimals, int32_t& value) {
+  const char* p = field.data;
+  const char* end = field.data + field.length;
+  bool negative = false;
+  bool digitFound = false;
+  uint8_t decimalCount = 0;
+  int32_t result = 0;
+
+  if ((p < end) && ((*p == '-') || (*p == '+'))) {
+    negative = (*p == '-');
+    p++;
+  }
+
+  // Integer part
+  for (; (p < end) && isDigitChar (*p); p++) {
+    if (result > 214748363) {
+      return false;
+    }
+
+    result = (result * 10) + (*p - '0');
+    digitFound = true;
+  }
+
+  // Fractional part
+  if ((p < end) && (*p == '.')) {
+    for (p++; (p < end) && isDigitChar (*p); p++) {
+      if (decimalCount < decimals) {
+        if (result > 214748363) {
+          return false;
+        }
+
+        result = (result * 10) + (*p - '0');
+        decimalCount++;
+      }
+
+      digitFound = true;
+    }
+  }
+
+  if ((p != end) || !digitFound) {
+    return false;
+  }
+
+  for (; decimalCount < decimals; decimalCount++) {
+    if (result > 214748363) {
+      return false;
+    }
+
+    result *= 10;
+  }
+
+  value = negative ? -result : result;
+  return true;
+}
+
+//======================================================================================//
+/**
+ * @brief Converts an NMEA coordinate in "ddmm.mmmm" (latitude) or "dddmm.mmmm" (longitude)
+ * format and its hemisphere to degrees x 10^7. Up to 6 decimal digits of the minutes are
+ * used. The result is negative for the southern and western hemispheres.
+ *
+ * @param value The coordinate field.
+ * @param hemisphere The hemisphere field (N, S, E or W).
+ * @param degrees The converted value in degrees x 10^7.
+ * @return true The conversion was successful.
+ * @return false The fields are empty or invalid.
+ */
+bool NMEA_Decoder:: decodeCoordinate (NMEA_Field value, NMEA_Field hemisphere, int32_t& degrees) {
+  const char* p = value.data;
+  const char* end = value.data + value.length;
+  uint32_t whole = 0; // The ddmm part
+  uint32_t fraction = 0; // The decimal minutes x 10^6
+  uint8_t wholeDigits = 0;
+
+  if (hemisphere.length != 1) {
+    return false;
+  }
+
+  for (; (p < end) && isDigitChar (*p); p++) {
+    if (++wholeDigits > 5) {
+      return false;
+    }
+
+    whole = (whole * 10) + (*p - '0');
+  }
+
+  if (wholeDigits < 3) {
+    return false;
+  }
+
+  uint32_t scale = 100000;
+
+  if ((p < end) && (*p == '.')) {
+    for (p++; (p < end) && isDigitChar (*p); p++) {
+      fraction += (*p - '0') * scale;
+      scale /= 10;
+    }
+  }
+
+  if (p != end) {
+    return false;
+  }
+
+  uint32_t wholeDegrees = whole / 100;
+  uint32_t minutes = (whole % 100) * 1000000 + fraction; // Minutes x 10^6
+
+  if ((wholeDegrees > 180) || (minutes >= 60000000)) {
+    return false;
+  }
+
+  // 1 minute = 1/60 degree, so minutes x 10^6 / 6 = degrees x 10^7.
+  int32_t result = (int32_t) ((wholeDegrees * 10000000) + ((minutes + 3) / 6));
+
+  switch (hemisphere.data [0]) {
+    case 'N':
+    case 'E':
+      break;
+
+    case 'S':
+    case 'W':
+      result = -result;
+      break;
+
+    default:
+      return false;
+  }
+
+  degrees = result;
+  return true;
+}
+
+//======================================================================================//
+/**
+ * @brief Converts an NMEA time in "hhmmss.sss" format to milliseconds since midnight. Up to
+ * 3 decimal digits of the seconds are used.
+ *
+ * @param field The time field.
+ * @param time The converted time in milliseconds.
+ * @return true The conversion was successful.
+ * @return false The field is empty or invalid.
+ */
+bool NMEA_Decoder:: decodeTime (NMEA_Field field, uint32_t& time) {
+  const char* p = field.data;
+
+  if (field.length < 6) {
+    return false;
+  }
+
+  for (uint8_t i = 0; i < 6; i++) {
+    if (!isDigitChar (p [i])) {
+      return false;
+    }
+  }
+
+  uint32_t hours = ((p [0] - '0') * 10) + (p [1] - '0');
+  uint32_t minutes = ((p [2] - '0') * 10) + (p [3] - '0');
+  uint32_t seconds = ((p [4] - '0') * 10) + (p [5] - '0');
+  uint32_t milliseconds = 0;
+
+  if ((hours > 23) || (minutes > 59) || (seconds > 60)) { // 60 is a leap second
+    return false;
+  }
+
+  if (field.length > 6) {
+    if (p [6] != '.') {
+      return false;
+    }
+
+    uint32_t scale = 100;
+
+    for (uint8_t i = 7; i < field.length; i++) {
+      if (!isDigitChar (p [i])) {
+        return false;
+      }
+
+      milliseconds += (p [i] - '0') * scale;
+      scale /= 10;
+    }
+  }
+
+  time = (((hours * 60) + minutes) * 60 + seconds) * 1000 + milliseconds;
+  return true;
+}
+
+//======================================================================================//
+/**
+ * @brief Returns the number of days since 01-01-1970 for the given date in the Gregorian
+ * calendar. Uses the integer algorithm by Howard Hinnant.
+ *
+ * @param year The full year. eg. 2024.
+ * @param month The month from 1 to 12.
+ * @param day The day from 1 to 31.
+ * @return int32_t The number of days since 01-01-1970.
+ */
+int32_t NMEA_Decoder:: getDaysFromCivil (int32_t year, uint8_t month, uint8_t day) {
+  year -= (month <= 2) ? 1 : 0;
+
+  int32_t era = ((year >= 0) ? year : (year - 399)) / 400;
+  uint32_t yearOfEra = (uint32_t) (year - (era * 400));
+  uint32_t dayOfYear = ((153 * ((month > 2) ? (month - 3) : (month + 9))) + 2) / 5 + day - 1;
+  uint32_t dayOfEra = (yearOfEra * 365) + (yearOfEra / 4) - (yearOfEra / 100) + dayOfYear;
+
+  return (era * 146097) + (int32_t) dayOfEra - 719468;
+}
+
+//======================================================================================//
+/**
+ * @brief Converts an NMEA date in "ddmmyy" format to days since 01-01-1970. The years 80 to
+ * 99 are taken as 1980 to 1999, and the rest as 2000 to 2079.
+ *
+ * @param field The date field.
+ * @param date The converted date.
+ * @return true The conversion was successful.
+ * @return false The field is empty or invalid.
+ */
+bool NMEA_Decoder:: decodeDate (NMEA_Field field, uint16_t& date) {
+  const char* p = field.data;
+
+  if (field.length != 6) {
+    return false;
+  }
+
+  for (uint8_t i = 0; i < 6; i++) {
+    if (!isDigitChar (p [i])) {
+      return false;
+    }
+  }
+
+  uint8_t day = ((p [0] - '0') * 10) + (p [1] - '0');
+  uint8_t month = ((p [2] - '0') * 10) + (p [3] - '0');
+  int32_t year = ((p [4] - '0') * 10) + (p [5] - '0');
+
+  if ((day < 1) || (day > 31) || (month < 1) || (month > 12)) {
+    return false;
+  }
+
+  year += (year >= 80) ? 1900 : 2000;
+  date = (uint16_t) getDaysFromCivil (year, month, day);
+  return true;
+}
+
+//======================================================================================//
+/**
+ * @brief Converts the separate day, month and year fields of the ZDA sentence to days
+ * since 01-01-1970.
+ *
+ * @param day The day field.
+ * @param month The month field.
+ * @param year The four digit year field.
+ * @param date The converted date.
+ * @return true The conversion was successful.
+ * @return false The fields are empty or invalid.
+ */
+bool NMEA_Decoder:: decodeDate (NMEA_Field day, NMEA_Field month, NMEA_Field year, uint16_t& date) {
+  int32_t dayValue, monthValue, yearValue;
+
+  if (!decodeFixed (day, 0, dayValue) || !decodeFixed (month, 0, monthValue) || !decodeFixed (year, 0, yearValue)) {
+    return false;
+  }
+
+  if ((dayValue < 1) || (dayValue > 31) || (monthValue < 1) || (monthValue > 12) || (yearValue < 1970) || (yearValue > 2149)) {
+    return false;
+  }
+
+  date = (uint16_t) getDaysFromCivil (yearValue, monthValue, dayValue);
+  return true;
+}
+
+//======================================================================================//
+/**
+ * @brief Converts a speed in knots to millimetres per second.
+ *
+ * @param field The speed field in knots.
+ * @param speed The converted speed in mm/s.
+ * @return true The conversion was successful.
+ * @return false The field is empty, invalid or too large.
+ */
+bool NMEA_Decoder:: decodeSpeedKnots (NMEA_Field field, int32_t& speed) {
+  int32_t milliKnots;
+
+  if (!decodeFixed (field, 3, milliKnots) || (milliKnots > 4000000) || (milliKnots < -4000000)) {
+    return false;
+  }
+
+  // 1 knot = 1852 m/h = 1852/3600 m/s = 463/900 m/s
+  speed = ((milliKnots * 463) + ((milliKnots < 0) ? -450 : 450)) / 900;
+  return true;
+}
+
+//======================================================================================//
+/**
+ * @brief Converts a speed in km/h to millimetres per second.
+ *
+ * @param field The speed field in km/h.
+ * @param speed The converted speed in mm/s.
+ * @return true The conversion was successful.
+ * @return false The field is empty, invalid or too large.
+ */
+bool NMEA_Decoder:: decodeSpeedKmh (NMEA_Field field, int32_t& speed) {
+  int32_t metresPerHour;
+
+  if (!decodeFixed (field, 3, metresPerHour) || (metresPerHour > 400000000) || (metresPerHour < -400000000)) {
+    return false;
+  }
+
+  // 1 m/h = 1000/3600 mm/s = 5/18 mm/s
+  speed = ((metresPerHour * 5) + ((metresPerHour < 0) ? -9 : 9)) / 18;
+  return true;
+}
+
+//======================================================================================//
+/**
+ * @brief Converts a course in degrees to degrees x 100.
+ *
+ * @param field The course field in degrees.
+ * @param course The converted course.
+ * @return true The conversion was successful.
+ * @return false The field is empty or invalid.
+ */
+bool NMEA_Decoder:: decodeCourse (NMEA_Field field, uint16_t& course) {
+  int32_t value;
+
+  if (!decodeFixed (field, 2, value) || (value < 0) || (value > 36000)) {
+    return false;
+  }
+
+  course = (uint16_t) value;
+  return true;
+}
+
+//======================================================================================//
+/**
+ * @brief Decodes the RMC fields to the fix.
+ *
+ * @param data A parsed RMC sentence.
+ * @param fix The fix to update.
+ * @return true The sentence has been parsed.
+ * @return false No parsed sentence.
+ */
+bool NMEA_RMC:: decode (const NMEA_0183_Data& data, NMEA_Fix& fix) {
+  if (!data.isParsed()) {
+    return false;
+  }
+
+  if (data.getField (Status).equals ("A")) {
+    fix.flags |= NMEA_Fix::FLAG_VALID;
+  }
+  else {
+    fix.flags &= ~NMEA_Fix::FLAG_VALID;
+  }
+
+  if (NMEA_Decoder::decodeTime (data.getField (UTC), fix.time)) {
+    fix.flags |= NMEA_Fix::FLAG_TIME;
+  }
+
+  if (NMEA_Decoder::decodeCoordinate (data.getField (Latitude), data.getField (LatitudeDirection), fix.latitude) &&
+      NMEA_Decoder::decodeCoordinate (data.getField (Longitude), data.getField (LongitudeDirection), fix.longitude)) {
+    fix.flags |= NMEA_Fix::FLAG_POSITION;
+  }
+
+  if (NMEA_Decoder::decodeSpeedKnots (data.getField (Speed), fix.speed)) {
+    fix.flags |= NMEA_Fix::FLAG_SPEED;
+  }
+
+  if (NMEA_Decoder::decodeCourse (data.getField (Course), fix.course)) {
+    fix.flags |= NMEA_Fix::FLAG_COURSE;
+  }
+
+  if (NMEA_Decoder::decodeDate (data.getField (Date), fix.date)) {
+    fix.flags |= NMEA_Fix::FLAG_DATE;
+  }
+
+  return true;
+}
+
+//======================================================================================//
+/**
+ * @brief Decodes the GGA fields to the fix.
+ *
+ * @param data A parsed GGA sentence.
+ * @param fix The fix to update.
+ * @return true The sentence has been parsed.
+ * @return false No parsed sentence.
+ */
+bool NMEA_GGA:: decode (const NMEA_0183_Data& data, NMEA_Fix& fix) {
+  if (!data.isParsed()) {
+    return false;
+  }
+
+  if (NMEA_Decoder::decodeTime (data.getField (UTC), fix.time)) {
+    fix.flags |= NMEA_Fix::FLAG_TIME;
+  }
+
+  if (NMEA_Decoder::decodeCoordinate (data.getField (Latitude), data.getField (LatitudeDirection), fix.latitude) &&
+      NMEA_Decoder::decodeCoordinate (data.getField (Longitude), data.getField (LongitudeDirection), fix.longitude)) {
+    fix.flags |= NMEA_Fix::FLAG_POSITION;
+  }
+
+  if (NMEA_Decoder::decodeFixed (data.getField (Altitude), 3, fix.altitude)) {
+    fix.flags |= NMEA_Fix::FLAG_ALTITUDE;
+  }
+
+  int32_t quality, satellites, hdop;
+
+  if (NMEA_Decoder::decodeFixed (data.getField (Quality), 0, quality) &&
+      NMEA_Decoder::decodeFixed (data.getField (Satellites), 0, satellites)) {
+    fix.quality = (uint8_t) quality;
+    fix.satellites = (uint8_t) satellites;
+    fix.hdop = NMEA_Decoder::decodeFixed (data.getField (HDOP), 2, hdop) ? (uint16_t) hdop : 0xFFFF;
+    fix.flags |= NMEA_Fix::FLAG_QUALITY;
+
+    if (quality > 0) {
+      fix.flags |= NMEA_Fix::FLAG_VALID;
+    }
+    else {
+      fix.flags &= ~NMEA_Fix::FLAG_VALID;
+    }
+  }
+
+  return true;
+}
+
+//======================================================================================//
+/**
+ * @brief Decodes the VTG fields to the fix. The speed in knots is used if present, and
+ * the speed in km/h otherwise.
+ *
+ * @param data A parsed VTG sentence.
+ * @param fix The fix to update.
+ * @return true The sentence has been parsed.
+ * @return false No parsed sentence.
+ */
+bool NMEA_VTG:: decode (const NMEA_0183_Data& data, NMEA_Fix& fix) {
+  if (!data.isParsed()) {
+    return false;
+  }
+
+  if (NMEA_Decoder::decodeCourse (data.getField (CourseTrue), fix.course)) {
+    fix.flags |= NMEA_Fix::FLAG_COURSE;
+  }
+
+  if (NMEA_Decoder::decodeSpeedKnots (data.getField (SpeedKnots), fix.speed) ||
+      NMEA_Decoder::decodeSpeedKmh (data.getField (SpeedKmh), fix.speed)) {
+    fix.flags |= NMEA_Fix::FLAG_SPEED;
+  }
+
+  return true;
+}
+
+//======================================================================================//
+/**
+ * @brief Decodes the GLL fields to the fix.
+ *
+ * @param data A parsed GLL sentence.
+ * @param fix The fix to update.
+ * @return true The sentence has been parsed.
+ * @return false No parsed sentence.
+ */
+bool NMEA_GLL:: decode (const NMEA_0183_Data& data, NMEA_Fix& fix) {
+  if (!data.isParsed()) {
+    return false;
+  }
+
+  if (data.getField (Status).equals ("A")) {
+    fix.flags |= NMEA_Fix::FLAG_VALID;
+  }
+  else {
+    fix.flags &= ~NMEA_Fix::FLAG_VALID;
+  }
+
+  if (NMEA_Decoder::decodeTime (data.getField (UTC), fix.time)) {
+    fix.flags |= NMEA_Fix::FLAG_TIME;
+  }
+
+  if (NMEA_Decoder::decodeCoordinate (data.getField (Latitude), data.getField (LatitudeDirection), fix.latitude) &&
+      NMEA_Decoder::decodeCoordinate (data.getField (Longitude), data.getField (LongitudeDirection), fix.longitude)) {
+    fix.flags |= NMEA_Fix::FLAG_POSITION;
+  }
+
+  return true;
+}
+
+//======================================================================================//
+/**
+ * @brief Decodes the ZDA fields to the fix.
+ *
+ * @param data A parsed ZDA sentence.
+ * @param fix The fix to update.
+ * @return true The sentence has been parsed.
+ * @return false No parsed sentence.
+ */
+bool NMEA_ZDA:: decode (const NMEA_0183_Data& data, NMEA_Fix& fix) {
+  if (!data.isParsed()) {
+    return false;
+  }
+
+  if (NMEA_Decoder::decodeTime (data.getField (UTC), fix.time)) {
+    fix.flags |= NMEA_Fix::FLAG_TIME;
+  }
+
+  if (NMEA_Decoder::decodeDate (data.getField (Day), data.getField (Month), data.getField (Year), fix.date)) {
+    fix.flags |= NMEA_Fix::FLAG_DATE;
+  }
+
+  return true;
+}
+
+//======================================================================================//
+/**
+ * @brief Decodes the GSA fields to the fix. The DOP values that are empty are set to
+ * 0xFFFF.
+ *
+ * @param data A parsed GSA sentence.
+ * @param fix The fix to update.
+ * @return true The sentence has been parsed.
+ * @return false No parsed sentence.
+ */
+bool NMEA_GSA:: decode (const NMEA_0183_Data& data, NMEA_Fix& fix) {
+  if (!data.isParsed()) {
+    return false;
+  }
+
+  int32_t fixType, dop;
+
+  if (NMEA_Decoder::decodeFixed (data.getField (FixType), 0, fixType)) {
+    fix.fixMode = (uint8_t) fixType;
+    fix.pdop = NMEA_Decoder::decodeFixed (data.getField (PDOP), 2, dop) ? (uint16_t) dop : 0xFFFF;
+    fix.hdop = NMEA_Decoder::decodeFixed (data.getField (HDOP), 2, dop) ? (uint16_t) dop : 0xFFFF;
+    fix.vdop = NMEA_Decoder::decodeFixed (data.getField (VDOP), 2, dop) ? (uint16_t) dop : 0xFFFF;
+    fix.flags |= NMEA_Fix::FLAG_DOP;
+  }
+
+  return true;
+}
+
+//======================================================================================//
+/**
+ * @brief Decodes the number of satellites in view from a GSV sentence to the fix.
+ *
+ * @param data A parsed GSV sentence.
+ * @param fix The fix to update.
+ * @return true The sentence has been parsed.
+ * @return false No parsed sentence.
+ */
+bool NMEA_GSV:: decode (const NMEA_0183_Data& data, NMEA_Fix& fix) {
+  if (!data.isParsed()) {
+    return false;
+  }
+
+  int32_t satellites;
+
+  if (NMEA_Decoder::decodeFixed (data.getField (SatellitesInView), 0, satellites)) {
+    fix.satellitesInView = (uint8_t) satellites;
+    fix.flags |= NMEA_Fix::FLAG_SATELLITES_IN_VIEW;
+  }
+
+  return true;
+}
+
+//======================================================================================//
+/**
+ * @brief Returns a GSV field by its schema index. The last sentence of a group can have
+ * fewer than 4 satellites, and NMEA 4.10 and later add the signal ID after the last one,
+ * so the satellites are counted from the number of fields, as NMEA_Satellite_Table::add()
+ * does. The fields of the missing satellites, and the SignalId of the sentences without
+ * one, are returned empty.
+ * 
+ * @param data The parsed GSV sentence.
+ * @param index The schema index, eg. NMEA_GSV::PRN3 or NMEA_GSV::SignalId.
+ * @return NMEA_Field The field view.
+ */
+NMEA_Field NMEA_GSV:: getField (const NMEA_0183_Data& data, uint8_t index) {
+  int fieldCount = data.getFieldCount();
+
+  if (index == Checksum) {
+    return data.getField (fieldCount - 1);
+  }
+
+  int satelliteFields = fieldCount - PRN1 - 1; // Without the checksum
+
+  if (satelliteFields < 0) {
+    satelliteFields = 0;
+  }
+
+  int satellites = satelliteFields / 4;
+
+  if (index == SignalId) {
+    return data.getField (((satelliteFields % 4) == 1) ? (PRN1 + (satellites * 4)) : -1);
+  }
+
+  // The header fields, and the satellites that are in the sentence.
+  if ((index < PRN1) ? (index < (fieldCount - 1)) : (index < (PRN1 + (satellites * 4)))) {
+    return data.getField (index);
+  }
+
+  return data.getField (-1);
+}
+
+//======================================================================================//
+/**
+ * @brief Constructs an epoch assembler with no published epoch.
+ * 
+ */
+NMEA_Epoch:: NMEA_Epoch() : working(), slots(), sequence (0), gsvTalkers (0), lastType(), pending (false),
+  handler (nullptr), handlerContext (nullptr), positionThreshold (0), handledLatitude (0), handledLongitude (0),
+  skippedCount (0), handledFlags (0), handledQuality (0), handled (false) {
+}
+
+//======================================================================================//
+/**
+ * @brief Adds a parsed sentence to the working epoch. RMC, GGA, GLL and ZDA carry the UTC
+ * time, and a time different from that of the working epoch publishes it first. GSA, GSV
+ * and VTG have no time and belong to the working epoch. The other sentences are ignored.
+ * The talker ID is not checked, so the sentences of all the constellations are merged.
+ * 
+ * @param data A parsed sentence.
+ */
+void NMEA_Epoch:: add (const NMEA_0183_Data& data) {
+  if (!data.isParsed()) {
+    return;
+  }
+
+  // The sentences set by the user may not start with a '$'.
+  uint16_t headerStart = ((data.sentenceLength > 0) && (data.sentence [0] == '$')) ? 1 : 0;
+
+  // Proprietary sentences have no standard type.
+  if ((data.sentenceLength < (headerStart + 5)) || (data.sentence [headerStart] == 'P')) {
+    return;
+  }
+
+  const char* type = data.sentence + headerStart + 2;
+  bool (*decode) (const NMEA_0183_Data&, NMEA_Fix&) = nullptr;
+  uint8_t utcIndex = 0; // 0 if the sentence has no time
+
+  if (memcmp (type, "RMC", 3) == 0) {
+    decode = NMEA_RMC::decode;
+    utcIndex = NMEA_RMC::UTC;
+  }
+  else if (memcmp (type, "GGA", 3) == 0) {
+    decode = NMEA_GGA::decode;
+    utcIndex = NMEA_GGA::UTC;
+  }
+  else if (memcmp (type, "GLL", 3) == 0) {
+    decode = NMEA_GLL::decode;
+    utcIndex = NMEA_GLL::UTC;
+  }
+  else if (memcmp (type, "ZDA", 3) == 0) {
+    decode = NMEA_ZDA::decode;
+    utcIndex = NMEA_ZDA::UTC;
+  }
+  else if (memcmp (type, "GSA", 3) == 0) {
+    decode = NMEA_GSA::decode;
+  }
+  else if (memcmp (type, "VTG", 3) == 0) {
+    decode = NMEA_VTG::decode;
+  }
+  else if (memcmp (type, "GSV", 3) != 0) {
+    return;
+  }
+
+  uint32_t time;
+
+  if ((utcIndex != 0) && (working.flags & NMEA_Fix::FLAG_TIME) &&
+      NMEA_Decoder::decodeTime (data.getField (utcIndex), time) && (time != working.time)) {
+    publish();
+  }
+
+  if (decode != nullptr) {
+    decode (data, working);
+  }
+  else {
+    // Each talker (constellation) has its own group of GSV sentences, and a receiver may send
+    // a group for each signal. The count of the first sentence of each talker is added once.
+    uint32_t talkerBit = 1UL << ((data.sentence [headerStart + 1] - 'A') & 31);
+    int32_t number, satellites;
+
+    if (((gsvTalkers & talkerBit) == 0) &&
+        NMEA_Decoder::decodeFixed (data.getField (NMEA_GSV::MessageNumber), 0, number) && (number == 1) &&
+        NMEA_Decoder::decodeFixed (data.getField (NMEA_GSV::SatellitesInView), 0, satellites)) {
+      working.satellitesInView += (uint8_t) satellites;
+      working.flags |= NMEA_Fix::FLAG_SATELLITES_IN_VIEW;
+      gsvTalkers |= talkerBit;
+    }
+  }
+
+  pending = true;
+
+  if ((lastType [0] != '\0') && (memcmp (type, lastType, 3) == 0)) {
+    publish();
+  }
+}
+
+//======================================================================================//
+/**
+ * @brief Publishes the working epoch and starts a new empty one. The epoch is copied to the
+ * slot that the readers are not using, and then the sequence is advanced. Does nothing if
+ * no sentence has been added since the last publish.
+ * 
+ */
+void NMEA_Epoch:: publish() {
+  if (!pending) {
+    return;
+  }
+
+  // 0 means that nothing is published, so it is skipped when the sequence wraps around.
+  NMEA_Ring_Index next = CSE_GNSS_RING_LOAD (sequence, relaxed) + 1;
+
+  if (next == 0) {
+    next = 2;
+  }
+
+  // A reader that sees any of the following writes will also see the previous sequence
+  // change, and retry.
+  CSE_GNSS_FENCE (release);
+  slots [next & 1] = working;
+  CSE_GNSS_RING_STORE (sequence, next, release);
+
+  if (handler != nullptr) {
+    if (isMoved (working)) {
+      handledLatitude = working.latitude;
+      handledLongitude = working.longitude;
+      handledFlags = working.flags & (NMEA_Fix::FLAG_VALID | NMEA_Fix::FLAG_POSITION);
+      handledQuality = working.quality;
+      handled = true;
+      handler (working, handlerContext);
+    }
+    else {
+      skippedCount++;
+    }
+  }
+
+  working = NMEA_Fix();
+  gsvTalkers = 0;
+  pending = false;
+}
+
+//======================================================================================//
+/**
+ * @brief Sets the sentence type that is sent last in each epoch by the receiver, such as
+ * "GGA" or "GLL". The epoch is then published as soon as that sentence is added, instead
+ * of when the next epoch starts. Use nullptr or "" to publish on the time change only.
+ * 
+ * @param type The three letter sentence type, without the talker ID.
+ */
+void NMEA_Epoch:: setLastSentence (const char* type) {
+  lastType [0] = '\0';
+
+  if ((type != nullptr) && (strlen (type) == 3)) {
+    memcpy (lastType, type, 4);
+  }
+}
+
+//======================================================================================//
+/**
+ * @brief Copies the latest published epoch. This can be called from any core or task,
+ * while another one is adding sentences. The copy is retried if an epoch was published
+ * while it was being copied, so the fields always belong to the same epoch.
+ * 
+ * @param fix The copy of the epoch.
+ * @return true The epoch has been copied.
+ * @return false No epoch has been published yet.
+ */
+bool NMEA_Epoch:: read (NMEA_Fix& fix) const {
+  NMEA_Ring_Index before, after;
+
+  do {
+    before = CSE_GNSS_RING_LOAD (sequence, acquire);
+
+    if (before == 0) {
+      return false;
+    }
+
+    fix = slots [before & 1];
+    CSE_GNSS_FENCE (acquire);
+    after = CSE_GNSS_RING_LOAD (sequence, relaxed);
+  } while (before != after);
+
+  return true;
+}
+
+//======================================================================================//
+/**
+ * @brief Returns the number of epochs published so far. A change in the value means that
+ * there is a new epoch to read(). The value is 0 only before the first epoch.
+ * 
+ * @return NMEA_Ring_Index The sequence number of the latest epoch.
+ */
+NMEA_Ring_Index NMEA_Epoch:: getSequence() const {
+  return CSE_GNSS_RING_LOAD (sequence, acquire);
+}
+
+//======================================================================================//
+/**
+ * @brief Sets a function that is called with each epoch as it is published, on the thread
+ * that adds the sentences. Use it to record every epoch instead of polling read().
+ * 
+ * @param handler The handler function. nullptr to remove.
+ * @param context A user pointer passed to the handler.
+ */
+void NMEA_Epoch:: setHandler (NMEA_Epoch_Handler handler, void* context) {
+  this->handler = handler;
+  handlerContext = context;
+}
+
+//======================================================================================//
+/**
+ * @brief Sets the distance that the position has to move from the last epoch passed to the
+ * handler before the handler is called again. The epochs of a stationary receiver are then
+ * skipped, except when the valid flag, the position flag or the quality changes. read()
+ * and getSequence() still get every epoch.
+ * 
+ * @param distance The distance in millimetres. 0 to call the handler for every epoch.
+ */
+void NMEA_Epoch:: setPositionThreshold (uint32_t distance) {
+  // Keeps the sum of the squares in isMoved() within 64 bits.
+  positionThreshold = (distance > 0x7FFFFFFFUL) ? 0x7FFFFFFFUL : distance;
+  handled = false;
+}
+
+//======================================================================================//
+/**
+ * @brief Checks if an epoch has to be passed to the handler. The distance from the last
+ * epoch passed is found on a flat projection, which is exact enough for the thresholds of
+ * up to a few kilometres, with integers only.
+ * 
+ * @param fix The epoch to check.
+ * @return true The epoch moved by more than the threshold, or its status changed.
+ * @return false The handler can skip the epoch.
+ */
+bool NMEA_Epoch:: isMoved (const NMEA_Fix& fix) const {
+  if ((positionThreshold == 0) || !handled) {
+    return true;
+  }
+
+  if (((fix.flags & (NMEA_Fix::FLAG_VALID | NMEA_Fix::FLAG_POSITION)) != handledFlags) || (fix.quality != handledQuality)) {
+    return true;
+  }
+
+  if ((fix.flags & NMEA_Fix::FLAG_POSITION) == 0) {
+    return false;
+  }
+
+  int64_t latitudeChange = (int64_t) fix.latitude - handledLatitude;
+  int64_t longitudeChange = (int64_t) fix.longitude - handledLongitude;
+
+  // The shorter way across the 180th meridian.
+  if (longitudeChange > 1800000000LL) {
+    longitudeChange -= 3600000000LL;
+  }
+  else if (longitudeChange < -1800000000LL) {
+    longitudeChange += 3600000000LL;
+  }
+
+  // A degree x 10^7 of latitude is 11.132 mm. A degree of longitude is shorter by the
+  // cosine of the latitude, which is approximated with Bhaskara's formula in degrees x 100,
+  // to within 0.2%, as a fraction of 65536.
+  int64_t latitude = ((fix.latitude < 0) ? -(int64_t) fix.latitude : fix.latitude) / 100000;
+  int64_t cosine = ((324000000LL - (4 * latitude * latitude)) * 65536) / (324000000LL + (latitude * latitude));
+  int64_t north = (latitudeChange * 11132) / 1000;
+  int64_t east = (longitudeChange * 11132 * cosine) / (1000LL * 65536);
+  int64_t threshold = positionThreshold;
+
+  if ((north > threshold) || (north < -threshold) || (east > threshold) || (east < -threshold)) {
+    return true;
+  }
+
+  return ((north * north) + (east * east)) > (threshold * threshold);
+}
+
+//======================================================================================//
+/**
+ * @brief Merges the values that are set in one fix into another. The values of the second
+ * fix replace those of the first, except the satellites in view, which are added. The
+ * valid flag is taken from the second fix if it has a position or a quality.
+ * 
+ * @param fix The fix to update.
+ * @param from The fix to merge.
+ */
+void NMEA_Epoch:: merge (NMEA_Fix& fix, const NMEA_Fix& from) {
+  if (from.flags & NMEA_Fix::FLAG_POSITION) {
+    fix.latitude = from.latitude;
+    fix.longitude = from.longitude;
+  }
+
+  if (from.flags & NMEA_Fix::FLAG_ALTITUDE) {
+    fix.altitude = from.altitude;
+  }
+
+  if (from.flags & NMEA_Fix::FLAG_TIME) {
+    fix.time = from.time;
+  }
+
+  if (from.flags & NMEA_Fix::FLAG_DATE) {
+    fix.date = from.date;
+  }
+
+  if (from.flags & NMEA_Fix::FLAG_SPEED) {
+    fix.speed = from.speed;
+  }
+
+  if (from.flags & NMEA_Fix::FLAG_COURSE) {
+    fix.course = from.course;
+  }
+
+  if (from.flags & NMEA_Fix::FLAG_QUALITY) {
+    fix.quality = from.quality;
+    fix.satellites = from.satellites;
+    fix.hdop = from.hdop;
+  }
+
+  if (from.flags & NMEA_Fix::FLAG_DOP) {
+    fix.fixMode = from.fixMode;
+    fix.pdop = from.pdop;
+    fix.hdop = from.hdop;
+    fix.vdop = from.vdop;
+  }
+
+  if (from.flags & NMEA_Fix::FLAG_SATELLITES_IN_VIEW) {
+    fix.satellitesInView = (fix.flags & NMEA_Fix::FLAG_SATELLITES_IN_VIEW) ? (fix.satellitesInView + from.satellitesInView) : from.satellitesInView;
+  }
+
+  if (from.flags & (NMEA_Fix::FLAG_POSITION | NMEA_Fix::FLAG_QUALITY)) {
+    fix.flags = (fix.flags & ~NMEA_Fix::FLAG_VALID) | (from.flags & NMEA_Fix::FLAG_VALID);
+  }
+
+  fix.flags |= from.flags & ~NMEA_Fix::FLAG_VALID;
+}
+
+//======================================================================================//
+/**
+ * @brief NMEA_Time_Sync constructor. The sync has no samples and a window of
+ * DefaultWindowLength samples.
+ * 
+ */
+NMEA_Time_Sync:: NMEA_Time_Sync() {
+  windowLength = DefaultWindowLength;
+  latency = 0;
+  reset();
+}
+
+//======================================================================================//
+/**
+ * @brief Removes all the samples. The window length and the latency are kept.
+ * 
+ */
+void NMEA_Time_Sync:: reset() {
+  anchorUtc = 0;
+  anchorTime = 0;
+  windowUtc = 0;
+  windowTime = 0;
+  windowCount = 0;
+  lastDelay = 0;
+  maxDelay = 0;
+  sampleCount = 0;
+}
+
+//======================================================================================//
+/**
+ * @brief Sets the number of samples after which the least delayed sample of the window
+ * becomes the anchor. A short window follows the drift of the clock faster, and a long
+ * window is more likely to have a sample that was not delayed.
+ * 
+ * @param length The number of samples. At least 1.
+ */
+void NMEA_Time_Sync:: setWindowLength (uint8_t length) {
+  windowLength = (length == 0) ? 1 : length;
+}
+
+//======================================================================================//
+/**
+ * @brief Returns the difference of two UTC times of the day, taking the shorter way around
+ * midnight.
+ * 
+ * @param utcTime The UTC time in milliseconds since midnight.
+ * @param fromUtc The UTC time to subtract.
+ * @return int32_t The difference in milliseconds, from -12 hours to 12 hours.
+ */
+int32_t NMEA_Time_Sync:: getUtcDifference (uint32_t utcTime, uint32_t fromUtc) {
+  const int32_t day = 86400000;
+  int32_t difference = (int32_t) utcTime - (int32_t) fromUtc;
+
+  if (difference < -(day / 2)) {
+    difference += day;
+  }
+  else if (difference >= (day / 2)) {
+    difference -= day;
+  }
+
+  return difference;
+}
+
+//======================================================================================//
+/**
+ * @brief Returns how much later a sample arrived than another, after their difference in
+ * UTC time is taken out. The samples must be within MaxUtcDifference of each other.
+ * 
+ * @param utcTime The UTC time of the sample in milliseconds since midnight.
+ * @param arrivalTime The arrival time of the sample in microseconds.
+ * @param fromUtc The UTC time of the other sample.
+ * @param fromTime The arrival time of the other sample.
+ * @return int32_t The delay in microseconds. Negative if the sample arrived sooner.
+ */
+int32_t NMEA_Time_Sync:: getRelativeDelay (uint32_t utcTime, uint32_t arrivalTime, uint32_t fromUtc, uint32_t fromTime) {
+  return (int32_t) (arrivalTime - fromTime) - (getUtcDifference (utcTime, fromUtc) * 1000);
+}
+
+//======================================================================================//
+/**
+ * @brief Adds the UTC time and the arrival time of a sentence. A sentence that arrived
+ * with less delay than the anchor replaces it at once. At the end of each window, the
+ * least delayed sample of the window becomes the anchor, so that the anchor follows the
+ * drift of the clock. A sample more than MaxUtcDifference away from the anchor, eg. after
+ * the signal was lost, starts again from it.
+ * 
+ * @param utcTime The UTC time of the sentence in milliseconds since midnight.
+ * @param arrivalTime The clock time when the '$' of the sentence arrived, in microseconds.
+ */
+void NMEA_Time_Sync:: add (uint32_t utcTime, uint32_t arrivalTime) {
+  int32_t utcDifference = getUtcDifference (utcTime, anchorUtc);
+
+  if ((sampleCount == 0) || (utcDifference > MaxUtcDifference) || (utcDifference < -MaxUtcDifference)) {
+    anchorUtc = utcTime;
+    anchorTime = arrivalTime;
+    windowCount = 0;
+  }
+
+  int32_t delay = getRelativeDelay (utcTime, arrivalTime, anchorUtc, anchorTime);
+
+  if (delay < 0) {
+    anchorUtc = utcTime;
+    anchorTime = arrivalTime;
+    delay = 0;
+  }
+
+  if ((windowCount == 0) || (getRelativeDelay (utcTime, arrivalTime, windowUtc, windowTime) < 0)) {
+    windowUtc = utcTime;
+    windowTime = arrivalTime;
+  }
+
+  lastDelay = (uint32_t) delay;
+
+  if (lastDelay > maxDelay) {
+    maxDelay = lastDelay;
+  }
+
+  sampleCount++;
+
+  if (++windowCount >= windowLength) {
+    anchorUtc = windowUtc;
+    anchorTime = windowTime;
+    windowCount = 0;
+  }
+}
+
+//======================================================================================//
+/**
+ * @brief Returns the offset between the arrival clock and UTC, as the arrival time of the
+ * anchor minus its UTC time of the day in microseconds. Both wrap at 2^32 microseconds,
+ * so only the differences between the offsets are meaningful, eg. to see the drift of the
+ * clock.
+ * 
+ * @return uint32_t The offset in microseconds. 0 if no sample has been added.
+ */
+uint32_t NMEA_Time_Sync:: getOffset() const {
+  if (sampleCount == 0) {
+    return 0;
+  }
+
+  return anchorTime - (anchorUtc * 1000);
+}
+
+//======================================================================================//
+/**
+ * @brief Returns the delay of the anchor from a reference whose UTC time is known, stamped
+ * with the same clock. With the rising edge of a PPS signal as the reference, this is the
+ * fixed delay from the start of the UTC second to the arrival of the first sentence,
+ * through the receiver and the port.
+ * 
+ * @param referenceUtc The UTC time of the reference in milliseconds since midnight, eg.
+ * the second marked by the PPS edge.
+ * @param referenceTime The clock time of the reference in microseconds.
+ * @return int32_t The delay in microseconds. 0 if no sample has been added.
+ */
+int32_t NMEA_Time_Sync:: getLatency (uint32_t referenceUtc, uint32_t referenceTime) const {
+  if (sampleCount == 0) {
+    return 0;
+  }
+
+  return getRelativeDelay (anchorUtc, anchorTime, referenceUtc, referenceTime);
+}
+
+//======================================================================================//
+/**
+ * @brief Sets the delay of the anchor from UTC, which toUtc() adds to the converted times.
+ * It can be measured with getLatency(). It is 0 by default, so the times from toUtc() are
+ * behind UTC by the delay of the receiver and the port.
+ * 
+ * @param latency The delay in microseconds.
+ */
+void NMEA_Time_Sync:: setLatency (int32_t latency) {
+  this->latency = latency;
+}
+
+//======================================================================================//
+/**
+ * @brief Converts a time of the arrival clock to UTC, eg. the time of a sample of another
+ * sensor. The time must be within about 35 minutes of the anchor.
+ * 
+ * @param time The clock time in microseconds.
+ * @param utcTime Gets the UTC time in milliseconds since midnight.
+ * @param microseconds Gets the microseconds after the millisecond, from 0 to 999. Can be
+ * nullptr.
+ * @return true The time was converted.
+ * @return false No sample has been added yet.
+ */
+bool NMEA_Time_Sync:: toUtc (uint32_t time, uint32_t& utcTime, uint16_t* microseconds) const {
+  if (sampleCount == 0) {
+    return false;
+  }
+
+  const int32_t day = 86400000;
+  int32_t elapsed = (int32_t) (time - anchorTime) + latency;
+  int32_t milliseconds = elapsed / 1000;
+  int32_t remainder = elapsed % 1000;
+
+  if (remainder < 0) {
+    remainder += 1000;
+    milliseconds--;
+  }
+
+  int32_t utc = (int32_t) anchorUtc + milliseconds;
+
+  if (utc < 0) {
+    utc += day;
+  }
+  else if (utc >= day) {
+    utc -= day;
+  }
+
+  utcTime = (uint32_t) utc;
+
+  if (microseconds != nullptr) {
+    *microseconds = (uint16_t) remainder;
+  }
+
+  return true;
+}
+
+//======================================================================================//
+/**
+ * @brief Constructs an empty satellite table.
+ * 
+ */
+NMEA_Satellite_Table:: NMEA_Satellite_Table() {
+  clear();
+}
+
+//======================================================================================//
+/**
+ * @brief Removes all the satellites and the statistics, and drops the group being collected.
+ * 
+ */
+void NMEA_Satellite_Table:: clear() {
+  count = 0;
+  commitCount = 0;
+  groupCount = 0;
+  groupSystem = 0;
+  groupSignal = 0;
+  groupParts = 0;
+  groupNext = 0;
+
+  for (uint8_t i = 0; i < SYSTEM_COUNT; i++) {
+    stats [i] = NMEA_Snr_Stats();
+  }
+}
+
+//======================================================================================//
+/**
+ * @brief Adds a parsed GSV sentence to the group being collected. The first sentence of a
+ * group starts a new one, and the last sentence commits it to the table. A sentence that
+ * is out of order drops the group. Other sentence types and talkers are ignored.
+ * 
+ * @param data A parsed sentence.
+ * @return true The sentence has been added to the group.
+ * @return false The sentence is not a GSV of a known talker, or it is out of order.
+ */
+bool NMEA_Satellite_Table:: add (const NMEA_0183_Data& data) {
+  if (!data.isParsed()) {
+    return false;
+  }
+
+  // The sentences set by the user may not start with a '$'.
+  uint16_t headerStart = ((data.sentenceLength > 0) && (data.sentence [0] == '$')) ? 1 : 0;
+
+  if ((data.sentenceLength < (headerStart + 5)) || (memcmp (data.sentence + headerStart + 2, "GSV", 3) != 0)) {
+    return false;
+  }
+
+  int8_t system = getSystem (data.sentence + headerStart);
+
+  if (system < 0) {
+    return false;
+  }
+
+  int32_t parts, number;
+
+  if (!NMEA_Decoder::decodeFixed (data.getField (NMEA_GSV::MessageCount), 0, parts) ||
+      !NMEA_Decoder::decodeFixed (data.getField (NMEA_GSV::MessageNumber), 0, number) ||
+      (parts < 1) || (parts > 255) || (number < 1) || (number > parts)) {
+    groupNext = 0;
+    return false;
+  }
+
+  // Each satellite has four fields. NMEA 4.10 and later add the signal ID after the last
+  // satellite, so the number of satellites is found from the number of fields.
+  int satelliteFields = data.getFieldCount() - NMEA_GSV::PRN1 - 1; // Without the checksum
+
+  if (satelliteFields < 0) {
+    satelliteFields = 0;
+  }
+
+  uint8_t satellites = satelliteFields / 4;
+  uint8_t signal = 0;
+  int32_t value;
+
+  if (((satelliteFields % 4) == 1) && NMEA_Decoder::decodeFixed (data.getField (NMEA_GSV::PRN1 + (satellites * 4)), 0, value)) {
+    signal = (uint8_t) value;
+  }
+
+  if (number == 1) {
+    groupSystem = system;
+    groupSignal = signal;
+    groupParts = parts;
+    groupCount = 0;
+    groupNext = 1;
+  }
+
+  if ((number != groupNext) || (system != groupSystem) || (signal != groupSignal) || (parts != groupParts)) {
+    groupNext = 0;
+    return false;
+  }
+
+  for (uint8_t i = 0; (i < satellites) && (groupCount < CONST_MAX_SATELLITES); i++) {
+    uint8_t field = NMEA_GSV::PRN1 + (i * 4);
+
+    if (!NMEA_Decoder::decodeFixed (data.getField (field), 0, value)) {
+      continue;
+    }
+
+    groupPrns [groupCount] = (uint16_t) value;
+    groupElevations [groupCount] = NMEA_Decoder::decodeFixed (data.getField (field + 1), 0, value) ? (int8_t) value : -128;
+    groupAzimuths [groupCount] = NMEA_Decoder::decodeFixed (data.getField (field + 2), 0, value) ? (uint16_t) value : 0xFFFF;
+    groupSnrs [groupCount] = NMEA_Decoder::decodeFixed (data.getField (field + 3), 0, value) ? (uint8_t) value : 0;
+    groupCount++;
+  }
+
+  groupNext++;
+
+  if (number == parts) {
+    commit();
+    groupNext = 0;
+  }
+
+  return true;
+}
+
+//======================================================================================//
+/**
+ * @brief Replaces the satellites of the same system and signal as the collected group with
+ * the satellites of the group, and updates the SNR statistics of the system.
+ * 
+ */
+void NMEA_Satellite_Table:: commit() {
+  uint8_t kept = 0;
+
+  // The satellites of the other groups are moved down over the replaced ones.
+  for (uint8_t i = 0; i < count; i++) {
+    if ((systems [i] == groupSystem) && (signals [i] == groupSignal)) {
+      continue;
+    }
+
+    if (kept != i) {
+      prns [kept] = prns [i];
+      elevations [kept] = elevations [i];
+      azimuths [kept] = azimuths [i];
+      snrs [kept] = snrs [i];
+      systems [kept] = systems [i];
+      signals [kept] = signals [i];
+    }
+
+    kept++;
+  }
+
+  count = kept;
+
+  for (uint8_t i = 0; (i < groupCount) && (count < CONST_MAX_SATELLITES); i++) {
+    prns [count] = groupPrns [i];
+    elevations [count] = groupElevations [i];
+    azimuths [count] = groupAzimuths [i];
+    snrs [count] = groupSnrs [i];
+    systems [count] = groupSystem;
+    signals [count] = groupSignal;
+    count++;
+  }
+
+  NMEA_Snr_Stats& systemStats = stats [groupSystem];
+  uint16_t snrSum = 0;
+
+  systemStats = NMEA_Snr_Stats();
+
+  for (uint8_t i = 0; i < count; i++) {
+    if (systems [i] != groupSystem) {
+      continue;
+    }
+
+    systemStats.inView++;
+
+    if (snrs [i] == 0) {
+      continue;
+    }
+
+    if ((systemStats.tracked == 0) || (snrs [i] < systemStats.minSnr)) {
+      systemStats.minSnr = snrs [i];
+    }
+
+    if (snrs [i] > systemStats.maxSnr) {
+      systemStats.maxSnr = snrs [i];
+    }
+
+    snrSum += snrs [i];
+    systemStats.tracked++;
+  }
+
+  if (systemStats.tracked > 0) {
+    systemStats.meanSnr = (uint8_t) ((snrSum + (systemStats.tracked / 2)) / systemStats.tracked);
+  }
+
+  commitCount++;
+}
+
+//======================================================================================//
+/**
+ * @brief Returns the SNR statistics of a system, as of its last committed group. When a
+ * receiver sends a group for each signal, a satellite is counted once for each signal.
+ * 
+ * @param system One of the System values.
+ * @return const NMEA_Snr_Stats& The statistics. All 0 if the system is not valid.
+ */
+const NMEA_Snr_Stats& NMEA_Satellite_Table:: getSnrStats (uint8_t system) const {
+  static const NMEA_Snr_Stats noStats = {};
+
+  if (system >= SYSTEM_COUNT) {
+    return noStats;
+  }
+
+  return stats [system];
+}
+
+//======================================================================================//
+/**
+ * @brief Returns the system of a talker ID.
+ * 
+ * @param talker The two talker ID characters, eg. "GP".
+ * @return int8_t One of the System values. -1 if the talker is not a known GNSS.
+ */
+int8_t NMEA_Satellite_Table:: getSystem (const char* talker) {
+  if (talker [0] == 'G') {
+    switch (talker [1]) {
+      case 'P': return SYSTEM_GPS;
+      case 'L': return SYSTEM_GLONASS;
+      case 'A': return SYSTEM_GALILEO;
+      case 'B': return SYSTEM_BEIDOU;
+      case 'Q': return SYSTEM_QZSS;
+    }
+  }
+  else if ((talker [0] == 'B') && (talker [1] == 'D')) {
+    return SYSTEM_BEIDOU;
+  }
+  else if ((talker [0] == 'Q') && (talker [1] == 'Z')) {
+    return SYSTEM_QZSS;
+  }
+
+  return -1;
+}
+
+//======================================================================================//
+/**
+ * @brief Computes the CRC-16/CCITT (polynomial 0x1021) of the bytes.
+ * 
+ * @param data The bytes.
+ * @param length The number of bytes.
+ * @param crc The initial value, or the CRC of the previous bytes to continue it.
+ * @return uint16_t The CRC.
+ */
+uint16_t NMEA_Record:: computeCrc (const uint8_t* data, size_t length, uint16_t crc) {
+  for (size_t i = 0; i < length; i++) {
+    crc ^= (uint16_t) data [i] << 8;
+
+    for (uint8_t bit = 0; bit < 8; bit++) {
+      crc = (crc & 0x8000) ? ((crc << 1) ^ 0x1021) : (crc << 1);
+    }
+  }
+
+  return crc;
+}
+
+//======================================================================================//
+/**
+ * @brief Checks if the flags of a fix mark a record field as set.
+ * 
+ * @param flags The NMEA_Fix flags.
+ * @param field One of the Field values.
+ * @return true The field is set.
+ * @return false The field is not set.
+ */
+bool NMEA_Record:: hasField (uint16_t flags, uint8_t field) {
+  static const uint16_t fieldFlags [FieldCount] = {
+    NMEA_Fix::FLAG_POSITION, NMEA_Fix::FLAG_POSITION, NMEA_Fix::FLAG_ALTITUDE, NMEA_Fix::FLAG_TIME,
+    NMEA_Fix::FLAG_SPEED, NMEA_Fix::FLAG_DATE, NMEA_Fix::FLAG_COURSE, NMEA_Fix::FLAG_QUALITY | NMEA_Fix::FLAG_DOP,
+    NMEA_Fix::FLAG_DOP, NMEA_Fix::FLAG_DOP, NMEA_Fix::FLAG_QUALITY, NMEA_Fix::FLAG_QUALITY,
+    NMEA_Fix::FLAG_DOP, NMEA_Fix::FLAG_SATELLITES_IN_VIEW
+  };
+
+  return (field < FieldCount) && ((flags & fieldFlags [field]) != 0);
+}
+
+//======================================================================================//
+/**
+ * @brief Returns a field of a fix as a 32-bit value. The signed fields are returned in
+ * two's complement.
+ * 
+ * @param fix The fix.
+ * @param field One of the Field values.
+ * @return uint32_t The value. 0 if the field is not valid.
+ */
+uint32_t NMEA_Record:: getField (const NMEA_Fix& fix, uint8_t field) {
+  switch (field) {
+    case Latitude: return (uint32_t) fix.latitude;
+    case Longitude: return (uint32_t) fix.longitude;
+    case Altitude: return (uint32_t) fix.altitude;
+    case Time: return fix.time;
+    case Speed: return (uint32_t) fix.speed;
+    case Date: return fix.date;
+    case Course: return fix.course;
+    case HDOP: return fix.hdop;
+    case PDOP: return fix.pdop;
+    case VDOP: return fix.vdop;
+    case Quality: return fix.quality;
+    case Satellites: return fix.satellites;
+    case FixMode: return fix.fixMode;
+    case SatellitesInView: return fix.satellitesInView;
+  }
+
+  return 0;
+}
+
+//======================================================================================//
+/**
+ * @brief Sets a field of a fix from a 32-bit value. The value is truncated to the size of
+ * the field.
+ * 
+ * @param fix The fix.
+ * @param field One of the Field values.
+ * @param value The value.
+ */
+void NMEA_Record:: setField (NMEA_Fix& fix, uint8_t field, uint32_t value) {
+  switch (field) {
+    case Latitude: fix.latitude = (int32_t) value; break;
+    case Longitude: fix.longitude = (int32_t) value; break;
+    case Altitude: fix.altitude = (int32_t) value; break;
+    case Time: fix.time = value; break;
+    case Speed: fix.speed = (int32_t) value; break;
+    case Date: fix.date = (uint16_t) value; break;
+    case Course: fix.course = (uint16_t) value; break;
+    case HDOP: fix.hdop = (uint16_t) value; break;
+    case PDOP: fix.pdop = (uint16_t) value; break;
+    case VDOP: fix.vdop = (uint16_t) value; break;
+    case Quality: fix.quality = (uint8_t) value; break;
+    case Satellites: fix.satellites = (uint8_t) value; break;
+    case FixMode: fix.fixMode = (uint8_t) value; break;
+    case SatellitesInView: fix.satellitesInView = (uint8_t) value; break;
+  }
+}
+
+//======================================================================================//
+/**
+ * @brief Writes a value as a varint, 7 bits per byte with the high bit set on all the
+ * bytes but the last.
+ * 
+ * @param buffer The buffer to write to. Advanced past the varint.
+ * @param value The value.
+ */
+static inline void writeVarint (uint8_t*& buffer, uint32_t value) {
+  while (value >= 0x80) {
+    *buffer++ = (uint8_t) (value | 0x80);
+    value >>= 7;
+  }
+
+  *buffer++ = (uint8_t) value;
+}
+
+//======================================================================================//
+/**
+ * @brief Reads a varint written by writeVarint().
+ * 
+ * @param data The buffer to read from. Advanced past the varint.
+ * @param end The end of the buffer.
+ * @param value The value read.
+ * @return true The varint was read.
+ * @return false The buffer ended or the varint is longer than 5 bytes.
+ */
+static inline bool readVarint (const uint8_t*& data, const uint8_t* end, uint32_t& value) {
+  value = 0;
+
+  for (uint8_t shift = 0; shift < 35; shift += 7) {
+    if (data >= end) {
+      return false;
+    }
+
+    uint8_t c = *data++;
+    value |= (uint32_t) (c & 0x7F) << shift;
+
+    if ((c & 0x80) == 0) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+//======================================================================================//
+/**
+ * @brief Constructs a record writer. The first record is a key record.
+ * 
+ * @param keyInterval The number of records between the key records. 0 to write only the
+ * first record as a key record.
+ */
+NMEA_Record_Writer:: NMEA_Record_Writer (uint16_t keyInterval) : keyInterval (keyInterval) {
+  reset();
+}
+
+//======================================================================================//
+/**
+ * @brief Makes the next record a key record. Call this when starting a new log file, or
+ * when the previous records may not reach the reader.
+ * 
+ */
+void NMEA_Record_Writer:: reset() {
+  keyPending = true;
+  recordsSinceKey = 0;
+}
+
+//======================================================================================//
+/**
+ * @brief Sets the number of records between the key records. A smaller interval lets a
+ * reader recover sooner after a lost record, at the cost of larger records.
+ * 
+ * @param interval The number of records. 0 to write only the first record as a key record.
+ */
+void NMEA_Record_Writer:: setKeyInterval (uint16_t interval) {
+  keyInterval = interval;
+}
+
+//======================================================================================//
+/**
+ * @brief Encodes a fix to a record. Only the fields that the flags of the fix mark as set
+ * are written.
+ * 
+ * @param fix The fix to encode.
+ * @param buffer The buffer for the record. Must have at least NMEA_Record::MaxLength bytes.
+ * @return uint8_t The length of the record.
+ */
+uint8_t NMEA_Record_Writer:: encode (const NMEA_Fix& fix, uint8_t* buffer) {
+  bool key = keyPending || ((keyInterval > 0) && (recordsSinceKey >= keyInterval));
+
+  if (key) {
+    previous = NMEA_Fix();
+    recordsSinceKey = 0;
+    keyPending = false;
+  }
+
+  uint8_t* payload = buffer + 2;
+  uint8_t* end = payload;
+
+  writeVarint (end, fix.flags);
+
+  for (uint8_t i = 0; i < NMEA_Record::FieldCount; i++) {
+    if (!NMEA_Record::hasField (fix.flags, i)) {
+      continue;
+    }
+
+    uint32_t value = NMEA_Record::getField (fix, i);
+    int32_t delta = (int32_t) (value - NMEA_Record::getField (previous, i));
+
+    writeVarint (end, ((uint32_t) delta << 1) ^ (uint32_t) (delta >> 31)); // Zigzag
+    NMEA_Record::setField (previous, i, value);
+  }
+
+  uint8_t payloadLength = end - payload;
+
+  buffer [0] = NMEA_Record::Sync;
+  buffer [1] = (key ? NMEA_Record::KeyBit : 0) | payloadLength;
+
+  uint16_t crc = NMEA_Record::computeCrc (buffer + 1, payloadLength + 1);
+
+  *end++ = (uint8_t) (crc >> 8);
+  *end++ = (uint8_t) crc;
+  recordsSinceKey++;
+
+  return end - buffer;
+}
+
+//======================================================================================//
+/**
+ * @brief Constructs a record reader that waits for a key record.
+ * 
+ */
+NMEA_Record_Reader:: NMEA_Record_Reader() : fix(), handler (nullptr), handlerContext (nullptr), recordCount (0),
+  errorCount (0), skippedCount (0) {
+  reset();
+}
+
+//======================================================================================//
+/**
+ * @brief Discards any partial record. The delta records are dropped until the next key
+ * record.
+ * 
+ */
+void NMEA_Record_Reader:: reset() {
+  state = STATE_SYNC;
+  recordLength = 0;
+  synced = false;
+}
+
+//======================================================================================//
+/**
+ * @brief Sets a function that is called with each decoded fix.
+ * 
+ * @param handler The handler function. nullptr to remove.
+ * @param context A user pointer passed to the handler.
+ */
+void NMEA_Record_Reader:: setHandler (NMEA_Epoch_Handler handler, void* context) {
+  this->handler = handler;
+  handlerContext = context;
+}
+
+//======================================================================================//
+/**
+ * @brief Feeds a single byte of the record stream. If the byte ends a false record, the
+ * bytes after its sync are fed again, so a record that starts inside it is not lost.
+ * 
+ * @param c The byte.
+ * @return true A record was completed and decoded to the fix.
+ * @return false More bytes are needed, or the record was dropped.
+ */
+bool NMEA_Record_Reader:: feed (uint8_t c) {
+  Step result = step (c);
+
+  if (result == STEP_FALSE_SYNC) {
+    return rescan() > 0;
+  }
+
+  return result == STEP_DECODED;
+}
+
+//======================================================================================//
+/**
+ * @brief Feeds a single byte to the state machine. The bytes after the sync are collected
+ * in the record buffer. A header with a payload longer than NMEA_Record::MaxPayloadLength,
+ * or a wrong CRC, means that the sync byte did not start a record, and the bytes are left
+ * in the record buffer for rescan().
+ * 
+ * @param c The byte.
+ * @return Step The result.
+ */
+NMEA_Record_Reader::Step NMEA_Record_Reader:: step (uint8_t c) {
+  switch (state) {
+    case STATE_SYNC:
+      if (c == NMEA_Record::Sync) {
+        recordLength = 0;
+        state = STATE_HEADER;
+      }
+      return STEP_NONE;
+
+    case STATE_HEADER:
+      record [recordLength++] = c;
+
+      if ((c & ~NMEA_Record::KeyBit) > NMEA_Record::MaxPayloadLength) {
+        state = STATE_SYNC;
+        return STEP_FALSE_SYNC;
+      }
+
+      state = ((c & ~NMEA_Record::KeyBit) == 0) ? STATE_CRC_1 : STATE_PAYLOAD;
+      return STEP_NONE;
+
+    case STATE_PAYLOAD:
+      record [recordLength++] = c;
+
+      if (recordLength == (1 + (record [0] & ~NMEA_Record::KeyBit))) {
+        state = STATE_CRC_1;
+      }
+      return STEP_NONE;
+
+    case STATE_CRC_1:
+      record [recordLength++] = c;
+      state = STATE_CRC_2;
+      return STEP_NONE;
+
+    case STATE_CRC_2:
+      record [recordLength++] = c;
+      state = STATE_SYNC;
+      break;
+  }
+
+  uint16_t receivedCrc = ((uint16_t) record [recordLength - 2] << 8) | record [recordLength - 1];
+
+  // The deltas after a lost record would be added to the wrong values.
+  if (NMEA_Record::computeCrc (record, recordLength - 2) != receivedCrc) {
+    errorCount++;
+    synced = false;
+    return STEP_FALSE_SYNC;
+  }
+
+  if (record [0] & NMEA_Record::KeyBit) {
+    previous = NMEA_Fix();
+    synced = true;
+  }
+  else if (!synced) {
+    skippedCount++;
+    return STEP_NONE;
+  }
+
+  if (!decodePayload()) {
+    errorCount++;
+    synced = false;
+    return STEP_NONE;
+  }
+
+  recordCount++;
+
+  if (handler != nullptr) {
+    handler (fix, handlerContext);
+  }
+
+  return STEP_DECODED;
+}
+
+//======================================================================================//
+/**
+ * @brief Feeds the bytes after a false sync again. A new record is collected from the
+ * start of the record buffer, always behind the byte being read. If it turns out to be
+ * false too, its bytes are moved in front of the ones not read yet, and the loop starts
+ * over, so there is no recursion.
+ * 
+ * @return uint8_t The number of records decoded.
+ */
+uint8_t NMEA_Record_Reader:: rescan() {
+  uint8_t decodeCount = 0;
+  uint8_t length = recordLength;
+  uint8_t position = 0;
+
+  while (position < length) {
+    Step result = step (record [position++]);
+
+    if (result == STEP_DECODED) {
+      decodeCount++;
+    }
+    else if (result == STEP_FALSE_SYNC) {
+      memmove (record + recordLength, record + position, length - position);
+      length = recordLength + (length - position);
+      position = 0;
+    }
+  }
+
+  return decodeCount;
+}
+
+//======================================================================================//
+/**
+ * @brief Feeds a chunk of the record stream. The handler is called for each decoded fix.
+ * 
+ * @param data The bytes.
+ * @param length The number of bytes.
+ * @return uint32_t The number of fixes decoded.
+ */
+uint32_t NMEA_Record_Reader:: feed (const uint8_t* data, size_t length) {
+  uint32_t decodeCount = 0;
+
+  for (size_t i = 0; i < length; i++) {
+    if (feed (data [i])) {
+      decodeCount++;
+    }
+  }
+
+  return decodeCount;
+}
+
+//======================================================================================//
+/**
+ * @brief Decodes the payload of a record with a valid CRC to the fix.
+ * 
+ * @return true The payload was decoded.
+ * @return false The payload is shorter than its flags require.
+ */
+bool NMEA_Record_Reader:: decodePayload() {
+  const uint8_t* data = record + 1;
+  const uint8_t* end = record + recordLength - 2;
+  uint32_t flags;
+
+  if (!readVarint (data, end, flags)) {
+    return false;
+  }
+
+  NMEA_Fix decoded = NMEA_Fix();
+  decoded.flags = (uint16_t) flags;
+
+  for (uint8_t i = 0; i < NMEA_Record::FieldCount; i++) {
+    if (!NMEA_Record::hasField (decoded.flags, i)) {
+      continue;
+    }
+
+    uint32_t zigzag;
+
+    if (!readVarint (data, end, zigzag)) {
+      return false;
+    }
+
+    uint32_t delta = (zigzag >> 1) ^ (0 - (zigzag & 1));
+    uint32_t value = NMEA_Record::getField (previous, i) + delta;
+
+    NMEA_Record::setField (previous, i, value);
+    NMEA_Record::setField (decoded, i, value);
+  }
+
+  fix = decoded;
+  return true;
+}
+
+//======================================================================================//
+/**
+ * @brief Constructs a command and starts it with the ID.
+ * 
+ * @param id The sentence ID without the '$', eg. "PMTK314".
+ */
+NMEA_Command:: NMEA_Command (const char* id) {
+  start (id);
+}
+
+//======================================================================================//
+/**
+ * @brief Discards the command and starts a new one with the ID.
+ * 
+ * @param id The sentence ID without the '$', eg. "PUBX".
+ */
+void NMEA_Command:: start (const char* id) {
+  buffer [0] = '$';
+  buffer [1] = 0;
+  length = 1;
+  overflow = false;
+  finished = false;
+  append (id, strlen (id));
+}
+
+//======================================================================================//
+/**
+ * @brief Appends the characters to the sentence. The room for the checksum is kept, and
+ * the characters that do not fit mark the command as overflowed.
+ * 
+ * @param data The characters.
+ * @param count The number of characters.
+ */
+void NMEA_Command:: append (const char* data, size_t count) {
+  if (finished || ((length + count + 3) > CONST_MAX_NMEA_SENTENCE_LENGTH)) {
+    overflow = true;
+    return;
+  }
+
+  memcpy (buffer + length, data, count);
+  length += count;
+  buffer [length] = 0;
+}
+
+//======================================================================================//
+/**
+ * @brief Adds a text field after a comma.
+ * 
+ * @param field The field. nullptr or "" for an empty field.
+ * @return NMEA_Command& The command, so that the calls can be chained.
+ */
+NMEA_Command& NMEA_Command:: add (const char* field) {
+  append (",", 1);
+
+  if (field != nullptr) {
+    append (field, strlen (field));
+  }
+
+  return *this;
+}
+
+//======================================================================================//
+/**
+ * @brief Adds a decimal field after a comma.
+ * 
+ * @param value The value.
+ * @return NMEA_Command& The command, so that the calls can be chained.
+ */
+NMEA_Command& NMEA_Command:: add (unsigned long value) {
+  char digits [12];
+  uint8_t position = sizeof (digits) - 1;
+
+  digits [position] = 0;
+
+  do {
+    digits [--position] = '0' + (value % 10);
+    value /= 10;
+  } while (value > 0);
+
+  return add (digits + position);
+}
+
+//======================================================================================//
+/**
+ * @brief Adds a signed decimal field after a comma.
+ * 
+ * @param value The value.
+ * @return NMEA_Command& The command, so that the calls can be chained.
+ */
+NMEA_Command& NMEA_Command:: add (long value) {
+  if (value >= 0) {
+    return add ((unsigned long) value);
+  }
+
+  append (",-", 2);
+  size_t start = length;
+  add (0UL - (unsigned long) value);
+
+  // Remove the comma that the unsigned add() put after the sign.
+  if (!overflow) {
+    memmove (buffer + start, buffer + start + 1, length - start);
+    length--;
+  }
+
+  return *this;
+}
+
+//======================================================================================//
+/**
+ * @brief Adds the '*', the checksum and the line ending. Nothing can be added after this.
+ * 
+ * @return true The command is complete.
+ * @return false A field did not fit in CONST_MAX_NMEA_SENTENCE_LENGTH.
+ */
+bool NMEA_Command:: finish() {
+  if (finished || overflow) {
+    return !overflow;
+  }
+
+  static const char hexDigits [] = "0123456789ABCDEF";
+  uint8_t checksum = NMEA_Framer::computeChecksum (buffer + 1, length - 1);
+
+  buffer [length++] = '*';
+  buffer [length++] = hexDigits [checksum >> 4];
+  buffer [length++] = hexDigits [checksum & 0x0F];
+  buffer [length++] = '\r';
+  buffer [length++] = '\n';
+  buffer [length] = 0;
+  finished = true;
+
+  return true;
+}
+
+//======================================================================================//
+/**
+ * @brief UBX_Framer constructor. The framer starts by waiting for the first sync character.
+ * 
+ */
+UBX_Framer:: UBX_Framer() {
+  frame.messageClass = 0;
+  frame.id = 0;
+  frame.length = 0;
+  frame.payload = frameBuffer + UBX_Frame::HeaderLength;
+  handler = nullptr;
+  handlerContext = nullptr;
+  frameCount = 0;
+  checksumErrorCount = 0;
+  oversizeCount = 0;
+  ackCount = 0;
+  ackClass = 0;
+  ackId = 0;
+  ackAccepted = false;
+  reset();
+}
+
+//======================================================================================//
+/**
+ * @brief Adds the bytes to an 8-bit Fletcher checksum, as used by UBX. Set both values to
+ * 0 before the first call. The checksum can be computed in several calls.
+ * 
+ * @param data The bytes.
+ * @param length The number of bytes.
+ * @param checksumA The running CK_A.
+ * @param checksumB The running CK_B.
+ */
+void UBX_Framer:: computeChecksum (const uint8_t* data, size_t length, uint8_t& checksumA, uint8_t& checksumB) {
+  for (size_t i = 0; i < length; i++) {
+    checksumA += data [i];
+    checksumB += checksumA;
+  }
+}
+
+//======================================================================================//
+/**
+ * @brief Sets the function to call when a complete frame is received.
+ * 
+ * @param handler The handler function. Can be nullptr.
+ * @param context A user pointer that will be passed to the handler.
+ */
+void UBX_Framer:: setHandler (UBX_Frame_Handler handler, void* context) {
+  this->handler = handler;
+  handlerContext = context;
+}
+
+//======================================================================================//
+/**
+ * @brief Discards any partial frame and waits for the next sync characters.
+ * 
+ */
+void UBX_Framer:: reset() {
+  state = STATE_SYNC_1;
+  payloadCount = 0;
+  checksumA = 0;
+  checksumB = 0;
+  rescanLength = 0;
+}
+
+//======================================================================================//
+/**
+ * @brief Counts a frame whose checksum matched, remembers the ACK and NAK frames and
+ * passes the frame to the handler. The frame is in the frame buffer.
+ * 
+ */
+void UBX_Framer:: complete() {
+  frameCount++;
+
+  if ((frame.messageClass == UBX_Ack::Class) && (frame.id <= UBX_Ack::IdAck) && (frame.length >= 2)) {
+    ackCount++;
+    ackClass = frame.payload [0];
+    ackId = frame.payload [1];
+    ackAccepted = (frame.id == UBX_Ack::IdAck);
+  }
+
+  if (handler != nullptr) {
+    handler (frame, handlerContext);
+  }
+}
+
+//======================================================================================//
+/**
+ * @brief Feeds a single byte to the framer. When the checksum of a frame matches, the ACK
+ * and NAK frames are remembered and the handler is called. If the frame is dropped, the
+ * bytes after its first sync character are fed again.
+ * 
+ * @param c The byte to feed.
+ * @return true A frame was completed by this byte.
+ * @return false No frame was completed.
+ */
+bool UBX_Framer:: feed (uint8_t c) {
+  if (step (c)) {
+    return true;
+  }
+
+  return (rescanLength > 0) && (rescan() > 0);
+}
+
+//======================================================================================//
+/**
+ * @brief Feeds a single byte to the state machine. The frame is collected in the frame
+ * buffer. When a frame is dropped for a wrong checksum or a length that does not fit, the
+ * number of bytes after its first sync character is saved in rescanLength, and the bytes
+ * are left in the frame buffer for the caller to feed again.
+ * 
+ * @param c The byte to feed.
+ * @return true A frame was completed by this byte.
+ * @return false No frame was completed.
+ */
+bool UBX_Framer:: step (uint8_t c) {
+  switch (state) {
+    case STATE_SYNC_1:
+      if (c == UBX_Frame::Sync1) {
+        frameBuffer [0] = c;
+        rescanLength = 0;
+        state = STATE_SYNC_2;
+      }
+      return false;
+
+    case STATE_SYNC_2:
+      if (c == UBX_Frame::Sync2) {
+        frameBuffer [1] = c;
+        state = STATE_CLASS;
+      }
+      else if (c != UBX_Frame::Sync1) {
+        state = STATE_SYNC_1;
+      }
+      return false;
+
+    case STATE_CLASS:
+      checksumA = 0;
+      checksumB = 0;
+      addChecksum (c);
+      frameBuffer [2] = c;
+      frame.messageClass = c;
+      state = STATE_ID;
+      return false;
+
+    case STATE_ID:
+      addChecksum (c);
+      frameBuffer [3] = c;
+      frame.id = c;
+      state = STATE_LENGTH_1;
+      return false;
+
+    case STATE_LENGTH_1:
+      addChecksum (c);
+      frameBuffer [4] = c;
+      frame.length = c;
+      state = STATE_LENGTH_2;
+      return false;
+
+    case STATE_LENGTH_2:
+      addChecksum (c);
+      frameBuffer [5] = c;
+      frame.length |= (uint16_t) c << 8;
+
+      if (frame.length > CONST_MAX_UBX_PAYLOAD_LENGTH) {
+        oversizeCount++;
+        reset();
+        rescanLength = UBX_Frame::HeaderLength - 1;
+        return false;
+      }
+
+      payloadCount = 0;
+      state = (frame.length == 0) ? STATE_CHECKSUM_A : STATE_PAYLOAD;
+      return false;
+
+    case STATE_PAYLOAD:
+      addChecksum (c);
+      frameBuffer [UBX_Frame::HeaderLength + payloadCount++] = c;
+
+      if (payloadCount == frame.length) {
+        state = STATE_CHECKSUM_A;
+      }
+      return false;
+
+    case STATE_CHECKSUM_A:
+      frameBuffer [UBX_Frame::HeaderLength + frame.length] = c;
+      state = STATE_CHECKSUM_B;
+      return false;
+
+    case STATE_CHECKSUM_B:
+      frameBuffer [UBX_Frame::HeaderLength + frame.length + 1] = c;
+      state = STATE_SYNC_1;
+
+      if ((frameBuffer [UBX_Frame::HeaderLength + frame.length] != checksumA) || (c != checksumB)) {
+        checksumErrorCount++;
+        rescanLength = UBX_Frame::HeaderLength + frame.length + UBX_Frame::ChecksumLength - 1;
+        return false;
+      }
+
+      complete();
+      return true;
+  }
+
+  return false;
+}
+
+//======================================================================================//
+/**
+ * @brief Feeds the bytes after the first sync character of a dropped split frame again, as
+ * a chunk. A frame whose header lies in these bytes is dropped in place if its length does
+ * not fit, and so is a frame that ends in them and fails its checksum, so no new rescan
+ * starts here. A frame that goes past them is collected from the start of the frame
+ * buffer, behind the byte being read.
+ * 
+ * @return uint16_t The number of frames completed.
+ */
+uint16_t UBX_Framer:: rescan() {
+  const uint8_t* data;
+  uint16_t length = takeRescan (data);
+
+  return feed (data, length);
+}
+
+//======================================================================================//
+/**
+ * @brief Takes the bytes after the first sync character of the split frame that was
+ * dropped in the last feedFrame() call. The caller must feed them again before any other
+ * byte, so that the frames in them are not lost. The bytes are in the frame buffer and are
+ * valid until the next byte is fed.
+ * 
+ * @param data Set to the first byte.
+ * @return uint16_t The number of bytes. 0 if there are none.
+ */
+uint16_t UBX_Framer:: takeRescan (const uint8_t*& data) {
+  uint16_t length = rescanLength;
+
+  data = frameBuffer + 1;
+  rescanLength = 0;
+  return length;
+}
+
+//======================================================================================//
+/**
+ * @brief Feeds a chunk of bytes to the framer. The bytes before a frame are skipped with
+ * memchr() to the next sync character. The frames are read with feedFrame().
+ * 
+ * @param data The bytes to feed.
+ * @param length The number of bytes.
+ * @return uint16_t The number of frames completed.
+ */
+uint16_t UBX_Framer:: feed (const uint8_t* data, size_t length) {
+  uint32_t startCount = frameCount;
+  size_t i = 0;
+
+  while (i < length) {
+    if (state == STATE_SYNC_1) {
+      const uint8_t* next = (const uint8_t*) memchr (data + i, UBX_Frame::Sync1, length - i);
+
+      if (next == nullptr) {
+        break;
+      }
+
+      i = next - data;
+    }
+
+    i += feedFrame (data + i, length - i);
+
+    if (rescanLength > 0) {
+      rescan();
+    }
+  }
+
+  return frameCount - startCount;
+}
+
+//======================================================================================//
+/**
+ * @brief Feeds the bytes of a single frame, from its sync characters or from where the
+ * previous call stopped, and stops as soon as the frame is completed or dropped. A frame
+ * that starts at the first byte and ends inside the bytes is checked in place and then
+ * copied to the frame buffer. If its checksum does not match, or its header is in the bytes
+ * and its length does not fit, only the first sync character is used, so that the bytes
+ * after it are looked at again. Otherwise the payload is copied in runs, and if the frame is dropped, the bytes after its first sync character are left
+ * for takeRescan().
+ * 
+ * @param data The bytes to feed.
+ * @param length The number of bytes.
+ * @return size_t The number of bytes used, at least 1 if length is not 0.
+ */
+size_t UBX_Framer:: feedFrame (const uint8_t* data, size_t length) {
+  if ((state == STATE_SYNC_1) && (length >= 2) && (data [0] == UBX_Frame::Sync1) && (data [1] == UBX_Frame::Sync2)) {
+    uint16_t payloadLength = (length >= UBX_Frame::HeaderLength) ? (uint16_t) (data [4] | (data [5] << 8)) : 0;
+    size_t wholeLength = payloadLength + UBX_Frame::HeaderLength + UBX_Frame::ChecksumLength;
+
+    if (payloadLength > CONST_MAX_UBX_PAYLOAD_LENGTH) {
+      oversizeCount++;
+      return 1;
+    }
+
+    if ((length >= UBX_Frame::HeaderLength) && (wholeLength <= length)) {
+      uint8_t frameChecksumA = 0;
+      uint8_t frameChecksumB = 0;
+
+      computeChecksum (data + 2, payloadLength + 4, frameChecksumA, frameChecksumB);
+
+      if ((data [wholeLength - 2] != frameChecksumA) || (data [wholeLength - 1] != frameChecksumB)) {
+        checksumErrorCount++;
+        return 1;
+      }
+
+      // The bytes can be from the frame buffer itself when they are fed again.
+      memmove (frameBuffer, data, wholeLength);
+      frame.messageClass = frameBuffer [2];
+      frame.id = frameBuffer [3];
+      frame.length = payloadLength;
+      complete();
+      return wholeLength;
+    }
+  }
+
+  size_t i = 0;
+
+  while (i < length) {
+    if ((state == STATE_PAYLOAD) && ((frame.length - payloadCount) > 1)) {
+      // Leave the last payload byte to step(), which moves to the checksum state.
+      size_t runLength = frame.length - payloadCount - 1;
+
+      if (runLength > (length - i)) {
+        runLength = length - i;
+      }
+
+      // The checksum first, as the copy can overwrite the bytes when they are fed again.
+      computeChecksum (data + i, runLength, checksumA, checksumB);
+      memmove (frameBuffer + UBX_Frame::HeaderLength + payloadCount, data + i, runLength);
+      payloadCount += runLength;
+      i += runLength;
+      continue;
+    }
+
+    step (data [i++]);
+
+    if (state == STATE_SYNC_1) {
+      break;
+    }
+  }
+
+  return i;
+}
+
+//======================================================================================//
+/**
+ * @brief Returns the message of the last ACK or NAK frame. Compare getAckCount() before and
+ * after to find out if a new one has arrived.
+ * 
+ * @param messageClass The class of the acknowledged message.
+ * @param id The ID of the acknowledged message.
+ * @return true The last one was an ACK.
+ * @return false The last one was a NAK, or none has been received.
+ */
+bool UBX_Framer:: getLastAck (uint8_t& messageClass, uint8_t& id) const {
+  messageClass = ackClass;
+  id = ackId;
+  return ackAccepted;
+}
+
+//======================================================================================//
+/**
+ * @brief Decodes the NAV-PVT values to the fix, in the same units as the NMEA decoders.
+ * The time and the date are set if the receiver marks them as valid. The position, the
+ * speed and the course are set if there is a fix, and the altitude if it is a 3D fix.
+ * The quality is 4 for RTK fixed, 5 for RTK float, 2 for differential and 1 for the other
+ * fixes, like GGA. Only the PDOP is sent, so the HDOP and VDOP are set to 0xFFFF.
+ * 
+ * @param fix The fix to update.
+ * @return true The frame is a NAV-PVT frame.
+ * @return false The frame is not a NAV-PVT frame.
+ */
+bool UBX_Nav_Pvt:: decode (NMEA_Fix& fix) const {
+  if (!isValid()) {
+    return false;
+  }
+
+  uint8_t fixType = getFixType();
+  uint8_t flags = getFlags();
+  bool hasFix = (fixType >= 2) && (fixType <= 4);
+  bool fixOk = hasFix && (flags & 0x01);
+
+  if (fixOk) {
+    fix.flags |= NMEA_Fix::FLAG_VALID;
+  }
+  else {
+    fix.flags &= ~NMEA_Fix::FLAG_VALID;
+  }
+
+  if (getValid() & 0x02) {
+    int32_t time = ((((int32_t) getHour() * 60) + getMinute()) * 60 + getSecond()) * 1000 + (getNano() / 1000000);
+
+    if (time < 0) {
+      time += 86400000;
+    }
+
+    fix.time = (uint32_t) time;
+    fix.flags |= NMEA_Fix::FLAG_TIME;
+  }
+
+  if (getValid() & 0x01) {
+    fix.date = (uint16_t) NMEA_Decoder::getDaysFromCivil (getYear(), getMonth(), getDay());
+    fix.flags |= NMEA_Fix::FLAG_DATE;
+  }
+
+  if (hasFix) {
+    fix.latitude = getLatitude();
+    fix.longitude = getLongitude();
+    fix.speed = getGroundSpeed();
+    fix.course = (uint16_t) (getHeading() / 1000);
+    fix.flags |= NMEA_Fix::FLAG_POSITION | NMEA_Fix::FLAG_SPEED | NMEA_Fix::FLAG_COURSE;
+  }
+
+  if ((fixType == 3) || (fixType == 4)) {
+    fix.altitude = getAltitude();
+    fix.flags |= NMEA_Fix::FLAG_ALTITUDE;
+  }
+
+  if (!fixOk) {
+    fix.quality = 0;
+  }
+  else if ((flags >> 6) == 2) {
+    fix.quality = 4;
+  }
+  else if ((flags >> 6) == 1) {
+    fix.quality = 5;
+  }
+  else {
+    fix.quality = (flags & 0x02) ? 2 : 1;
+  }
+
+  fix.satellites = getSatellites();
+  fix.flags |= NMEA_Fix::FLAG_QUALITY;
+
+  fix.fixMode = (fixType == 2) ? 2 : (((fixType == 3) || (fixType == 4)) ? 3 : 1);
+  fix.pdop = getPdop();
+  fix.hdop = 0xFFFF;
+  fix.vdop = 0xFFFF;
+  fix.flags |= NMEA_Fix::FLAG_DOP;
+
+  return true;
+}
+
+//======================================================================================//
+/**
+ * @brief Checks that the frame is a NAV-SAT frame and has a block for every satellite.
+ * 
+ * @return true The frame can be read.
+ * @return false The frame is not a NAV-SAT frame, or it is too short.
+ */
+bool UBX_Nav_Sat:: isValid() const {
+  if ((frame.messageClass != Class) || (frame.id != Id) || (frame.length < HeaderLength)) {
+    return false;
+  }
+
+  return frame.length >= (HeaderLength + ((uint16_t) getCount() * BlockLength));
+}
+
+//======================================================================================//
+/**
+ * @brief The CRC-24Q of each 4-bit value, for the nibble-at-a-time CRC. The polynomial is
+ * 0x1864CFB. 16 entries instead of 256 keep the table small on the 8-bit boards.
+ * 
+ */
+static const uint32_t RTCM_Crc_Table [16] = {
+  0x000000, 0x864CFB, 0x8AD50D, 0x0C99F6, 0x93E6E1, 0x15AA1A, 0x1933EC, 0x9F7F17,
+  0xA18139, 0x27CDC2, 0x2B5434, 0xAD18CF, 0x3267D8, 0xB42B23, 0xB8B2D5, 0x3EFE2E
+};
+
+//======================================================================================//
+/**
+ * @brief RTCM_Framer constructor. The framer starts by waiting for the preamble.
+ * 
+ */
+RTCM_Framer:: RTCM_Framer() {
+  handler = nullptr;
+  handlerContext = nullptr;
+  frameCount = 0;
+  crcErrorCount = 0;
+  oversizeCount = 0;
+  lastMessageType = 0;
+  reset();
+}
+
+//======================================================================================//
+/**
+ * @brief Adds the bytes to a CRC-24Q, as used by RTCM 3. The CRC can be computed in several
+ * calls by passing the previous result.
+ * 
+ * @param data The bytes.
+ * @param length The number of bytes.
+ * @param crc The CRC of the previous bytes. 0 to start.
+ * @return uint32_t The 24-bit CRC.
+ */
+uint32_t RTCM_Framer:: computeCrc (const uint8_t* data, size_t length, uint32_t crc) {
+  for (size_t i = 0; i < length; i++) {
+    crc = ((crc << 4) & 0xFFFFFF) ^ RTCM_Crc_Table [((crc >> 20) ^ (data [i] >> 4)) & 0x0F];
+    crc = ((crc << 4) & 0xFFFFFF) ^ RTCM_Crc_Table [((crc >> 20) ^ data [i]) & 0x0F];
+  }
+
+  return crc;
+}
+
+//======================================================================================//
+/**
+ * @brief Returns the message type of a frame, which is the first 12 bits of the payload.
+ * 
+ * @param frame The whole frame, from the preamble.
+ * @param length The length of the frame.
+ * @return uint16_t The message type, eg. 1005 or 1077. 0 if the payload is too short.
+ */
+uint16_t RTCM_Framer:: getMessageType (const uint8_t* frame, uint16_t length) {
+  if (length < (HeaderLength + 2 + CrcLength)) {
+    return 0;
+  }
+
+  return (uint16_t) ((frame [3] << 4) | (frame [4] >> 4));
+}
+
+//======================================================================================//
+/**
+ * @brief Sets the function to call when a complete frame is received.
+ * 
+ * @param handler The handler function. Can be nullptr.
+ * @param context A user pointer that will be passed to the handler.
+ */
+void RTCM_Framer:: setHandler (RTCM_Frame_Handler handler, void* context) {
+  this->handler = handler;
+  handlerContext = context;
+}
+
+//======================================================================================//
+/**
+ * @brief Discards any partial frame and waits for the next preamble.
+ * 
+ */
+void RTCM_Framer:: reset() {
+  state = STATE_PREAMBLE;
+  frameLength = 0;
+  bufferCount = 0;
+  rescanLength = 0;
+}
+
+//======================================================================================//
+/**
+ * @brief Checks the CRC at the end of a whole frame and passes the frame to the handler.
+ * 
+ * @param frame The frame, from the preamble to the CRC.
+ * @param length The length of the frame.
+ * @return true The CRC matches.
+ * @return false The CRC does not match. The frame is counted and dropped.
+ */
+bool RTCM_Framer:: complete (const uint8_t* frame, uint16_t length) {
+  const uint8_t* crc = frame + length - CrcLength;
+  uint32_t receivedCrc = ((uint32_t) crc [0] << 16) | ((uint32_t) crc [1] << 8) | crc [2];
+
+  if (computeCrc (frame, length - CrcLength) != receivedCrc) {
+    crcErrorCount++;
+    return false;
+  }
+
+  frameCount++;
+  lastMessageType = getMessageType (frame, length);
+
+  if (handler != nullptr) {
+    handler (frame, length, handlerContext);
+  }
+
+  return true;
+}
+
+//======================================================================================//
+/**
+ * @brief Feeds a single byte to the framer. The frame is collected in the frame buffer and
+ * passed to the handler when its CRC matches. The 6 bits before the length must be 0. If
+ * the CRC does not match, the bytes after the preamble are fed again.
+ * 
+ * @param c The byte to feed.
+ * @return true A frame was completed by this byte.
+ * @return false No frame was completed.
+ */
+bool RTCM_Framer:: feed (uint8_t c) {
+  if (step (c)) {
+    return true;
+  }
+
+  return (rescanLength > 0) && (rescan() > 0);
+}
+
+//======================================================================================//
+/**
+ * @brief Feeds a single byte to the state machine. When a split frame fails its CRC, the
+ * number of bytes after its preamble is saved in rescanLength, and the bytes are left in
+ * the frame buffer for the caller to feed again.
+ * 
+ * @param c The byte to feed.
+ * @return true A frame was completed by this byte.
+ * @return false No frame was completed.
+ */
+bool RTCM_Framer:: step (uint8_t c) {
+  switch (state) {
+    case STATE_PREAMBLE:
+      if (c == Preamble) {
+        frameBuffer [0] = c;
+        bufferCount = 1;
+        rescanLength = 0;
+        state = STATE_LENGTH_1;
+      }
+      return false;
+
+    case STATE_LENGTH_1:
+      if ((c & 0xFC) != 0) {
+        reset();
+        return false;
+      }
+
+      frameBuffer [bufferCount++] = c;
+      frameLength = (uint16_t) (c & 0x03) << 8;
+      state = STATE_LENGTH_2;
+      return false;
+
+    case STATE_LENGTH_2:
+      frameLength = (frameLength | c) + HeaderLength + CrcLength;
+
+      if (frameLength > CONST_MAX_RTCM_FRAME_LENGTH) {
+        oversizeCount++;
+        reset();
+        return false;
+      }
+
+      frameBuffer [bufferCount++] = c;
+      state = STATE_BODY;
+      return false;
+
+    case STATE_BODY:
+      frameBuffer [bufferCount++] = c;
+
+      if (bufferCount < frameLength) {
+        return false;
+      }
+
+      state = STATE_PREAMBLE;
+
+      if (complete (frameBuffer, frameLength)) {
+        return true;
+      }
+
+      rescanLength = frameLength - 1;
+      return false;
+  }
+
+  return false;
+}
+
+//======================================================================================//
+/**
+ * @brief Feeds the bytes after the preamble of a split frame that failed its CRC again, as
+ * a chunk. A frame that starts in these bytes either ends in them and is checked in place,
+ * or ends after them, so this does not go deeper than once. The new frame is collected
+ * from the start of the frame buffer, always behind the byte being read.
+ * 
+ * @return uint16_t The number of frames completed.
+ */
+uint16_t RTCM_Framer:: rescan() {
+  const uint8_t* data;
+  uint16_t length = takeRescan (data);
+
+  return feed (data, length);
+}
+
+//======================================================================================//
+/**
+ * @brief Takes the bytes after the preamble of the split frame that failed its CRC in the
+ * last feedFrame() call. The caller must feed them again before any other byte, so that
+ * the frames in them are not lost. The bytes are in the frame buffer and are valid until
+ * the next byte is fed.
+ * 
+ * @param data Set to the first byte.
+ * @return uint16_t The number of bytes. 0 if there are none.
+ */
+uint16_t RTCM_Framer:: takeRescan (const uint8_t*& data) {
+  uint16_t length = rescanLength;
+
+  data = frameBuffer + 1;
+  rescanLength = 0;
+  return length;
+}
+
+//======================================================================================//
+/**
+ * @brief Feeds a chunk of bytes to the framer. The bytes before a frame are skipped with
+ * memchr() to the next preamble. The frames are read with feedFrame().
+ * 
+ * @param data The bytes to feed.
+ * @param length The number of bytes.
+ * @return uint16_t The number of frames completed.
+ */
+uint16_t RTCM_Framer:: feed (const uint8_t* data, size_t length) {
+  uint32_t startCount = frameCount;
+  size_t i = 0;
+
+  while (i < length) {
+    if (state == STATE_PREAMBLE) {
+      const uint8_t* next = (const uint8_t*) memchr (data + i, Preamble, length - i);
+
+      if (next == nullptr) {
+        break;
+      }
+
+      i = next - data;
+    }
+
+    i += feedFrame (data + i, length - i);
+
+    if (rescanLength > 0) {
+      rescan();
+    }
+  }
+
+  return frameCount - startCount;
+}
+
+//======================================================================================//
+/**
+ * @brief Feeds the bytes of a single frame, from its preamble or from where the previous
+ * call stopped, and stops as soon as the frame is completed or dropped. A frame that starts
+ * at the first byte and ends inside the bytes is checked and passed to the handler in place.
+ * If its CRC does not match, only the preamble is used, so that the bytes after a false
+ * preamble are looked at again. Otherwise the frame is copied to the frame buffer in runs,
+ * and if its CRC does not match, the bytes after its preamble are left for takeRescan().
+ * 
+ * @param data The bytes to feed.
+ * @param length The number of bytes.
+ * @return size_t The number of bytes used, at least 1 if length is not 0.
+ */
+size_t RTCM_Framer:: feedFrame (const uint8_t* data, size_t length) {
+  if ((state == STATE_PREAMBLE) && (length >= HeaderLength) && (data [0] == Preamble) && ((data [1] & 0xFC) == 0)) {
+    size_t wholeLength = (((size_t) (data [1] & 0x03) << 8) | data [2]) + HeaderLength + CrcLength;
+
+    if (wholeLength <= length) {
+      return complete (data, (uint16_t) wholeLength) ? wholeLength : 1;
+    }
+  }
+
+  size_t i = 0;
+
+  while (i < length) {
+    if ((state == STATE_BODY) && ((frameLength - bufferCount) > 1)) {
+      // Leave the last byte to feed (uint8_t), which completes the frame.
+      size_t runLength = frameLength - bufferCount - 1;
+
+      if (runLength > (length - i)) {
+        runLength = length - i;
+      }
+
+      // The bytes can be from the frame buffer itself when they are fed again.
+      memmove (frameBuffer + bufferCount, data + i, runLength);
+      bufferCount += runLength;
+      i += runLength;
+      continue;
+    }
+
+    step (data [i++]);
+
+    if (state == STATE_PREAMBLE) {
+      break;
+    }
+  }
+
+  return i;
+}
+
+//======================================================================================//
+/**
+ * @brief GNSS_Demux constructor. No framers are attached.
+ * 
+ */
+GNSS_Demux:: GNSS_Demux() {
+  nmeaFramer = nullptr;
+  ubxFramer = nullptr;
+  rtcmFramer = nullptr;
+  protocol = PROTOCOL_NONE;
+  resetByteCounts();
+}
+
+//======================================================================================//
+/**
+ * @brief Sets the framer of the NMEA sentences. The sentences are dropped if not set.
+ * 
+ * @param framer The NMEA framer. nullptr to remove.
+ */
+void GNSS_Demux:: setNmeaFramer (NMEA_Framer* framer) {
+  if (protocol == PROTOCOL_NMEA) {
+    protocol = PROTOCOL_NONE;
+  }
+
+  nmeaFramer = framer;
+}
+
+//======================================================================================//
+/**
+ * @brief Sets the framer of the UBX frames. The frames are dropped if not set.
+ * 
+ * @param framer The UBX framer. nullptr to remove.
+ */
+void GNSS_Demux:: setUbxFramer (UBX_Framer* framer) {
+  if (protocol == PROTOCOL_UBX) {
+    protocol = PROTOCOL_NONE;
+  }
+
+  ubxFramer = framer;
+}
+
+//======================================================================================//
+/**
+ * @brief Sets the framer of the RTCM 3 frames. The frames are dropped if not set.
+ * 
+ * @param framer The RTCM framer. nullptr to remove.
+ */
+void GNSS_Demux:: setRtcmFramer (RTCM_Framer* framer) {
+  if (protocol == PROTOCOL_RTCM) {
+    protocol = PROTOCOL_NONE;
+  }
+
+  rtcmFramer = framer;
+}
+
+//======================================================================================//
+/**
+ * @brief Discards the partial frames of all the attached framers and waits for the start
+ * of the next frame.
+ * 
+ */
+void GNSS_Demux:: reset() {
+  protocol = PROTOCOL_NONE;
+
+  if (nmeaFramer != nullptr) {
+    nmeaFramer->reset();
+  }
+
+  if (ubxFramer != nullptr) {
+    ubxFramer->reset();
+  }
+
+  if (rtcmFramer != nullptr) {
+    rtcmFramer->reset();
+  }
+}
+
+//======================================================================================//
+/**
+ * @brief Returns the protocol of the attached framer whose frames start with the byte.
+ * 
+ * @param c The byte.
+ * @return GNSS_Demux::Protocol The protocol. PROTOCOL_NONE if no attached framer uses it.
+ */
+GNSS_Demux::Protocol GNSS_Demux:: getStartProtocol (uint8_t c) const {
+  if ((c == '$') && (nmeaFramer != nullptr)) {
+    return PROTOCOL_NMEA;
+  }
+
+  if ((c == UBX_Frame::Sync1) && (ubxFramer != nullptr)) {
+    return PROTOCOL_UBX;
+  }
+
+  if ((c == RTCM_Framer::Preamble) && (rtcmFramer != nullptr)) {
+    return PROTOCOL_RTCM;
+  }
+
+  return PROTOCOL_NONE;
+}
+
+//======================================================================================//
+/**
+ * @brief Finds the first byte that starts a frame of an attached framer. With a single
+ * framer, the byte is found with memchr().
+ * 
+ * @param data The bytes.
+ * @param length The number of bytes.
+ * @return size_t The position of the byte. length if there is none.
+ */
+size_t GNSS_Demux:: findStart (const uint8_t* data, size_t length) const {
+  uint8_t framerCount = 0;
+  uint8_t startByte = 0;
+
+  if (nmeaFramer != nullptr) {
+    startByte = '$';
+    framerCount++;
+  }
+
+  if (ubxFramer != nullptr) {
+    startByte = UBX_Frame::Sync1;
+    framerCount++;
+  }
+
+  if (rtcmFramer != nullptr) {
+    startByte = RTCM_Framer::Preamble;
+    framerCount++;
+  }
+
+  if (framerCount == 0) {
+    return length;
+  }
+
+  if (framerCount == 1) {
+    const uint8_t* next = (const uint8_t*) memchr (data, startByte, length);
+    return (next == nullptr) ? length : (size_t) (next - data);
+  }
+
+  for (size_t i = 0; i < length; i++) {
+    if (getStartProtocol (data [i]) != PROTOCOL_NONE) {
+      return i;
+    }
+  }
+
+  return length;
+}
+
+//======================================================================================//
+/**
+ * @brief Feeds the bytes to the framer of the current frame, until the frame ends. If the
+ * frame broke before its checksum, the byte that broke it is given back when it can start
+ * a frame of another framer. If a split UBX or RTCM frame was dropped, the bytes after its
+ * first byte are split again, as they would be if the frame had come in one chunk.
+ * 
+ * @param data The bytes.
+ * @param length The number of bytes.
+ * @param completedCount Incremented if a frame was completed.
+ * @return size_t The number of bytes used.
+ */
+size_t GNSS_Demux:: feedFrame (const uint8_t* data, size_t length, uint16_t& completedCount) {
+  size_t count = 0;
+  uint32_t validCount = 0; // The frames with a valid checksum
+  uint32_t checkedCount = 0; // The frames that reached their checksum
+  bool idle = true;
+  bool wasIdle = true; // The start byte of the frame is in the bytes
+  const uint8_t* rescanData = nullptr;
+  uint16_t rescanLength = 0;
+  Protocol frameProtocol = protocol;
+
+  switch (protocol) {
+    case PROTOCOL_NMEA:
+      validCount = nmeaFramer->getSentenceCount();
+      checkedCount = validCount + nmeaFramer->getChecksumErrorCount();
+      wasIdle = nmeaFramer->isIdle();
+      count = nmeaFramer->feedFrame ((const char*) data, length);
+      validCount = nmeaFramer->getSentenceCount() - validCount;
+      checkedCount = (nmeaFramer->getSentenceCount() + nmeaFramer->getChecksumErrorCount()) - checkedCount;
+      idle = nmeaFramer->isIdle();
+      break;
+
+    case PROTOCOL_UBX:
+      validCount = ubxFramer->getFrameCount();
+      checkedCount = validCount + ubxFramer->getChecksumErrorCount();
+      wasIdle = ubxFramer->isIdle();
+      count = ubxFramer->feedFrame (data, length);
+      rescanLength = ubxFramer->takeRescan (rescanData);
+      validCount = ubxFramer->getFrameCount() - validCount;
+      checkedCount = (ubxFramer->getFrameCount() + ubxFramer->getChecksumErrorCount()) - checkedCount;
+      idle = ubxFramer->isIdle();
+      break;
+
+    case PROTOCOL_RTCM:
+      validCount = rtcmFramer->getFrameCount();
+      checkedCount = validCount + rtcmFramer->getCrcErrorCount();
+      wasIdle = rtcmFramer->isIdle();
+      count = rtcmFramer->feedFrame (data, length);
+      rescanLength = rtcmFramer->takeRescan (rescanData);
+      validCount = rtcmFramer->getFrameCount() - validCount;
+      checkedCount = (rtcmFramer->getFrameCount() + rtcmFramer->getCrcErrorCount()) - checkedCount;
+      idle = rtcmFramer->isIdle();
+      break;
+
+    default:
+      break;
+  }
+
+  if (idle) {
+    // Eg. a '$' or a preamble that cuts into a broken frame. The bytes fed again are
+    // already looked at, and so is a start byte that was used alone.
+    if ((checkedCount == 0) && (rescanLength == 0) && (count > (wasIdle ? 1 : 0)) &&
+        (getStartProtocol (data [count - 1]) != PROTOCOL_NONE)) {
+      count--;
+    }
+
+    completedCount += validCount;
+    byteCounts [protocol] += count;
+    protocol = PROTOCOL_NONE;
+  }
+  else {
+    byteCounts [protocol] += count;
+  }
+
+  // The bytes were counted as the protocol of the frame while it was collected.
+  if (rescanLength > 0) {
+    byteCounts [frameProtocol] -= rescanLength;
+    completedCount += split (rescanData, rescanLength);
+  }
+
+  return count;
+}
+
+//======================================================================================//
+/**
+ * @brief Feeds a chunk of bytes. The chunk can be of any size and does not have to be
+ * aligned with the frames. Each byte is looked at once, except the byte that breaks a
+ * frame, which is looked at again as the possible start of another frame. The handlers of
+ * the framers are called for every frame completed inside the chunk.
+ * 
+ * @param data The bytes to feed.
+ * @param length The number of bytes.
+ * @return uint16_t The number of frames completed, of all the protocols.
+ */
+uint16_t GNSS_Demux:: feed (const uint8_t* data, size_t length) {
+  if (nmeaFramer != nullptr) {
+    nmeaFramer->beginChunk();
+  }
+
+  uint16_t completedCount = split (data, length);
+
+  if (nmeaFramer != nullptr) {
+    nmeaFramer->endChunk();
+  }
+
+  return completedCount;
+}
+
+//======================================================================================//
+/**
+ * @brief Splits the bytes between the framers. The bytes between the frames are skipped
+ * with findStart(), and each frame is fed to its framer with feedFrame().
+ * 
+ * @param data The bytes.
+ * @param length The number of bytes.
+ * @return uint16_t The number of frames completed, of all the protocols.
+ */
+uint16_t GNSS_Demux:: split (const uint8_t* data, size_t length) {
+  uint16_t completedCount = 0;
+  size_t i = 0;
+
+  while (i < length) {
+    if (protocol == PROTOCOL_NONE) {
+      size_t start = i + findStart (data + i, length - i);
+
+      byteCounts [PROTOCOL_NONE] += start - i;
+      i = start;
+
+      if (i == length) {
+        break;
+      }
+
+      protocol = getStartProtocol (data [i]);
+    }
+
+    i += feedFrame (data + i, length - i, completedCount);
+  }
+
+  return completedCount;
+}
+
+//======================================================================================//
+/**
+ * @brief Feeds a single byte. Inside an NMEA sentence, the byte goes straight to the NMEA
+ * framer for as long as it cannot end the sentence.
+ * 
+ * @param c The byte to feed.
+ * @return true A frame was completed by this byte.
+ * @return false No frame was completed.
+ */
+bool GNSS_Demux:: feed (uint8_t c) {
+  if ((protocol == PROTOCOL_NMEA) && (c >= 0x20) && (c <= 0x7E) && (c != '*') && !nmeaFramer->isIdle()) {
+    bool completed = nmeaFramer->feed ((char) c);
+
+    byteCounts [PROTOCOL_NMEA]++;
+
+    if (nmeaFramer->isIdle()) {
+      protocol = PROTOCOL_NONE;
+    }
+
+    return completed;
+  }
+
+  return feed (&c, 1) > 0;
+}
+
+//======================================================================================//
+/**
+ * @brief Returns the number of bytes of a protocol, for the throughput of each protocol.
+ * The bytes of the frames that were dropped are also counted.
+ * 
+ * @param protocol The protocol. PROTOCOL_NONE for the bytes between the frames.
+ * @return uint32_t The number of bytes.
+ */
+uint32_t GNSS_Demux:: getByteCount (Protocol protocol) const {
+  return (protocol < PROTOCOL_COUNT) ? byteCounts [protocol] : 0;
+}
+
+//======================================================================================//
+/**
+ * @brief Sets the byte counts of all the protocols to 0.
+ * 
+ */
+void GNSS_Demux:: resetByteCounts() {
+  for (uint8_t i = 0; i < PROTOCOL_COUNT; i++) {
+    byteCounts [i] = 0;
+  }
+}
+
+//======================================================================================//
+/**
+ * @brief Adds a time to the histogram.
+ * 
+ * @param time The time in CSE_GNSS_STATS_CLOCK() ticks.
+ */
+void GNSS_Latency_Histogram:: add (uint32_t time) {
+  uint8_t bucket = 0;
+
+  for (uint32_t t = time; (t != 0) && (bucket < (BucketCount - 1)); t >>= 1) {
+    bucket++;
+  }
+
+  buckets [bucket]++;
+  count++;
+
+  if (time > maxTime) {
+    maxTime = time;
+  }
+}
+
+//======================================================================================//
+/**
+ * @brief Removes all the times from the histogram.
+ * 
+ */
+void GNSS_Latency_Histogram:: clear() {
+  for (uint8_t i = 0; i < BucketCount; i++) {
+    buckets [i] = 0;
+  }
+
+  count = 0;
+  maxTime = 0;
+}
+
+//======================================================================================//
+/**
+ * @brief Returns the upper bound of the bucket that holds a percentile, eg. 99 for the time
+ * that 99% of the calls did not exceed. The bound of the last bucket is the longest time.
+ * 
+ * @param percent The percentile, from 0 to 100.
+ * @return uint32_t The time in CSE_GNSS_STATS_CLOCK() ticks. 0 if the histogram is empty.
+ */
+uint32_t GNSS_Latency_Histogram:: getPercentile (uint8_t percent) const {
+  if (count == 0) {
+    return 0;
+  }
+
+  uint32_t target = (uint32_t) (((uint64_t) count * percent + 99) / 100);
+  uint32_t total = 0;
+
+  for (uint8_t i = 0; i < (BucketCount - 1); i++) {
+    total += buckets [i];
+
+    if (total >= target) {
+      uint32_t bound = (i == 0) ? 0 : (((uint32_t) 1 << i) - 1);
+      return (bound < maxTime) ? bound : maxTime;
+    }
+  }
+
+  return maxTime;
+}
+
+//======================================================================================//
+/**
+ * @brief Returns the type of a sentence for the typeCounts, from the 3 characters after the
+ * talker ID.
+ * 
+ * @param sentence The sentence, from the '$' if it has one.
+ * @param length The length of the sentence.
+ * @return GNSS_Stats::Type The type. TYPE_OTHER if it is not one of the counted types.
+ */
+GNSS_Stats::Type GNSS_Stats:: getType (const char* sentence, uint16_t length) {
+  static const char types [] = "GGAGLLGSAGSVRMCVTGZDA";
+  uint16_t headerStart = ((length > 0) && (sentence [0] == '$')) ? 1 : 0;
+
+  if ((length < (headerStart + 5)) || (sentence [headerStart] == 'P')) {
+    return TYPE_OTHER;
+  }
+
+  for (uint8_t i = 0; i < TYPE_OTHER; i++) {
+    if (memcmp (sentence + headerStart + 2, types + (i * 3), 3) == 0) {
+      return (Type) i;
+    }
+  }
+
+  return TYPE_OTHER;
+}
+
+//======================================================================================//
+/**
+ * @brief Constructs an empty memory source. Use set() to give it a buffer.
+ * 
+ */
+NMEA_Memory_Source:: NMEA_Memory_Source() : data (nullptr), length (0), position (0) {
+}
+
+//======================================================================================//
+/**
+ * @brief Constructs a memory source that reads the given buffer.
+ * 
+ * @param data The first byte of the buffer.
+ * @param length The number of bytes in the buffer.
+ */
+NMEA_Memory_Source:: NMEA_Memory_Source (const char* data, size_t length) : data (data), length (length), position (0) {
+}
+
+//======================================================================================//
+/**
+ * @brief Sets a new buffer and starts reading from its beginning.
+ * 
+ * @param data The first byte of the buffer.
+ * @param length The number of bytes in the buffer.
+ */
+void NMEA_Memory_Source:: set (const char* data, size_t length) {
+  this->data = data;
+  this->length = length;
+  position = 0;
+}
+
+//======================================================================================//
+/**
+ * @brief Returns the number of bytes that are not read yet.
+ * 
+ * @return size_t The number of bytes.
+ */
+size_t NMEA_Memory_Source:: getRemaining() const {
+  return length - position;
+}
+
+//======================================================================================//
+/**
+ * @brief Gets the next run of bytes that can be read in place. The run is limited to
+ * 16 KB, so the number of sentences in it always fits the return value of
+ * CSE_GNSS::feed (const char*, size_t).
+ * 
+ * @param data The first byte of the run.
+ * @return size_t The number of bytes in the run. 0 if all the bytes are read.
+ */
+size_t NMEA_Memory_Source:: peek (const char*& data) const {
+  const size_t maxRun = 0x4000;
+  size_t remaining = length - position;
+
+  data = this->data + position;
+  return (remaining < maxRun) ? remaining : maxRun;
+}
+
+//======================================================================================//
+/**
+ * @brief Marks the bytes returned by peek() as read.
+ * 
+ * @param count The number of bytes.
+ */
+void NMEA_Memory_Source:: consume (size_t count) {
+  position += (count < (length - position)) ? count : (length - position);
+}
+
+//======================================================================================//
+/**
+ * @brief Returns the number of bytes that can be read. Limited to the largest int.
+ * 
+ * @return int The number of bytes.
+ */
+int NMEA_Memory_Source:: available() {
+  size_t remaining = length - position;
+  return (remaining < (size_t) INT_MAX) ? (int) remaining : INT_MAX;
+}
+
+//======================================================================================//
+/**
+ * @brief Reads a single byte.
+ * 
+ * @return int The byte, or -1 if all the bytes are read.
+ */
+int NMEA_Memory_Source:: read() {
+  if (position >= length) {
+    return -1;
+  }
+
+  return (uint8_t) data [position++];
+}
+
+//======================================================================================//
+/**
+ * @brief Returns the next byte without reading it.
+ * 
+ * @return int The byte, or -1 if all the bytes are read.
+ */
+int NMEA_Memory_Source:: peek() {
+  if (position >= length) {
+    return -1;
+  }
+
+  return (uint8_t) data [position];
+}
+
+//======================================================================================//
+/**
+ * @brief The memory source is read-only, so nothing is written.
+ * 
+ * @param c The byte to write.
+ * @return size_t Always 0.
+ */
+size_t NMEA_Memory_Source:: write (uint8_t c) {
+  (void) c;
+  return 0;
+}
+
+#if defined(__linux__)
+//======================================================================================//
+/**
+ * @brief Constructs a mapped file object without a file.
+ * 
+ */
+NMEA_Mapped_File:: NMEA_Mapped_File() : mapping (nullptr), mappingLength (0), opened (false) {
+}
+
+//======================================================================================//
+/**
+ * @brief Unmaps the file, if any.
+ * 
+ */
+NMEA_Mapped_File:: ~NMEA_Mapped_File() {
+  close();
+}
+
+//======================================================================================//
+/**
+ * @brief Maps a file to memory for reading. The previous file is closed first. An empty
+ * file is opened successfully and has no bytes to read.
+ * 
+ * @param path The path of the file.
+ * @return true The file was mapped.
+ * @return false The file could not be opened or mapped.
+ */
+bool NMEA_Mapped_File:: open (const char* path) {
+  close();
+
+  int fd = ::open (path, O_RDONLY);
+
+  if (fd < 0) {
+    return false;
+  }
+
+  struct stat fileStat;
+
+  if (fstat (fd, &fileStat) != 0) {
+    ::close (fd);
+    return false;
+  }
+
+  if (fileStat.st_size == 0) {
+    ::close (fd);
+    opened = true;
+    return true;
+  }
+
+  void* address = mmap (nullptr, (size_t) fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close (fd); // The mapping keeps the file open
+
+  if (address == MAP_FAILED) {
+    return false;
+  }
+
+  // The file is read once from the start to the end.
+  madvise (address, (size_t) fileStat.st_size, MADV_SEQUENTIAL);
+
+  mapping = address;
+  mappingLength = (size_t) fileStat.st_size;
+  set ((const char*) mapping, mappingLength);
+  opened = true;
+  return true;
+}
+
+//======================================================================================//
+/**
+ * @brief Unmaps the file.
+ * 
+ */
+void NMEA_Mapped_File:: close() {
+  if (mapping != nullptr) {
+    munmap (mapping, mappingLength);
+    mapping = nullptr;
+    mappingLength = 0;
+  }
+
+  opened = false;
+  set (nullptr, 0);
+}
+
+//======================================================================================//
+/**
+ * @brief Checks if a file is open.
+ * 
+ * @return true A file is open.
+ * @return false No file is open.
+ */
+bool NMEA_Mapped_File:: isOpen() const {
+  return opened;
+}
+#endif
+
+//======================================================================================//
+/**
+ * @brief The schema of the generic data object that parses the sentences that have no data
+ * object of their own. The empty type matches any sentence ID, and any number of fields
+ * up to the maximum is accepted.
+ * 
+ */
+static const NMEA_Schema_Info NMEA_Generic_Info = {"", "Any NMEA sentence", "", nullptr, CONST_MAX_NMEA_FIELDS_COUNT, 2};
+
+//======================================================================================//
+/**
+ * @brief Construct a new CSE_GNSS object with a plain Stream as the GNSS byte source, such
+ * as an NMEA_Memory_Source or a USB serial port. The stream is not started by begin(),
+ * but the debug port is started if a non-zero baudrate is provided. The serial ports are
+ * handled by the template constructor in the header.
+ * 
+ * @param gnssSerial The byte source of the GNSS data.
+ * @param debugSerial Hardware serial port for debug messages.
+ * @param gnssBaud Not used, since the stream has no begin(). Optional. Default is 0.
+ * @param debugBaud Baud rate for debug messages. Optional. Default is 0.
+ * @return CSE_GNSS:: 
+ */
+CSE_GNSS:: CSE_GNSS (Stream* gnssSerial, HardwareSerial* debugSerial, uint64_t gnssBaud, uint64_t debugBaud) :
+  CSE_GNSS (gnssSerial, nullptr, debugSerial, gnssBaud, debugBaud) {
+}
+
+//======================================================================================//
+/**
+ * @brief Construct a new CSE_GNSS object. All the other constructors end up here. The
+ * baudrates are optional. The ports will be initialized only if a non-zero baudrate is
+ * provided. So for manual port initialization, you can provide 0 for the baudrates.
+ * 
+ * @param gnssSerial The serial port or other byte source of the GNSS module.
+ * @param gnssBegin The function that starts the GNSS port. nullptr if it has no begin().
+ * @param debugSerial Hardware serial port for debug messages.
+ * @param gnssBaud Baud rate for the GNSS module.
+ * @param debugBaud Baud rate for debug messages.
+ * @return CSE_GNSS:: 
+ */
+CSE_GNSS:: CSE_GNSS (Stream* gnssSerial, NMEA_Port_Begin gnssBegin, HardwareSerial* debugSerial, uint64_t gnssBaud, uint64_t debugBaud) :
+  genericData ("", &NMEA_Generic_Info) {
+  GNSS_Serial = gnssSerial;
+  this->gnssBegin = gnssBegin;
+  Debug_Serial = debugSerial;
+  this->gnssBaud = gnssBaud;
+  this->debugBaud = debugBaud;
+
+  // The dummy data object is shared by all the CSE_GNSS objects and is allocated statically.
+  static String NMEA_Sample = "$DUMMY,120556.096,V,123.456,N,123.456,E,1.23,123.45,020723,1.9,W,N,V*33";
+  static String NMEA_Data_Names [] = {"Header", "UTC", "Status", "Latitude", "Latitude Direction", "Longitude", "Longitude Direction", "Speed", "Course", "Date", "Mag Variation", "Mag Variation Direction", "Mode", "Second Mode", "Checksum"};
+  static String NMEA_Description = "You forgot to add NMEA_0183_Data objects. Please add at least one.";
+  static NMEA_0183_Data NMEA_Dummy ("DUMMY", NMEA_Description, 15, NMEA_Data_Names, NMEA_Sample);
+
+  dummyData = &NMEA_Dummy;
+  dummyData->GNSS_Parent = this;
+  genericData.GNSS_Parent = this;
+  handler = nullptr;
+  handlerContext = nullptr;
+  epoch = nullptr;
+  satelliteTable = nullptr;
+  timeSync = nullptr;
+  waitPrefix = nullptr;
+  waitMatched = false;
+  startTime = 0;
+  firstSentenceTime = 0;
+  firstSentenceSeen = false;
+  filterMode = FILTER_NONE;
+  filterTypes = nullptr;
+  filterTypeCount = 0;
+  inited = false;
+  dataCount = 0;
+  extracting = false;
+  logLevel = CSE_GNSS_LOG_LEVEL;
+  framer.setHandler (onSentence, this);
+  demux.setNmeaFramer (&framer);
+  resetStats();
+
+  for (int i = 0; i < CONST_DISPATCH_TABLE_SIZE; i++) {
+    dispatchTable [i] = nullptr;
+    dispatchKeys [i] = 0;
+  }
+}
+
+//======================================================================================//
+/**
+ * @brief Initializes the GNSS module serial port. You should have already set the baudrate
+ * and the serial port before calling this function.
+ * 
+ * By default the port is not initialized as the default value of gnssBaud and debugBaud is 0.
+ * The serial ports will only be initialized if a non-zero value is set for the baudrates.
+ * 
+ * Regardless of how you initialize the serial port, it is important to call this function
+ * to let the library know that the port was initialized.
+ * 
+ * @param layout The CSE_GNSS_LAYOUT of the caller. Leave it as the default.
+ * @return true GNSS initialization was successful.
+ * @return false GNSS initialization failed, or the CONST_* macros of the caller are not the
+ * same as the ones the library was built with.
+ */
+bool CSE_GNSS:: begin (uint32_t layout) {
+  // The members can be at other offsets for the caller, so none of them is touched.
+  if (layout != CSE_GNSS_LAYOUT) {
+    return false;
+  }
+
+  if (!inited) {
+    if ((gnssBaud != 0) && (gnssBegin != nullptr)) {
+      gnssBegin (GNSS_Serial, gnssBaud);
+    }
+
+    if (debugBaud != 0) {
+      Debug_Serial->begin (debugBaud);
+    }
+
+    startTime = millis();
+    firstSentenceSeen = false;
+  }
+  inited = true;
+  return true;
+}
+
+//======================================================================================//
+/**
+ * @brief Reads a specified number of bytes from the GNSS module. The read bytes will be
+ * saved to the `gnssDataBuffer`. `gnssDataBufferLength` will hold the number of valid
+ * data bytes in the buffer. Only that much data must be read for further processing.
+ * Returns the number of bytes read at the end.
+ * 
+ * @param byteCount The number of bytes to read.
+ * @return uint16_t The number of bytes read.
+ */
+uint16_t CSE_GNSS:: read (int byteCount) {
+  if (!inited) {
+    CSE_GNSS_LOG_ERROR (this, "CSE_GNSS read(): GNSS module serial port is not initialized.");
+    return 0;
+  }
+
+  if ((byteCount <= 0) || (byteCount > (CONST_SERIAL_BUFFER_LENGTH - 1))) { // Check if the byte count is valid.
+    CSE_GNSS_LOG_ERROR (this, "CSE_GNSS read(): Invalid byte count.");
+    return 0;
+  }
+
+  gnssDataBufferLength = GNSS_Serial->readBytes (gnssDataBuffer, byteCount); // Read the bytes from the serial port.
+
+  #if CSE_GNSS_STATS_ENABLED
+    if (gnssDataBufferLength < byteCount) {
+      stats.shortReadCount++;
+    }
+
+    if (gnssDataBufferLength > stats.readHighWater) {
+      stats.readHighWater = gnssDataBufferLength;
+    }
+
+    if (gnssDataBufferLength > 0) {
+      stats.lastByteTime = millis();
+    }
+  #endif
+  // gnssDataBuffer [byteCount] = 0; // Null terminate the buffer so that it becomes a proper c-string (if used for character communication).
+
+  CSE_GNSS_LOG_DEBUG (this, "CSE_GNSS read(): Read ", gnssDataBufferLength, " bytes from GNSS module.");
+
+  // return String (gnssDataBuffer, gnssDataBufferLength);
+  return gnssDataBufferLength;
+}
+
+
+//======================================================================================//
+/**
+ * @brief Converts the contents of the `nmeaDataBuffer` to a String object.
+ * 
+ * @return String The converted string.
+ */
+String CSE_GNSS:: getNmeaDataString() {
+  // nmeaDataBuffer [nmeaDataBufferLength] = 0;
+  return String (nmeaDataBuffer, nmeaDataBufferLength);
+}
+
+//======================================================================================//
+/**
+ * @brief Extracts NMEA sentences from the GNSS data buffer. This removes any redundant
+ * or unsupported data from the buffer. This can include mixed protocol messages, non-printable
+ * chracters, etc. Valid NMEA sentences will be read and added to the buffer with each line
+ * ending a single newline character (LF).
+ * 
+ * The bytes are passed through the demultiplexer, which keeps its state between the calls.
+ * So a sentence that was cut at the end of the previous read() is completed here instead of
+ * being lost. The UBX and RTCM frames in the buffer go to their framers, if set.
+ * 
+ * @return uint16_t The number of valid bytes in the NMEA data buffer.
+ */
+uint16_t CSE_GNSS:: extractNMEA() {
+  CSE_GNSS_LOG_DEBUG (this, "CSE_GNSS extractNMEA(): Extracting NMEA lines.. GNSS data buffer length is ", gnssDataBufferLength);
+
+  #if CSE_GNSS_STATS_LATENCY
+    uint32_t startTime = CSE_GNSS_STATS_CLOCK();
+  #endif
+
+  nmeaDataBufferLength = 0;
+  extracting = true;
+  demux.feed ((const uint8_t*) gnssDataBuffer, gnssDataBufferLength);
+  extracting = false;
+
+  #if CSE_GNSS_STATS_LATENCY
+    stats.framing.add (CSE_GNSS_STATS_CLOCK() - startTime);
+  #endif
+
+  #if CSE_GNSS_STATS_ENABLED
+    if (nmeaDataBufferLength > stats.nmeaBufferHighWater) {
+      stats.nmeaBufferHighWater = nmeaDataBufferLength;
+    }
+  #endif
+
+  CSE_GNSS_LOG_DEBUG (this, "CSE_GNSS extractNMEA(): Extracted ", nmeaDataBufferLength, " characters.");
+
+  return nmeaDataBufferLength;
+}
+
+//======================================================================================//
+/**
+ * @brief Feeds a single byte to the NMEA framer. Complete sentences are sent to the
+ * matching NMEA_0183_Data object in the dataList, which is then parsed. If a UBX or an
+ * RTCM framer is set, the byte goes through the demultiplexer instead.
+ * 
+ * @param c The byte to feed.
+ * @return uint16_t The number of sentences completed (0 or 1).
+ */
+uint16_t CSE_GNSS:: feed (char c) {
+  uint32_t sentenceCount = framer.getSentenceCount();
+  demux.feed ((uint8_t) c);
+  return framer.getSentenceCount() - sentenceCount;
+}
+
+//======================================================================================//
+/**
+ * @brief Feeds a chunk of bytes to the NMEA framer. The chunk can be of any size and does
+ * not have to be aligned with the sentences. The bytes are split between the NMEA framer
+ * and the UBX and RTCM framers, if set, in a single pass.
+ * 
+ * @param data The bytes to feed.
+ * @param length The number of bytes.
+ * @return uint16_t The number of sentences completed.
+ */
+uint16_t CSE_GNSS:: feed (const char* data, size_t length) {
+  uint32_t sentenceCount = framer.getSentenceCount();
+
+  #if CSE_GNSS_STATS_LATENCY
+    uint32_t startTime = CSE_GNSS_STATS_CLOCK();
+  #endif
+
+  demux.feed ((const uint8_t*) data, length);
+
+  #if CSE_GNSS_STATS_LATENCY
+    stats.framing.add (CSE_GNSS_STATS_CLOCK() - startTime);
+  #endif
+
+  #if CSE_GNSS_STATS_ENABLED
+    if (length > 0) {
+      stats.lastByteTime = millis();
+    }
+  #endif
+
+  return framer.getSentenceCount() - sentenceCount;
+}
+
+//======================================================================================//
+/**
+ * @brief Feeds all the bytes that are currently available in the GNSS serial port to the
+ * framer. This does not wait for more data, so it can be called from the loop as often
+ * as needed.
+ * 
+ * @return uint16_t The number of sentences completed.
+ */
+uint16_t CSE_GNSS:: update() {
+  if (!inited) {
+    CSE_GNSS_LOG_ERROR (this, "CSE_GNSS update(): GNSS module serial port is not initialized.");
+    return 0;
+  }
+
+  uint16_t sentenceCount = 0;
+  int byteCount = GNSS_Serial->available(); // Only read what is already there.
+
+  if (byteCount <= 0) {
+    return 0;
+  }
+
+  #if CSE_GNSS_STATS_ENABLED
+    // A high-water mark close to the receive buffer size of the port means bytes are being lost.
+    if ((uint16_t) byteCount > stats.availableHighWater) {
+      stats.availableHighWater = byteCount;
+    }
+
+    stats.lastByteTime = millis();
+  #endif
+
+  #if CSE_GNSS_STATS_LATENCY
+    uint32_t startTime = CSE_GNSS_STATS_CLOCK();
+  #endif
+
+  while (byteCount-- > 0) {
+    int c = GNSS_Serial->read();
+
+    if (c < 0) {
+      break;
+    }
+
+    if (feed ((char) c)) {
+      sentenceCount++;
+    }
+  }
+
+  #if CSE_GNSS_STATS_LATENCY
+    stats.framing.add (CSE_GNSS_STATS_CLOCK() - startTime);
+  #endif
+
+  return sentenceCount;
+}
+
+//======================================================================================//
+/**
+ * @brief Receives the sentences from the framer. During extractNMEA(), the sentences are
+ * saved to the `nmeaDataBuffer`. Otherwise they are dispatched to the data objects.
+ * 
+ * @param sentence The complete sentence.
+ * @param length The length of the sentence.
+ * @param context The CSE_GNSS object.
+ */
+void CSE_GNSS:: onSentence (const char* sentence, uint16_t length, void* context) {
+  CSE_GNSS* gnss = static_cast <CSE_GNSS*> (context);
+
+  if (!gnss->firstSentenceSeen) {
+    gnss->firstSentenceTime = millis() - gnss->startTime;
+    gnss->firstSentenceSeen = true;
+  }
+
+  #if CSE_GNSS_STATS_ENABLED
+    gnss->stats.typeCounts [GNSS_Stats::getType (sentence, length)]++;
+    gnss->stats.lastSentenceTime = millis();
+
+    if (length > gnss->stats.sentenceHighWater) {
+      gnss->stats.sentenceHighWater = length;
+    }
+  #endif
+
+  if (gnss->timeSync != nullptr) {
+    gnss->syncTime (sentence, length);
+  }
+
+  if ((gnss->waitPrefix != nullptr) && !gnss->waitMatched) {
+    size_t prefixLength = strlen (gnss->waitPrefix);
+    gnss->waitMatched = (prefixLength <= length) && (memcmp (sentence, gnss->waitPrefix, prefixLength) == 0);
+  }
+
+  if (!gnss->extracting) {
+    #if CSE_GNSS_STATS_LATENCY
+      uint32_t startTime = CSE_GNSS_STATS_CLOCK();
+      gnss->dispatchSentence (sentence, length);
+      gnss->stats.parsing.add (CSE_GNSS_STATS_CLOCK() - startTime);
+    #else
+      gnss->dispatchSentence (sentence, length);
+    #endif
+    return;
+  }
+
+  // Only the GNSS talker sentences ($G...) are saved to the buffer.
+  if (sentence [1] != 'G') {
+    return;
+  }
+
+  if ((gnss->nmeaDataBufferLength + length + 1) > CONST_SERIAL_BUFFER_LENGTH) {
+    CSE_GNSS_LOG_WARN (gnss, "CSE_GNSS extractNMEA(): NMEA data buffer is full.");
+    return;
+  }
+
+  memcpy (gnss->nmeaDataBuffer + gnss->nmeaDataBufferLength, sentence, length);
+  gnss->nmeaDataBufferLength += length;
+  gnss->nmeaDataBuffer [gnss->nmeaDataBufferLength++] = '\n';
+}
+
+//======================================================================================//
+/**
+ * @brief Packs a sentence ID (talker + type, eg. "GNRMC") into a 32-bit key. Each of the
+ * first 5 characters takes 6 bits, so the key is unique for IDs of up to 5 characters.
+ * Longer IDs, like the proprietary ones, share the key with the IDs that have the same
+ * first 5 characters and are told apart by comparing the names.
+ * 
+ * @param id The sentence ID, without the '$'.
+ * @param length The number of characters in the ID.
+ * @return uint32_t The key.
+ */
+uint32_t CSE_GNSS:: getSentenceKey (const char* id, uint8_t length) {
+  uint32_t key = 0;
+
+  for (uint8_t i = 0; i < 5; i++) {
+    key <<= 6;
+
+    if (i < length) {
+      key |= ((uint8_t) id [i] - 0x20) & 0x3F;
+    }
+  }
+
+  return key;
+}
+
+//======================================================================================//
+/**
+ * @brief Returns the first slot of the dispatch table to look for the key. The key is
+ * spread with a multiplicative (Fibonacci) hash and the top bits are used.
+ * 
+ * @param key The sentence key.
+ * @return uint8_t The slot index.
+ */
+uint8_t CSE_GNSS:: getDispatchSlot (uint32_t key) {
+  return (uint8_t) (((key * 2654435761UL) >> 24) & (CONST_DISPATCH_TABLE_SIZE - 1));
+}
+
+//======================================================================================//
+/**
+ * @brief Finds the data object registered for the given sentence ID. The table is probed
+ * linearly from the hashed slot until an empty slot is found, so the cost does not depend
+ * on how many objects are registered.
+ * 
+ * @param id The sentence ID, without the '$'.
+ * @param length The number of characters in the ID.
+ * @return NMEA_0183_Data* The data object. nullptr if not found.
+ */
+NMEA_0183_Data* CSE_GNSS:: findData (const char* id, uint8_t length) {
+  uint32_t key = getSentenceKey (id, length);
+  uint8_t slot = getDispatchSlot (key);
+
+  for (int i = 0; i < CONST_DISPATCH_TABLE_SIZE; i++) {
+    NMEA_0183_Data* data = dispatchTable [slot];
+
+    if (data == nullptr) {
+      return nullptr;
+    }
+
+    if ((dispatchKeys [slot] == key) && (data->name.length() == length) && (strncmp (data->name.c_str(), id, length) == 0)) {
+      return data;
+    }
+
+    slot = (slot + 1) & (CONST_DISPATCH_TABLE_SIZE - 1);
+  }
+
+  return nullptr;
+}
+
+//======================================================================================//
+/**
+ * @brief Sends the sentence to the NMEA_0183_Data object with the same name as the sentence
+ * header and parses it. The object is found with a single hash table lookup. Sentences
+ * without a matching object are ignored, unless they are needed by the catch-all handler, the
+ * epoch or the satellite table.
+ * 
+ * @param sentence The complete sentence starting with '$'.
+ * @param length The length of the sentence.
+ */
+void CSE_GNSS:: dispatchSentence (const char* sentence, uint16_t length) {
+  uint8_t idLength = 0;
+
+  // The ID ends at the first comma.
+  while (((idLength + 1) < length) && (idLength < 255) && (sentence [idLength + 1] != ',') && (sentence [idLength + 1] != '*')) {
+    idLength++;
+  }
+
+  NMEA_0183_Data* data = findData (sentence + 1, idLength);
+
+  // The sentences without a data object are only parsed if there is a catch-all handler,
+  // an epoch assembler or a satellite table.
+  if (data == nullptr) {
+    if ((handler == nullptr) && (epoch == nullptr) && (satelliteTable == nullptr)) {
+      return;
+    }
+
+    data = &genericData;
+  }
+
+  data->set (sentence, length, true);
+  data->arrivalTime = framer.getSentenceTime();
+
+  if (!data->parse()) {
+    return;
+  }
+
+  if (epoch != nullptr) {
+    epoch->add (*data);
+  }
+
+  if (satelliteTable != nullptr) {
+    satelliteTable->add (*data);
+  }
+
+  // The sentences in which only the ignored fields changed skip the handlers.
+  if ((data->changeTracker != nullptr) && !data->changeTracker->isChanged()) {
+    return;
+  }
+
+  if (data->handler != nullptr) {
+    data->handler (*data, data->handlerContext);
+  }
+
+  if (handler != nullptr) {
+    handler (*data, handlerContext);
+  }
+}
+
+//======================================================================================//
+/**
+ * @brief Add a new NMEA_0183_Data object to the data list on the fly and returns the
+ * number of data objects in the list currently. The object is also added to the dispatch
+ * table, so that the sentences received through feed() and update() are sent to it.
+ * 
+ * @param data The reference of the NMEA_0183_Data object to be added.
+ * @return int The number of data objects in the list currently.
+ */
+int CSE_GNSS:: addData (NMEA_0183_Data* data) {
+  if (dataCount >= CONST_MAX_NMEA_DATA_COUNT) {
+    CSE_GNSS_LOG_ERROR (this, "CSE_GNSS addData(): Data list is full.");
+    return dataCount;
+  }
+
+  dataList [dataCount] = data;
+  dataList [dataCount]->GNSS_Parent = this;  // Set parent GNSS object.
+  dataCount++;
+
+  uint32_t key = getSentenceKey (data->name.c_str(), data->name.length());
+  uint8_t slot = getDispatchSlot (key);
+
+  while (dispatchTable [slot] != nullptr) {
+    slot = (slot + 1) & (CONST_DISPATCH_TABLE_SIZE - 1);
+  }
+
+  dispatchTable [slot] = data;
+  dispatchKeys [slot] = key;
+
+  return dataCount;
+}
+
+//======================================================================================//
+/**
+ * @brief Returns the reference to the NMEA_0183_Data object with the given name. If no
+ * data with the given name is found, a dummy data is returned.
+ * 
+ * @param name The name of the NMEA_0183_Data object. For example, "GPRMC".
+ * @return CSE_GNSS::NMEA_0183_Data_Ref 
+ */
+CSE_GNSS::NMEA_0183_Data_Ref CSE_GNSS:: getDataRef (String name) {
+  NMEA_0183_Data* data = findData (name.c_str(), name.length());
+
+  if (data == nullptr) {
+    dummyData->GNSS_Parent = this;
+    return *dummyData;
+  }
+
+  return *data;
+}
+
+//======================================================================================//
+/**
+ * @brief Returns the reference to the NMEA_0183_Data object at the given index. The index
+ * should be from 0 to dataCount - 1.
+ * 
+ * @param index The index of the NMEA_0183_Data object in the list. Index starts at 0.
+ * @return CSE_GNSS::NMEA_0183_Data_Ref 
+ */
+CSE_GNSS::NMEA_0183_Data_Ref CSE_GNSS:: getDataRef (int index) {
+  if ((index >= 0) && (index < dataCount)) {
+    return *dataList [index];
+  }
+
+  dummyData->GNSS_Parent = this;
+  return *dummyData;
+}
+
+//======================================================================================//
+/**
+ * @brief Returns the number of NMEA_0183_Data objects in the list.
+ * 
+ * @return int 
+ */
+int CSE_GNSS:: getDataCount() {
+  return dataCount;
+}
+
+//======================================================================================//
+/**
+ * @brief Sets the runtime log level. Only the messages that are at or below both this level
+ * and the compile-time CSE_GNSS_LOG_LEVEL are printed. Raising the level above
+ * CSE_GNSS_LOG_LEVEL has no effect, since those messages are not compiled in.
+ * 
+ * @param level One of the CSE_GNSS_LOG_LEVEL_* values.
+ */
+void CSE_GNSS:: setLogLevel (uint8_t level) {
+  logLevel = level;
+}
+
+//======================================================================================//
+/**
+ * @brief Returns the runtime log level.
+ * 
+ * @return uint8_t One of the CSE_GNSS_LOG_LEVEL_* values.
+ */
+uint8_t CSE_GNSS:: getLogLevel() const {
+  return logLevel;
+}
+
+//======================================================================================//
+/**
+ * @brief Sets a catch-all function that is called for every sentence received through
+ * feed() or update(), after the handler of its data object, if any. The sentences that have
+ * no data object are parsed into an internal generic object, so their fields can still be
+ * read with getField(). Use getField (0) to get the sentence ID.
+ * 
+ * @param handler The handler function. nullptr to remove.
+ * @param context A user pointer passed to the handler.
+ */
+void CSE_GNSS:: setHandler (NMEA_Data_Handler handler, void* context) {
+  this->handler = handler;
+  handlerContext = context;
+}
+
+//======================================================================================//
+/**
+ * @brief Sets an epoch assembler that receives every sentence received through feed() or
+ * update(), before the handlers are called. The sentences that have no data object are
+ * parsed into the internal generic object, so no data objects are required.
+ * 
+ * @param epoch The epoch assembler. nullptr to remove.
+ */
+void CSE_GNSS:: setEpoch (NMEA_Epoch* epoch) {
+  this->epoch = epoch;
+}
+
+//======================================================================================//
+/**
+ * @brief Sets a satellite table that receives the GSV sentences received through feed() or
+ * update(), before the handlers are called. No GSV data objects are required.
+ * 
+ * @param table The satellite table. nullptr to remove.
+ */
+void CSE_GNSS:: setSatelliteTable (NMEA_Satellite_Table* table) {
+  satelliteTable = table;
+}
+
+//======================================================================================//
+/**
+ * @brief Sets a time sync that receives the UTC time and the arrival time of the RMC, GGA,
+ * GLL and ZDA sentences. The time field is decoded directly from the framed sentence, so
+ * no data objects are required.
+ * 
+ * @param sync The time sync. nullptr to remove.
+ */
+void CSE_GNSS:: setTimeSync (NMEA_Time_Sync* sync) {
+  timeSync = sync;
+}
+
+//======================================================================================//
+/**
+ * @brief Sets the clock that stamps the arrival of the sentences, eg. a hardware timer that
+ * also stamps the other sensors. The time is saved to the arrivalTime of the data objects.
+ * 
+ * @param clock The clock. NMEA_Framer::getTime() by default. nullptr to not stamp.
+ */
+void CSE_GNSS:: setClock (NMEA_Clock clock) {
+  framer.setClock (clock);
+}
+
+//======================================================================================//
+/**
+ * @brief Decodes the UTC time of an RMC, GGA, GLL or ZDA sentence and adds it to the time
+ * sync, together with the arrival time of the sentence. The other sentences and the ones
+ * without a time are ignored.
+ * 
+ * @param sentence The sentence, from the '$'.
+ * @param length The length of the sentence.
+ */
+void CSE_GNSS:: syncTime (const char* sentence, uint16_t length) {
+  uint8_t timeField;
+
+  switch (GNSS_Stats::getType (sentence, length)) {
+    case GNSS_Stats::TYPE_RMC:
+    case GNSS_Stats::TYPE_GGA:
+    case GNSS_Stats::TYPE_ZDA:
+      timeField = 1;
+      break;
+
+    case GNSS_Stats::TYPE_GLL:
+      timeField = 5;
+      break;
+
+    default:
+      return;
+  }
+
+  uint16_t start = 0;
+
+  for (uint8_t field = 0; field < timeField; field++) {
+    const char* comma = (const char*) memchr (sentence + start, ',', length - start);
+
+    if (comma == nullptr) {
+      return;
+    }
+
+    start = (comma - sentence) + 1;
+  }
+
+  uint16_t end = start;
+
+  while ((end < length) && (sentence [end] != ',') && (sentence [end] != '*')) {
+    end++;
+  }
+
+  NMEA_Field field = {sentence + start, (uint8_t) (end - start)};
+  uint32_t utcTime;
+
+  if (NMEA_Decoder::decodeTime (field, utcTime)) {
+    timeSync->add (utcTime, framer.getSentenceTime());
+  }
+}
+
+//======================================================================================//
+/**
+ * @brief Sends a command to the GNSS module. The checksum is added if it is not added yet.
+ * 
+ * @param command The command.
+ * @return true The command has been written to the port.
+ * @return false The port is not initialized, or the command is too long.
+ */
+bool CSE_GNSS:: send (NMEA_Command& command) {
+  if (!inited) {
+    CSE_GNSS_LOG_ERROR (this, "CSE_GNSS send(): GNSS module serial port is not initialized.");
+    return false;
+  }
+
+  if (!command.finish()) {
+    CSE_GNSS_LOG_ERROR (this, "CSE_GNSS send(): Command is too long.");
+    return false;
+  }
+
+  CSE_GNSS_LOG_DEBUG (this, "CSE_GNSS send(): ", NMEA_Field {command.getSentence(), (uint8_t) (command.getLength() - 2)});
+
+  return GNSS_Serial->write ((const uint8_t*) command.getSentence(), command.getLength()) == command.getLength();
+}
+
+//======================================================================================//
+/**
+ * @brief Sends a command given as text without the '$' and the checksum.
+ * 
+ * @param body The command, eg. "PMTK220,1000".
+ * @return true The command has been written to the port.
+ * @return false The port is not initialized, or the command is too long.
+ */
+bool CSE_GNSS:: sendCommand (const char* body) {
+  NMEA_Command command (body);
+  return send (command);
+}
+
+//======================================================================================//
+/**
+ * @brief Reads the GNSS port until a sentence that starts with the prefix is received, or
+ * until the timeout. The other sentences are still sent to the data objects and handlers.
+ * Use it to wait for the ACK of a command, eg. "$PMTK001,220,3".
+ * 
+ * @param prefix The start of the sentence, including the '$'.
+ * @param timeout The timeout in milliseconds.
+ * @return true The sentence has been received.
+ * @return false The timeout has passed.
+ */
+bool CSE_GNSS:: waitForSentence (const char* prefix, uint32_t timeout) {
+  if (!inited) {
+    CSE_GNSS_LOG_ERROR (this, "CSE_GNSS waitForSentence(): GNSS module serial port is not initialized.");
+    return false;
+  }
+
+  uint32_t startTime = millis();
+
+  waitPrefix = prefix;
+  waitMatched = false;
+
+  do {
+    update();
+  } while (!waitMatched && ((millis() - startTime) < timeout));
+
+  waitPrefix = nullptr;
+
+  if (!waitMatched) {
+    CSE_GNSS_LOG_WARN (this, "CSE_GNSS waitForSentence(): Timed out waiting for ", prefix);
+  }
+
+  return waitMatched;
+}
 
 //======================================================================================//
 /**
- * @brief NMEA_0183_Data constructor.
+ * @brief Sends a command and waits for its ACK sentence.
  * 
- * @param name The name of the NMEA sentence.eg. "GPRMC".
- * @param dataCount The number of data fields in the NMEA sentence.
- * @param sample A sample string of the NMEA sentence.
- * @return NMEA_0183_Data:: 
+ * @param command The command.
+ * @param ack The start of the ACK sentence. nullptr if the command has no ACK.
+ * @param timeout The timeout in milliseconds.
+ * @return true The command has been sent and acknowledged.
+ * @return false The command could not be sent or the ACK was not received.
  */
-NMEA_0183_Data:: NMEA_0183_Data (String name, String description, int dataCount, String dataNames[], String sample) : 
-  name (name),
-  description (description), 
-  sample (sample),
-  dataCount (dataCount) {
-    for (int i = 0; i < dataMax; i++) {
-      dataList [i] = "";
-      dataNameList [i] = "";
+bool CSE_GNSS:: sendAndWait (NMEA_Command& command, const char* ack, uint32_t timeout) {
+  if (!send (command)) {
+    return false;
+  }
+
+  return (ack == nullptr) || waitForSentence (ack, timeout);
+}
+
+//======================================================================================//
+/**
+ * @brief Turns the standard sentences on or off. Turning off the sentences that are not
+ * used saves both the serial bandwidth and the time to frame and parse them. Only the MTK
+ * receivers acknowledge the command, so the others return true once it is sent.
+ * 
+ * @param receiver The receiver family.
+ * @param mask The sentences to turn on, as NMEA_Command::SENTENCE_* bits. The others are turned off.
+ * @param timeout The timeout for the ACK in milliseconds.
+ * @return true The sentences have been set.
+ * @return false The command could not be sent or was not acknowledged.
+ */
+bool CSE_GNSS:: setSentenceMask (NMEA_Command::Receiver receiver, uint8_t mask, uint32_t timeout) {
+  NMEA_Command command;
+
+  switch (receiver) {
+    case NMEA_Command::RECEIVER_MTK:
+      // GLL, RMC, VTG, GGA, GSA, GSV, 11 reserved fields, ZDA and MCHN.
+      command.start ("PMTK314");
+      command.add ((mask & NMEA_Command::SENTENCE_GLL) ? 1 : 0).add ((mask & NMEA_Command::SENTENCE_RMC) ? 1 : 0);
+      command.add ((mask & NMEA_Command::SENTENCE_VTG) ? 1 : 0).add ((mask & NMEA_Command::SENTENCE_GGA) ? 1 : 0);
+      command.add ((mask & NMEA_Command::SENTENCE_GSA) ? 1 : 0).add ((mask & NMEA_Command::SENTENCE_GSV) ? 1 : 0);
+
+      for (uint8_t i = 0; i < 11; i++) {
+        command.add (0);
+      }
+
+      command.add ((mask & NMEA_Command::SENTENCE_ZDA) ? 1 : 0).add (0);
+      return sendAndWait (command, "$PMTK001,314,3", timeout);
+
+    case NMEA_Command::RECEIVER_UBLOX: {
+      // One PUBX,40 for each sentence, with the same rate on the I2C, UART1, UART2, USB and SPI ports.
+      static const char* const types [] = {"GGA", "GLL", "GSA", "GSV", "RMC", "VTG", "ZDA"}; // In the order of the Sentence bits
+
+      for (uint8_t i = 0; i < 7; i++) {
+        uint8_t rate = (mask & (1 << i)) ? 1 : 0;
+
+        command.start ("PUBX");
+        command.add ("40").add (types [i]).add (rate).add (rate).add (rate).add (rate).add (rate).add (0);
+
+        if (!send (command)) {
+          return false;
+        }
+      }
+
+      return true;
     }
 
-    for (int i = 0; i < dataCount; i++) {
-      dataNameList [i] = dataNames [i];
+    case NMEA_Command::RECEIVER_CASIC:
+      // GGA, GLL, GSA, GSV, RMC, VTG and ZDA. The other fields are left empty, so they are not changed.
+      command.start ("PCAS03");
+      command.add ((mask & NMEA_Command::SENTENCE_GGA) ? 1 : 0).add ((mask & NMEA_Command::SENTENCE_GLL) ? 1 : 0);
+      command.add ((mask & NMEA_Command::SENTENCE_GSA) ? 1 : 0).add ((mask & NMEA_Command::SENTENCE_GSV) ? 1 : 0);
+      command.add ((mask & NMEA_Command::SENTENCE_RMC) ? 1 : 0).add ((mask & NMEA_Command::SENTENCE_VTG) ? 1 : 0);
+      command.add ((mask & NMEA_Command::SENTENCE_ZDA) ? 1 : 0);
+
+      for (uint8_t i = 0; i < 11; i++) {
+        command.add ("");
+      }
+
+      return send (command);
+  }
+
+  return false;
+}
+
+//======================================================================================//
+/**
+ * @brief Sets the interval between the fixes, which is also the output interval of the
+ * sentences. u-blox receivers have no NMEA command for this, so a UBX CFG-RATE message is
+ * sent instead. Its ACK is binary and is only waited for if a UBX framer is set.
+ * 
+ * @param receiver The receiver family.
+ * @param interval The interval in milliseconds, eg. 1000 for 1 Hz or 200 for 5 Hz.
+ * @param timeout The timeout for the ACK in milliseconds. CASIC receivers do not send one.
+ * @return true The rate has been set.
+ * @return false The command could not be sent or was not acknowledged.
+ */
+bool CSE_GNSS:: setOutputRate (NMEA_Command::Receiver receiver, uint16_t interval, uint32_t timeout) {
+  NMEA_Command command;
+
+  switch (receiver) {
+    case NMEA_Command::RECEIVER_MTK:
+      command.start ("PMTK220");
+      command.add (interval);
+      return sendAndWait (command, "$PMTK001,220,3", timeout);
+
+    case NMEA_Command::RECEIVER_UBLOX: {
+      // UBX CFG-RATE: measurement rate, 1 measurement per fix, GPS time reference.
+      uint8_t payload [6] = {(uint8_t) interval, (uint8_t) (interval >> 8), 1, 0, 1, 0};
+
+      if (!sendUbx (0x06, 0x08, payload, sizeof (payload))) {
+        return false;
+      }
+
+      return (demux.getUbxFramer() == nullptr) || waitForUbxAck (0x06, 0x08, timeout);
     }
+
+    case NMEA_Command::RECEIVER_CASIC:
+      command.start ("PCAS02");
+      command.add (interval);
+      return send (command);
+  }
+
+  return false;
 }
 
 //======================================================================================//
 /**
- * @brief Parse/extract the data from the NMEA sentence. The sentence has to be set first
- * with the set() function.
+ * @brief Changes the baudrate of the GNSS module, and then starts the GNSS port again at
+ * the new baudrate. The change is confirmed by receiving any valid sentence at the new
+ * baudrate. The port must have been given with its type, so that it can be started again.
  * 
- * @return true If parsing was successful.
- * @return false If parsing was not successful.
+ * @param receiver The receiver family.
+ * @param baud The new baudrate. CASIC receivers support 4800 to 115200.
+ * @param timeout The timeout for a sentence at the new baudrate in milliseconds.
+ * @return true The module is sending at the new baudrate.
+ * @return false The baudrate is not supported, the port cannot be started again or no
+ * sentence was received at the new baudrate.
  */
-bool NMEA_0183_Data:: parse() {
-  // Check if the NMEA sentence is valid.
-  if (check (sentence) == false) {
-    GNSS_Parent->Debug_Serial->print ("NMEA_0183_Data parse(): ");
-    GNSS_Parent->Debug_Serial->println ("Invalid NMEA sentence.");
+bool CSE_GNSS:: setReceiverBaud (NMEA_Command::Receiver receiver, uint32_t baud, uint32_t timeout) {
+  if (gnssBegin == nullptr) {
+    CSE_GNSS_LOG_ERROR (this, "CSE_GNSS setReceiverBaud(): The GNSS port cannot be started again.");
     return false;
   }
-  
-  GNSS_Parent->Debug_Serial->print ("NMEA_0183_Data parse(): ");
-  GNSS_Parent->Debug_Serial->println (sentence);
 
-  int startIndex = 0;
-  int dataIndex = 0;
+  NMEA_Command command;
 
-  while (startIndex < sentence.length()) {
-    int commaIndex = sentence.indexOf (',', startIndex);
-    int asteriskIndex = sentence.indexOf ('*', startIndex);
+  switch (receiver) {
+    case NMEA_Command::RECEIVER_MTK:
+      command.start ("PMTK251");
+      command.add (baud);
+      break;
+
+    case NMEA_Command::RECEIVER_UBLOX:
+      // UART1, UBX + NMEA + RTCM in, UBX + NMEA out, no autobauding.
+      command.start ("PUBX");
+      command.add ("41").add ("1").add ("0007").add ("0003").add (baud).add (0);
+      break;
+
+    case NMEA_Command::RECEIVER_CASIC: {
+      static const uint32_t baudrates [] = {4800, 9600, 19200, 38400, 57600, 115200};
+      int8_t code = -1;
+
+      for (uint8_t i = 0; i < 6; i++) {
+        if (baudrates [i] == baud) {
+          code = i;
+        }
+      }
+
+      if (code < 0) {
+        CSE_GNSS_LOG_ERROR (this, "CSE_GNSS setReceiverBaud(): Baudrate is not supported by the receiver.");
+        return false;
+      }
+
+      command.start ("PCAS01");
+      command.add (code);
+      break;
+    }
+
+    default:
+      return false;
+  }
+
+  if (!send (command)) {
+    return false;
+  }
+
+  // Let the command go out at the old baudrate before the port is changed.
+  GNSS_Serial->flush();
+  delay (100);
+
+  gnssBaud = baud;
+  gnssBegin (GNSS_Serial, baud);
+  demux.reset();
+
+  return waitForSentence ("$", timeout);
+}
+
+//======================================================================================//
+/**
+ * @brief Finds the baudrate that the GNSS module is sending at, and starts the port at it.
+ * The current baudrate is tried first, and then the standard baudrates from 4800 to 230400.
+ * Each baudrate is scored by the number of sentences with a valid checksum received within
+ * the window, since the bytes received at a wrong baudrate almost never form one. The search
+ * stops at the first baudrate that reaches CONST_AUTO_BAUD_LOCK_COUNT sentences, so it takes
+ * at most 8 windows. Otherwise the baudrate with the most sentences is used. Call begin()
+ * before this, so that the debug port is started.
+ * 
+ * The window must be longer than the output interval of the module. The default is enough
+ * for 1 Hz.
+ * 
+ * @param window The time to listen at each baudrate, in milliseconds.
+ * @return uint32_t The detected baudrate. 0 if no valid sentence was received.
+ */
+uint32_t CSE_GNSS:: detectBaud (uint32_t window) {
+  if (gnssBegin == nullptr) {
+    CSE_GNSS_LOG_ERROR (this, "CSE_GNSS detectBaud(): The GNSS port cannot be started again.");
+    return 0;
+  }
+
+  // In the order of how common they are as the default of the modules.
+  static const uint32_t baudrates [] = {9600, 115200, 38400, 57600, 19200, 4800, 230400};
+
+  uint32_t detectStart = millis();
+  uint32_t bestBaud = 0;
+  uint32_t bestScore = 0;
+  uint32_t bestFirstTime = 0;
+  uint32_t lastBaud = 0;
+
+  for (uint8_t i = 0; i <= (sizeof (baudrates) / sizeof (baudrates [0])); i++) {
+    uint32_t baud = (i == 0) ? (uint32_t) gnssBaud : baudrates [i - 1];
 
-    if ((commaIndex == -1) && (asteriskIndex == -1)) {  // no more commas or asterisks found
-      dataList [dataIndex++] = sentence.substring (startIndex);
-      startIndex = sentence.length();  // stop the loop
+    // The current baudrate is tried only once.
+    if ((baud == 0) || ((i > 0) && (baud == gnssBaud))) {
+      continue;
+    }
+
+    NMEA_Framer probe;
+    uint32_t firstTime = 0;
+
+    gnssBegin (GNSS_Serial, baud);
+    lastBaud = baud;
+
+    // Drop the bytes received at the previous baudrate. The bytes already waiting at the
+    // current baudrate are valid, and are the quickest way to lock on it.
+    if (i > 0) {
+      for (int pending = GNSS_Serial->available(); pending > 0; pending--) {
+        GNSS_Serial->read();
+      }
+    }
+
+    uint32_t windowStart = millis();
+
+    while ((probe.getSentenceCount() < CONST_AUTO_BAUD_LOCK_COUNT) && ((millis() - windowStart) < window)) {
+      if ((GNSS_Serial->available() > 0) && probe.feed ((char) GNSS_Serial->read()) && (probe.getSentenceCount() == 1)) {
+        firstTime = millis() - detectStart;
+      }
     }
-    else if ((commaIndex != -1) && ((commaIndex < asteriskIndex) || (asteriskIndex == -1))) {
-      dataList [dataIndex++] = sentence.substring (startIndex, commaIndex);
-      startIndex = commaIndex + 1;  // move past the comma
+
+    CSE_GNSS_LOG_DEBUG (this, "CSE_GNSS detectBaud(): ", baud, " baud, ", probe.getSentenceCount(), " sentences, ", probe.getChecksumErrorCount(), " checksum errors.");
+
+    if (probe.getSentenceCount() > bestScore) {
+      bestBaud = baud;
+      bestScore = probe.getSentenceCount();
+      bestFirstTime = firstTime;
     }
-    else if ((asteriskIndex != -1) && ((asteriskIndex < commaIndex) || (commaIndex == -1))) {
-      // Extract the data before the asterisk
-      dataList [dataIndex++] = sentence.substring (startIndex, asteriskIndex);
-      // Extract the checksum after the asterisk
-      dataList [dataIndex++] = sentence.substring (asteriskIndex + 1);
-      startIndex = sentence.length();  // stop the loop
+
+    if (bestScore >= CONST_AUTO_BAUD_LOCK_COUNT) {
+      break;
     }
   }
 
-  GNSS_Parent->Debug_Serial->println ("NMEA_0183_Data parse(): Completed.");
-  return true;
+  if (bestBaud == 0) {
+    CSE_GNSS_LOG_WARN (this, "CSE_GNSS detectBaud(): No valid sentence was received at any baudrate.");
+
+    if ((gnssBaud != 0) && (lastBaud != gnssBaud)) {
+      gnssBegin (GNSS_Serial, gnssBaud);
+    }
+
+    return 0;
+  }
+
+  if (lastBaud != bestBaud) {
+    gnssBegin (GNSS_Serial, bestBaud);
+  }
+
+  CSE_GNSS_LOG_INFO (this, "CSE_GNSS detectBaud(): Locked on ", bestBaud, " baud.");
+
+  gnssBaud = bestBaud;
+  demux.reset();
+  inited = true;
+  startTime = detectStart;
+  firstSentenceTime = bestFirstTime;
+  firstSentenceSeen = true;
+
+  return bestBaud;
 }
 
 //======================================================================================//
 /**
- * @brief Set the NMEA sentence.
+ * @brief Returns the baudrate of the GNSS port, as given to the constructor or set by
+ * setReceiverBaud() or detectBaud().
  * 
- * @param line A valid NMEA sentence. Not checked for validity.
- * @return true If setting was successful.
- * @return false If setting was not successful.
+ * @return uint32_t The baudrate. 0 if the port is started by the application.
  */
-bool NMEA_0183_Data:: set (String line) {
-  GNSS_Parent->Debug_Serial->print ("NMEA_0183_Data set(): ");
-  GNSS_Parent->Debug_Serial->println (line);
-  sentence = line;
-  return true;
+uint32_t CSE_GNSS:: getBaud() const {
+  return (uint32_t) gnssBaud;
 }
 
 //======================================================================================//
 /**
- * @brief Prints the GNSS data saved in the object.
+ * @brief Returns the time from begin() or the start of detectBaud() to the first valid
+ * sentence. It measures how long the library takes to get in sync with the module after a
+ * power up or a reset.
  * 
- * @return true 
- * @return false 
+ * @return int32_t The time in milliseconds. -1 if no valid sentence has been received yet.
  */
-bool NMEA_0183_Data:: print() {
-  GNSS_Parent->Debug_Serial->println ("NMEA_0183_Data print(): ");
+int32_t CSE_GNSS:: getFirstSentenceTime() const {
+  return firstSentenceSeen ? (int32_t) firstSentenceTime : -1;
+}
 
-  GNSS_Parent->Debug_Serial->print (name);
-  GNSS_Parent->Debug_Serial->print (": ");
-  GNSS_Parent->Debug_Serial->println (description);
-  GNSS_Parent->Debug_Serial->print ("  ");
+//======================================================================================//
+/**
+ * @brief Sets a filter that drops the unwanted sentences while they are being framed. A
+ * sentence is checked as soon as its first 6 characters (eg. "$GPGSV") are received. A
+ * rejected sentence is not copied any further, so it takes no space in the `nmeaDataBuffer`
+ * of extractNMEA() and no time to checksum and parse.
+ * 
+ * The entries of the list are either a 3 letter type, such as "GSV", which matches all the
+ * talkers, or a sentence ID, such as "GPGSV" or "PMTK001". IDs longer than 5 characters are
+ * matched by their first 5 characters. All the sentences are kept while waitForSentence()
+ * is waiting, so that the ACKs are never dropped. FILTER_REGISTERED keeps all the sentences
+ * while the catch-all handler of setHandler() is set.
+ * 
+ * @param mode One of the Filter_Mode values.
+ * @param types The allow or deny list. The array and the strings are not copied and must
+ * stay valid. Not used with FILTER_NONE and FILTER_REGISTERED.
+ * @param count The number of entries in the list.
+ */
+void CSE_GNSS:: setFilter (Filter_Mode mode, const char* const* types, uint8_t count) {
+  filterMode = mode;
+  filterTypes = types;
+  filterTypeCount = (types != nullptr) ? count : 0;
 
-  for (int i = 0; i < dataCount; i++) {
-    GNSS_Parent->Debug_Serial->print (dataNameList [i]);
-    GNSS_Parent->Debug_Serial->print (": ");
-    GNSS_Parent->Debug_Serial->println (dataList [i]);
-    GNSS_Parent->Debug_Serial->print ("  ");
+  if (mode == FILTER_NONE) {
+    framer.setFilter (nullptr);
+  }
+  else {
+    framer.setFilter (onFilter, this);
   }
-  GNSS_Parent->Debug_Serial->println();
-  return true;
 }
 
 //======================================================================================//
 /**
- * @brief Checks the given line if it is a valid NMEA sentence.
+ * @brief Returns the number of sentences dropped by the filter set with setFilter().
  * 
- * @param line A line to check.
- * @return true Line is a valid NMEA sentence.
- * @return false Line is not a valid NMEA sentence.
+ * @return uint32_t The filtered sentence count.
  */
-bool NMEA_0183_Data:: check (String line) {
-  GNSS_Parent->Debug_Serial->print ("NMEA_0183_Data check(): ");
-  GNSS_Parent->Debug_Serial->println (line);
+uint32_t CSE_GNSS:: getFilteredCount() const {
+  return framer.getFilteredCount();
+}
 
-  // Check if the NMEA header is valid.
-  if ((!line.startsWith (name) && (!line.startsWith (String ("$") + name)))) {
-    GNSS_Parent->Debug_Serial->println ("NMEA_0183_Data check(): Invalid header.");
-    return false;
-  }
+//======================================================================================//
+/**
+ * @brief Returns a snapshot of the runtime statistics. The byte, sentence and error counts
+ * are read from the demultiplexer and the framer. The rest are only kept if
+ * CSE_GNSS_STATS_ENABLED is 1, and are 0 otherwise.
+ * 
+ * @return GNSS_Stats The statistics.
+ */
+GNSS_Stats CSE_GNSS:: getStats() const {
+  GNSS_Stats snapshot;
 
-  // Check if the comma count is valid.
-  int commaCount = 0;
+  #if CSE_GNSS_STATS_ENABLED
+    snapshot = stats;
+  #else
+    memset (&snapshot, 0, sizeof (snapshot));
+  #endif
 
-  for (int i = 0; i < line.length(); i++) {
-    if (line.charAt (i) == ',') {
-      commaCount++;
-    }
-  }
+  snapshot.bytesIn = 0;
 
-  // Return false if the comma count is not valid.
-  // The last datum of the NMEA sentence is a checksum and a parameter combined with an asterisk.
-  // So the total comma count will be 2 less.
-  if (commaCount != (dataCount - 2)) {
-    GNSS_Parent->Debug_Serial->println ("NMEA_0183_Data check(): Invalid comma count.");
-    return false;
+  for (uint8_t i = 0; i < GNSS_Demux::PROTOCOL_COUNT; i++) {
+    snapshot.bytesIn += demux.getByteCount ((GNSS_Demux::Protocol) i);
   }
 
-  // Check if the a valid checksum is present.
-  if (line.indexOf ('*') == -1) {
-    GNSS_Parent->Debug_Serial->println ("NMEA_0183_Data check(): No checksum found.");
-    return false;
-  }
+  snapshot.bytesUnframed = demux.getByteCount (GNSS_Demux::PROTOCOL_NONE);
+  snapshot.bytesDropped = framer.getDroppedByteCount();
+  snapshot.sentenceCount = framer.getSentenceCount();
+  snapshot.checksumErrorCount = framer.getChecksumErrorCount();
+  snapshot.oversizeCount = framer.getOversizeCount();
+  snapshot.truncatedCount = framer.getTruncatedCount();
+  snapshot.filteredCount = framer.getFilteredCount();
 
-  // Return true if the NMEA sentence is valid.
-  GNSS_Parent->Debug_Serial->println ("NMEA_0183_Data check(): Valid " + name + " sentence.");
-  return true;
+  return snapshot;
 }
 
 //======================================================================================//
 /**
- * @brief Find the particular NMEA sentence from the given lines. The lines have to 
- * separated by a newline character. Some NMEA sentences can have multiple lines.
- * In that case, you can specify which occurrence of the NMEA sentence you want to find.
- * If the occurrence is not specified, the first occurrence will be returned.
+ * @brief Sets all the runtime statistics to 0, including the counters of the framer and
+ * the byte counts of the demultiplexer. getFilteredCount() also starts from 0 again.
  * 
- * @param lines The lines as a String separated by a newline character.
- * @param occurrence The occurrence of the given NMEA line to read. Default is 1 (1st).
- * @return true Data was successfully parsed and saved.
- * @return false No valid line was found.
  */
-bool NMEA_0183_Data:: find (String lines, int occurrence) {
-  if ((occurrence < 1) || (occurrence > (CONST_MAX_NMEA_LINES_COUNT - 1))) {
-    GNSS_Parent->Debug_Serial->println ("NMEA_0183_Data find(): Invalid position.");
-    return false;
+void CSE_GNSS:: resetStats() {
+  framer.resetCounts();
+  demux.resetByteCounts();
+
+  #if CSE_GNSS_STATS_ENABLED
+    memset (&stats, 0, sizeof (stats));
+  #endif
+}
+
+//======================================================================================//
+/**
+ * @brief Receives the sentence headers from the framer and applies the filter mode.
+ * 
+ * @param header The first 6 characters of the sentence, starting with the '$'.
+ * @param context The CSE_GNSS object.
+ * @return true The sentence is kept.
+ * @return false The sentence is dropped.
+ */
+bool CSE_GNSS:: onFilter (const char* header, void* context) {
+  CSE_GNSS* gnss = static_cast <CSE_GNSS*> (context);
+
+  if (gnss->waitPrefix != nullptr) {
+    return true;
   }
 
-  String splittedLines [CONST_MAX_NMEA_LINES_COUNT] = {""};
-  int startIndex = 0;
-  int lineCount = 0;  // Total number of lines.
-  int occurrenceCount = 0; // The number of instances/occurrence of the given NMEA type in the lines.
-  int occurrenceIndex = -1; // The index of the given NMEA type in the lines array.
+  const char* id = header + 1;
+  uint8_t idLength = 0;
 
-  // Split the lines to an array.
-  for (int i = 0; i < lines.length(); i++) {
-    if ((lines.charAt (i) == '\n') || (i == (lines.length() - 1))) {
-      if (lineCount >= CONST_MAX_NMEA_LINES_COUNT) {
-        break;
-      }
-      // The LF character will be dropped here.
-      splittedLines [lineCount] = lines.substring (startIndex, i);
-      startIndex = i + 1;
-      lineCount++;
-    }
+  while ((idLength < (NMEA_Framer::HeaderLength - 1)) && (id [idLength] != ',')) {
+    idLength++;
   }
 
-  // // Print the string array with special characters converted to <CR> and <LF>.
-  // GNSS_Parent->Debug_Serial->println ("NMEA_0183_Data find(): splittedLines = ");
-  // for (int i = 0; i < lineCount; i++) {
-  //   for (int j = 0; j < splittedLines [i].length(); j++) {
-  //     if (splittedLines [i].charAt (j) == '\r') {
-  //       GNSS_Parent->Debug_Serial->print ("<CR>");
-  //     }
-  //     else if (splittedLines [i].charAt (j) == '\n') {
-  //       GNSS_Parent->Debug_Serial->print ("<LF>");
-  //     }
-  //     else {
-  //       GNSS_Parent->Debug_Serial->print (splittedLines [i].charAt (j));
-  //     }
-  //   }
-  //   GNSS_Parent->Debug_Serial->println();
-  // }
+  if (gnss->filterMode == FILTER_REGISTERED) {
+    return gnss->isRegistered (id, idLength);
+  }
 
-  // for (int i = 0; i < lineCount; i++) {
-  //   GNSS_Parent->Debug_Serial->println (splittedLines [i]);
-  // }
+  bool listed = false;
 
-  GNSS_Parent->Debug_Serial->println ("NMEA_0183_Data find(): Lines to search = " + String (lineCount));
+  for (uint8_t i = 0; (i < gnss->filterTypeCount) && !listed; i++) {
+    const char* type = gnss->filterTypes [i];
+    size_t typeLength = strlen (type);
 
-  // Check if any lines starts with the given NMEA ID.
-  for (int i = 0; i < lineCount; i++) {
-    if ((splittedLines [i].startsWith (name)) || (splittedLines [i].startsWith (String ("$") + name))) {
-      occurrenceCount += 1;
+    if (typeLength == 3) {
+      // A type without the talker ID matches all the talkers.
+      listed = (idLength == 5) && (memcmp (id + 2, type, 3) == 0);
     }
+    else if (typeLength >= idLength) {
+      listed = (memcmp (id, type, idLength) == 0) && ((typeLength == idLength) || (idLength == 5));
+    }
+  }
 
-    // Break if we find the line at the same occurrence we want.
-    if (occurrenceCount == occurrence) {
-      occurrenceIndex = i;
-      break;
+  return (gnss->filterMode == FILTER_ALLOW) ? listed : !listed;
+}
+
+//======================================================================================//
+/**
+ * @brief Checks if a sentence ID has a data object, or is used by the epoch, the satellite
+ * table or the time sync. The data objects are looked up by their sentence key, so an ID of 5
+ * characters also matches the longer proprietary names that start with it. All the IDs have
+ * a consumer while the catch-all handler is set, since it is called for every sentence.
+ * 
+ * @param id The sentence ID, without the '$'. Up to 5 characters.
+ * @param length The number of characters in the ID.
+ * @return true The sentence has a consumer.
+ * @return false No one uses the sentence.
+ */
+bool CSE_GNSS:: isRegistered (const char* id, uint8_t length) const {
+  if (handler != nullptr) {
+    return true;
+  }
+
+  uint32_t key = getSentenceKey (id, length);
+  uint8_t slot = getDispatchSlot (key);
+
+  for (int i = 0; (i < CONST_DISPATCH_TABLE_SIZE) && (dispatchTable [slot] != nullptr); i++) {
+    if (dispatchKeys [slot] == key) {
+      return true;
     }
+
+    slot = (slot + 1) & (CONST_DISPATCH_TABLE_SIZE - 1);
   }
 
-  // Return false if no valid line was found.
-  if (occurrenceCount == -1) {
-    GNSS_Parent->Debug_Serial->println ("NMEA_0183_Data find(): No valid lines found.");
+  if (length != 5) {
     return false;
   }
 
-  // If the occurrenceCount is not -1, but less than the position, that means there was at least one
-  // line, but not enough to reach the position. For example if you wanted to get the 2nd
-  // GPGSV message in the lines, but there was only one, then the occurrenceCount would be 0.
-  if (occurrenceCount < occurrence) {
-    GNSS_Parent->Debug_Serial->println ("NMEA_0183_Data find(): Not enough lines to find the required occurence.");
-    GNSS_Parent->Debug_Serial->println ("NMEA_0183_Data find(): occurrenceCount: " + String (occurrenceCount));
-    return false;
+  const char* type = id + 2;
+
+  if ((satelliteTable != nullptr) && (memcmp (type, "GSV", 3) == 0)) {
+    return true;
+  }
+
+  if ((timeSync != nullptr) && ((memcmp (type, "RMC", 3) == 0) || (memcmp (type, "GGA", 3) == 0) || (memcmp (type, "GLL", 3) == 0) || (memcmp (type, "ZDA", 3) == 0))) {
+    return true;
   }
 
-  // If the occurrenceCount is equal to the occurrence, then we have found the line we want.
-  if (occurrenceCount == occurrence) {
-    GNSS_Parent->Debug_Serial->println ("NMEA_0183_Data find(): Found " + name + " line at position " + String (occurrenceIndex));
-    set (splittedLines [occurrenceIndex]);
-    return parse();
+  if (epoch != nullptr) {
+    static const char* const epochTypes [] = {"RMC", "GGA", "GLL", "ZDA", "GSA", "GSV", "VTG"};
+
+    for (uint8_t i = 0; i < 7; i++) {
+      if (memcmp (type, epochTypes [i], 3) == 0) {
+        return true;
+      }
+    }
   }
 
   return false;
@@ -271,430 +6099,392 @@ bool NMEA_0183_Data:: find (String lines, int occurrence) {
 
 //======================================================================================//
 /**
- * @brief Counts the number of particular NMEA sentences in the given lines.
+ * @brief Sets a UBX framer for the UBX frames that arrive through feed(), update() and
+ * extractNMEA(). Use it with the u-blox receivers that send UBX messages, on their own or
+ * mixed with NMEA. The UBX frames are handled by the handler of the framer.
  * 
- * @param lines GNSS data lines separated by newline characters.
- * @return int The number of lines that starts with the given NMEA ID.
+ * @param framer The UBX framer. nullptr to remove.
  */
-int NMEA_0183_Data:: count (String lines) {
-  String splittedLines [CONST_MAX_NMEA_LINES_COUNT] = {""};
-  int startIndex = 0;
-  int lineCount = 0;
-  int instanceCount = 0;
+void CSE_GNSS:: setUbxFramer (UBX_Framer* framer) {
+  demux.setUbxFramer (framer);
+}
 
-  // Split the lines to an array.
-  for (int i = 0; i < lines.length(); i++) {
-    if ((lines.charAt (i) == '\n') || (i == (lines.length() - 1))) {
-      // The LF character will be dropped here.
-      splittedLines [lineCount] = lines.substring (startIndex, i);
-      startIndex = i + 1;
-      lineCount++;
-    }
+//======================================================================================//
+/**
+ * @brief Sets an RTCM framer for the RTCM 3 frames that arrive through feed(), update() and
+ * extractNMEA(), such as the corrections sent by an RTK base receiver. The frames are
+ * passed on by the handler of the framer, eg. to the correction input of a rover.
+ * 
+ * @param framer The RTCM framer. nullptr to remove.
+ */
+void CSE_GNSS:: setRtcmFramer (RTCM_Framer* framer) {
+  demux.setRtcmFramer (framer);
+}
+
+//======================================================================================//
+/**
+ * @brief Sends a UBX message to the GNSS module. The sync characters, the length and the
+ * checksum are added.
+ * 
+ * @param messageClass The message class, eg. 0x06 for CFG.
+ * @param id The message ID.
+ * @param payload The payload. Can be nullptr if the length is 0.
+ * @param length The length of the payload.
+ * @return true The message has been written to the port.
+ * @return false The port is not initialized.
+ */
+bool CSE_GNSS:: sendUbx (uint8_t messageClass, uint8_t id, const uint8_t* payload, uint16_t length) {
+  if (!inited) {
+    CSE_GNSS_LOG_ERROR (this, "CSE_GNSS sendUbx(): GNSS module serial port is not initialized.");
+    return false;
   }
 
-  // Check if any lines starts with the given NMEA ID.
-  for (int i = 0; i < lineCount; i++) {
-    if ((splittedLines [i].startsWith (name)) || (splittedLines [i].startsWith (String ("$") + name))) {
-      instanceCount += 1;
-    }
+  uint8_t header [6] = {UBX_Frame::Sync1, UBX_Frame::Sync2, messageClass, id, (uint8_t) length, (uint8_t) (length >> 8)};
+  uint8_t checksum [2] = {0, 0};
+
+  UBX_Framer::computeChecksum (header + 2, 4, checksum [0], checksum [1]);
+  UBX_Framer::computeChecksum (payload, length, checksum [0], checksum [1]);
+
+  size_t writeCount = GNSS_Serial->write (header, sizeof (header));
+
+  if (length > 0) {
+    writeCount += GNSS_Serial->write (payload, length);
   }
 
-  GNSS_Parent->Debug_Serial->println ("NMEA_0183_Data count(): Found " + String (instanceCount) + " " + name + " lines.");
+  writeCount += GNSS_Serial->write (checksum, sizeof (checksum));
 
-  return instanceCount;
+  return writeCount == (sizeof (header) + length + sizeof (checksum));
 }
 
 //======================================================================================//
 /**
- * @brief Checks if a data named "dataName" exists in the dataName array and returns
- * the index if it does. Useful for updating the data. You must make sure the returned
- * index is valid and not -1, before trying to use it.
+ * @brief Reads the GNSS port until the ACK or NAK of a UBX message is received, or until
+ * the timeout. A UBX framer must be set.
  * 
- * @param dataName The name of the data to search for. Eg. "Header".
- * @return int The index position. -1 if not found.
+ * @param messageClass The class of the message sent.
+ * @param id The ID of the message sent.
+ * @param timeout The timeout in milliseconds.
+ * @return true The message was acknowledged.
+ * @return false The message was rejected with a NAK, or the timeout passed.
  */
-int NMEA_0183_Data:: getDataIndex (String dataName) {
-  for (int i = 0; i < dataCount; i++) {
-    if (dataNameList [i] == dataName) {
-      return i;
-    }
+bool CSE_GNSS:: waitForUbxAck (uint8_t messageClass, uint8_t id, uint32_t timeout) {
+  UBX_Framer* ubxFramer = demux.getUbxFramer();
+
+  if (ubxFramer == nullptr) {
+    CSE_GNSS_LOG_ERROR (this, "CSE_GNSS waitForUbxAck(): No UBX framer is set.");
+    return false;
   }
 
-  return -1;
+  if (!inited) {
+    CSE_GNSS_LOG_ERROR (this, "CSE_GNSS waitForUbxAck(): GNSS module serial port is not initialized.");
+    return false;
+  }
+
+  uint32_t startTime = millis();
+  uint32_t ackCount = ubxFramer->getAckCount();
+
+  do {
+    update();
+
+    if (ubxFramer->getAckCount() != ackCount) {
+      uint8_t ackClass, ackId;
+      bool accepted = ubxFramer->getLastAck (ackClass, ackId);
+
+      ackCount = ubxFramer->getAckCount();
+
+      if ((ackClass == messageClass) && (ackId == id)) {
+        if (!accepted) {
+          CSE_GNSS_LOG_WARN (this, "CSE_GNSS waitForUbxAck(): The message was rejected.");
+        }
+
+        return accepted;
+      }
+    }
+  } while ((millis() - startTime) < timeout);
+
+  CSE_GNSS_LOG_WARN (this, "CSE_GNSS waitForUbxAck(): Timed out.");
+  return false;
 }
 
 //======================================================================================//
 /**
- * @brief Construct a new CSE_GNSS object with hardware serial ports.The baudrates are
- * optional. The ports will be initialized only if a non-zero baudrate is provided.
- * So for manual port initialization, you can provide 0 for the baudrates.
+ * @brief Sets how often a u-blox receiver sends a message on the current port, with a UBX
+ * CFG-MSG message. Use it to turn on UBX-NAV-PVT (0x01 0x07) on a high rate receiver, and
+ * the standard NMEA messages (class 0xF0) off. The ACK is waited for if a UBX framer is set.
  * 
- * @param gnssSerial Hardare serial port for the GNSS module.
- * @param debugSerial Hardware serial port for debug messages.
- * @param gnssBaud Baude rate for the GNSS module. Optional. Default is 0.
- * @param debugBaud Baud rate for debug messages. Optional. Default is 0.
- * @return CSE_GNSS:: 
+ * @param messageClass The class of the message, eg. 0x01 for NAV.
+ * @param id The ID of the message, eg. 0x07 for PVT.
+ * @param rate The number of fixes per message. 0 to turn the message off.
+ * @param timeout The timeout for the ACK in milliseconds.
+ * @return true The rate has been set.
+ * @return false The message could not be sent, was rejected or was not acknowledged.
  */
-CSE_GNSS:: CSE_GNSS (HardwareSerial* gnssSerial, HardwareSerial* debugSerial, uint64_t gnssBaud, uint64_t debugBaud) {
-  GNSS_Serial = gnssSerial;
-  Debug_Serial = debugSerial;
-  this->gnssBaud = gnssBaud;
-  this->debugBaud = debugBaud;
+bool CSE_GNSS:: setUbxMessageRate (uint8_t messageClass, uint8_t id, uint8_t rate, uint32_t timeout) {
+  uint8_t payload [3] = {messageClass, id, rate};
 
-  // Add data to the dummy data object.
-  static String NMEA_Sample = "$DUMMY,120556.096,V,123.456,N,123.456,E,1.23,123.45,020723,1.9,W,N,V*33";
-  static String NMEA_Data_Names [] = {"Header", "UTC", "Status", "Latitude", "Latitude Direction", "Longitude", "Longitude Direction", "Speed", "Course", "Date", "Mag Variation", "Mag Variation Direction", "Mode", "Second Mode", "Checksum"};
-  static String NMEA_Description = "You forgot to add NMEA_0183_Data objects. Please add at least one.";
-  dummyData = new NMEA_0183_Data ("DUMMY", NMEA_Description, 15, NMEA_Data_Names, NMEA_Sample);
-  dummyData->GNSS_Parent = this;
+  if (!sendUbx (0x06, 0x01, payload, sizeof (payload))) {
+    return false;
+  }
+
+  return (demux.getUbxFramer() == nullptr) || waitForUbxAck (0x06, 0x01, timeout);
 }
 
 //======================================================================================//
+#if defined(__linux__)
+/**
+ * @brief The state of a thread of the NMEA_Batch_Parser while it parses a chunk.
+ * 
+ */
+struct NMEA_Batch_Worker {
+  NMEA_Framer framer; // Frames the chunk
+  NMEA_0183_Data data; // Parses every sentence
+  NMEA_Epoch epoch; // Groups the sentences into epochs
+  bool timeSeen; // True after the first sentence with a UTC time
 
-// Only for software serial.
-#if SOFTWARE_SERIAL_REQUIRED
-  /**
-   * @brief Construct a new CSE_GNSS object with software serial port for GNSS module.
-   * Debug serial port is still hardware serial. The baudrates are optional. The ports
-   * will be initialized only if a non-zero baudrate is provided. So for manual port
-   * initialization, you can provide 0 for the baudrates.
-   * 
-   * @param gnssSerial Software serial port for GNSS module.
-   * @param debugSerial Hardware serial port for debug messages.
-   * @param gnssBaud Baudrate for GNSS module. Optional. Default is 0.
-   * @param debugBaud Debug port baudrate. Optional. Default is 0.
-   * @return CSE_GNSS:: 
-   */
-  CSE_GNSS:: CSE_GNSS (SoftwareSerial* gnssSerial, HardwareSerial* debugSerial, uint64_t gnssBaud, uint64_t debugBaud) {
-  GNSS_Serial = gnssSerial;
-  Debug_Serial = debugSerial;
-  this->gnssBaud = gnssBaud;
-  this->debugBaud = debugBaud;
+  NMEA_Batch_Worker() : data ("", &NMEA_Generic_Info), timeSeen (false) {
+    data.setLazy (true); // The epoch only reads a few fields of each sentence
+  }
+};
 
-  // Add data to the dummy data object.
-  static String NMEA_Sample = "$DUMMY,120556.096,V,123.456,N,123.456,E,1.23,123.45,020723,1.9,W,N,V*33";
-  static String NMEA_Data_Names [] = {"Header", "UTC", "Status", "Latitude", "Latitude Direction", "Longitude", "Longitude Direction", "Speed", "Course", "Date", "Mag Variation", "Mag Variation Direction", "Mode", "Second Mode", "Checksum"};
-  static String NMEA_Description = "You forgot to add NMEA_0183_Data objects. Please add at least one.";
-  dummyData = new NMEA_0183_Data ("DUMMY", NMEA_Description, 15, NMEA_Data_Names, NMEA_Sample);
-  dummyData->GNSS_Parent = this;
-}
-#endif
+/**
+ * @brief A chunk of the log and its results.
+ * 
+ */
+struct NMEA_Batch_Chunk {
+  const char* data; // The first byte of the chunk
+  size_t length; // The number of bytes
+  std::vector <NMEA_Fix> epochs; // The epochs in the order of the chunk
+  uint32_t sentenceCount; // Sentences framed
+  uint32_t checksumErrorCount; // Sentences dropped due to checksum mismatch
+};
 
 //======================================================================================//
 /**
- * @brief Initializes the GNSS module serial port. You should have already set the baudrate
- * and the serial port before calling this function.
- * 
- * By default the port is not initialized as the default value of gnssBaud and debugBaud is 0.
- * The serial ports will only be initialized if a non-zero value is set for the baudrates.
- * 
- * Regardless of how you initialize the serial port, it is important to call this function
- * to let the library know that the port was initialized.
+ * @brief Adds a published epoch to the list of the chunk.
  * 
- * @return true GNSS initialization was successful.
- * @return false GNSS initialization failed.
+ * @param fix The epoch.
+ * @param context The std::vector of the chunk.
  */
-bool CSE_GNSS:: begin() {
-  if (!inited) {
-    if (gnssBaud != 0) {
-      GNSS_Serial->begin (gnssBaud);
-    }
-
-    if (debugBaud != 0) {
-      Debug_Serial->begin (debugBaud);
-    }
-  }
-  inited = true;
-  return true;
+static void onBatchEpoch (const NMEA_Fix& fix, void* context) {
+  static_cast <std::vector <NMEA_Fix>*> (context)->push_back (fix);
 }
 
 //======================================================================================//
 /**
- * @brief Reads a specified number of bytes from the GNSS module. The read bytes will be
- * saved to the `gnssDataBuffer`. `gnssDataBufferLength` will hold the number of valid
- * data bytes in the buffer. Only that much data must be read for further processing.
- * Returns the number of bytes read at the end.
+ * @brief Parses a framed sentence of a chunk and adds it to the epoch. The sentences before
+ * the first one with a UTC time belong to the last epoch of the previous chunk, so they
+ * are published as an epoch without a time, which is merged later.
  * 
- * @param byteCount The number of bytes to read.
- * @return uint16_t The number of bytes read.
+ * @param sentence The complete sentence starting with '$'.
+ * @param length The length of the sentence.
+ * @param context The NMEA_Batch_Worker.
  */
-uint16_t CSE_GNSS:: read (int byteCount) {
-  if (!inited) {
-    Debug_Serial->println ("CSE_GNSS read(): GNSS module serial port is not initialized.");
-    return 0;
+static void onBatchSentence (const char* sentence, uint16_t length, void* context) {
+  NMEA_Batch_Worker* worker = static_cast <NMEA_Batch_Worker*> (context);
+
+  worker->data.set (sentence, length, true);
+
+  if (!worker->data.parse()) {
+    return;
   }
 
-  if ((byteCount <= 0) || (byteCount > (CONST_SERIAL_BUFFER_LENGTH - 1))) { // Check if the byte count is valid.
-    Debug_Serial->println ("CSE_GNSS read(): Invalid byte count.");
-    return 0;
+  if (!worker->timeSeen && (length >= 6)) {
+    const char* type = sentence + 3;
+
+    if ((memcmp (type, "RMC", 3) == 0) || (memcmp (type, "GGA", 3) == 0) ||
+        (memcmp (type, "GLL", 3) == 0) || (memcmp (type, "ZDA", 3) == 0)) {
+      worker->epoch.publish();
+      worker->timeSeen = true;
+    }
   }
 
-  gnssDataBufferLength = GNSS_Serial->readBytes (gnssDataBuffer, byteCount); // Read the bytes from the serial port.
-  // gnssDataBuffer [byteCount] = 0; // Null terminate the buffer so that it becomes a proper c-string (if used for character communication).
+  worker->epoch.add (worker->data);
+}
 
-  Debug_Serial->print ("CSE_GNSS read(): Read ");
-  Debug_Serial->print (gnssDataBufferLength);
-  Debug_Serial->println (" bytes from GNSS module.");
+//======================================================================================//
+/**
+ * @brief Frames, parses and groups a chunk into epochs.
+ * 
+ * @param chunk The chunk to parse. The results are saved to it.
+ */
+static void parseBatchChunk (NMEA_Batch_Chunk& chunk) {
+  NMEA_Batch_Worker worker;
 
-  // return String (gnssDataBuffer, gnssDataBufferLength);
-  return gnssDataBufferLength;
+  worker.framer.setHandler (onBatchSentence, &worker);
+  worker.framer.setClock (nullptr); // The arrival times of a log file mean nothing
+  worker.epoch.setHandler (onBatchEpoch, &chunk.epochs);
+  worker.framer.feed (chunk.data, chunk.length);
+  worker.epoch.publish();
+
+  chunk.sentenceCount = worker.framer.getSentenceCount();
+  chunk.checksumErrorCount = worker.framer.getChecksumErrorCount();
 }
 
+//======================================================================================//
+/**
+ * @brief Constructs a batch parser.
+ * 
+ * @param threadCount The number of threads. 0 uses one thread per core.
+ */
+NMEA_Batch_Parser:: NMEA_Batch_Parser (unsigned threadCount) : sentenceCount (0), checksumErrorCount (0) {
+  setThreadCount (threadCount);
+}
 
 //======================================================================================//
 /**
- * @brief Converts the contents of the `nmeaDataBuffer` to a String object.
+ * @brief Sets the number of threads used by parse(), including the calling thread.
  * 
- * @return String The converted string.
+ * @param threadCount The number of threads. 0 uses one thread per core.
  */
-String CSE_GNSS:: getNmeaDataString() {
-  // nmeaDataBuffer [nmeaDataBufferLength] = 0;
-  return String (nmeaDataBuffer, nmeaDataBufferLength);
+void NMEA_Batch_Parser:: setThreadCount (unsigned threadCount) {
+  if (threadCount == 0) {
+    threadCount = std::thread::hardware_concurrency();
+  }
+
+  this->threadCount = (threadCount == 0) ? 1 : threadCount;
 }
 
 //======================================================================================//
 /**
- * @brief Extracts NMEA sentences from the GNSS data buffer. This removes any redundant
- * or unsupported data from the buffer. This can include mixed protocol messages, non-printable
- * chracters, etc. Valid NMEA sentences will be read and added to the buffer with each line
- * ending a single newline character (LF).
+ * @brief Finds the start of the next chunk. Like extractNMEA(), only the GNSS talker
+ * sentences ("$G") are taken as sentence starts.
  * 
- * @return uint16_t The number of valid bytes in the NMEA data buffer.
+ * @param data The log.
+ * @param length The length of the log.
+ * @param position The position to start searching from.
+ * @return size_t The position of the next "$G", or the length if there is none.
  */
-uint16_t CSE_GNSS:: extractNMEA() {
-  bool dollarFound = false;
-  bool gFound = false;
-  bool starFound = false;
-  bool c1Found = false;
-  bool c2Found = false;
-
-  Debug_Serial->print ("CSE_GNSS extractNMEA(): Extracting NMEA lines.. GNSS data buffer length is ");
-  Debug_Serial->println (gnssDataBufferLength);
-  
-  // The following algorithm works for mixed protocol messages.
-  // It can split mixed NMEA + UBX protocol messages correctly.
-  int destIndex = 0;
-
-  for (int sourceIndex = 0; sourceIndex < (gnssDataBufferLength - 1);) {
-    char c = gnssDataBuffer [sourceIndex];
-
-    if (c == '$') { // Check for the Dollar sign
-      sourceIndex++;
-      if (sourceIndex < gnssDataBufferLength) {
-        c = gnssDataBuffer [sourceIndex]; // Read the next character
-
-        if (c == 'G') { // Check if the next character is G
-          if (!dollarFound) { // If a dollar sign is not already found
-            nmeaDataBuffer [destIndex] = gnssDataBuffer [sourceIndex - 1];  // Save the dollar sign
-            destIndex++;
-            dollarFound = true;
-            gFound = true;
-            nmeaDataBuffer [destIndex] = c;  // Save the G character
-            destIndex++;
-            sourceIndex++;
-          }
-          else { // If we find multiple dollar signs before finding a star and other positions.
-            dollarFound = false;  // So that a fresh line can be created.
-            gFound = false;
-            nmeaDataBuffer [destIndex] = '\n';  // Break the line but do not increment the source line index.
-            destIndex++;
-          }
-          continue; // Skip the remaining steps.
-        }
-      }
-      continue;
-    }
+size_t NMEA_Batch_Parser:: findChunkStart (const char* data, size_t length, size_t position) {
+  while (position < length) {
+    const char* dollar = static_cast <const char*> (memchr (data + position, '$', length - position));
 
-    if ((c == 'G') && (!gFound) && (dollarFound)) {
-      gFound = true;
-      nmeaDataBuffer [destIndex] = c;
-      destIndex++;
-      sourceIndex++;
-      continue;
+    if (dollar == nullptr) {
+      return length;
     }
 
-    if ((c == '*') && (!starFound) && (gFound)) {
-      starFound = true;
-      nmeaDataBuffer [destIndex] = c;
-      destIndex++;
-      sourceIndex++;
-      continue;
-    }
+    position = dollar - data;
 
-    if ((!c1Found) && (starFound)) {
-      c1Found = true;
-      nmeaDataBuffer [destIndex] = c;
-      destIndex++;
-      sourceIndex++;
-      continue;
+    if (((position + 1) < length) && (data [position + 1] == 'G')) {
+      return position;
     }
 
-    if ((!c2Found) && (c1Found)) {
-      c2Found = true;
-      nmeaDataBuffer [destIndex] = c;
-      destIndex++;
-      sourceIndex++;
-      continue;
-    }
+    position++;
+  }
 
-    if (c2Found) {
-      nmeaDataBuffer [destIndex] = '\n';
-      destIndex++;
-      dollarFound = false;
-      gFound = false;
-      starFound = false;
-      c1Found = false;
-      c2Found = false;
-    }
+  return length;
+}
 
-    if (gFound && dollarFound) {
-      nmeaDataBuffer [destIndex] = c;
-      destIndex++;
-    }
+//======================================================================================//
+/**
+ * @brief Parses a log in memory on the threads, and sends the epochs to the handler in the
+ * order of the log. The log is split into a few chunks per thread, so that the threads
+ * stay busy even if some chunks take longer. Each chunk is grouped into epochs on its own,
+ * and the epochs that were split at the chunk boundaries are merged back before they are
+ * sent. The handler is called on the calling thread after all the chunks are parsed.
+ * 
+ * @param data The log, such as the data of an NMEA_Mapped_File.
+ * @param length The length of the log.
+ * @param handler The function called for each epoch. Can be nullptr to only count.
+ * @param context A user pointer passed to the handler.
+ * @return uint32_t The number of epochs.
+ */
+uint32_t NMEA_Batch_Parser:: parse (const char* data, size_t length, NMEA_Epoch_Handler handler, void* context) {
+  const size_t minChunkLength = 65536; // Smaller chunks are not worth a thread
+  size_t chunkCount = threadCount * 4;
 
-    sourceIndex++;
+  if ((length / chunkCount) < minChunkLength) {
+    chunkCount = (length / minChunkLength) + 1;
   }
 
-  nmeaDataBufferLength = destIndex;
-  
-  // If the last character is not a new line character, add it.
-  if (nmeaDataBuffer [nmeaDataBufferLength] != '\n') {
-    nmeaDataBuffer [nmeaDataBufferLength] = '\n';
-    nmeaDataBufferLength++;
-  }
+  // Split the log at the "$G" that follows each even split point.
+  std::vector <NMEA_Batch_Chunk> chunks;
+  size_t start = 0;
 
-  Debug_Serial->println ("CSE_GNSS extractNMEA(): Removing CR character..");
+  chunks.reserve (chunkCount);
 
-  // Check if there are <CR> characters in the buffer and replace them with <LF> characters.
-  for (int i = 0; i < nmeaDataBufferLength; i++) {
-    if (nmeaDataBuffer [i] == '\r') {
-      nmeaDataBuffer [i] = '\n';
+  for (size_t i = 1; (i <= chunkCount) && (start < length); i++) {
+    size_t end = (i == chunkCount) ? length : findChunkStart (data, length, (length / chunkCount) * i);
+
+    if (end <= start) {
+      continue;
     }
+
+    NMEA_Batch_Chunk chunk = NMEA_Batch_Chunk();
+    chunk.data = data + start;
+    chunk.length = end - start;
+    chunks.push_back (chunk);
+    start = end;
   }
 
-  Debug_Serial->print ("CSE_GNSS extractNMEA(): Extracted ");
-  Debug_Serial->print (nmeaDataBufferLength);
-  Debug_Serial->println (" characters.");
+  // The threads take the next chunk until there are none left.
+  std::atomic <size_t> nextChunk (0);
 
-  // for (int i = 0; i < nmeaDataBufferLength; i++) {
-  //   if (nmeaDataBuffer [i] == '\n') {
-  //     Debug_Serial->println ("<LF>");
-  //   }
-  //   else if (nmeaDataBuffer [i] == '\r') {
-  //     Debug_Serial->print ("<CR>");
-  //   }
-  //   else {
-  //     Debug_Serial->print (nmeaDataBuffer [i]);
-  //   }
-  // }
+  auto work = [&] () {
+    size_t index;
 
-  Debug_Serial->println ("CSE_GNSS extractNMEA(): Removing non-printable characters..");
+    while ((index = nextChunk.fetch_add (1, std::memory_order_relaxed)) < chunks.size()) {
+      parseBatchChunk (chunks [index]);
+    }
+  };
 
-  char tempBuffer [nmeaDataBufferLength] = {0};
+  std::vector <std::thread> threads;
+  size_t workerCount = (threadCount < chunks.size()) ? threadCount : chunks.size();
 
-  // Check if each chracters is a printable ASCII character and only copy the ones that are.
-  for (int i = 0, k = 0; i < nmeaDataBufferLength; i++) {
-    if (((nmeaDataBuffer [i] > 0x20) && (nmeaDataBuffer [i] <= 0x7E)) || (nmeaDataBuffer [i] == '\n') || (nmeaDataBuffer [i] == '\r')) {
-      tempBuffer [k] = nmeaDataBuffer [i];
-      // Debug_Serial->print (tempBuffer [k]);
-      k++;
-    }
-    if (i == (nmeaDataBufferLength - 1)) {
-      nmeaDataBufferLength = k;
-    }
+  for (size_t i = 1; i < workerCount; i++) {
+    threads.emplace_back (work);
   }
 
-  // Copy the temporary buffer to the original buffer.
-  for (int i = 0; i < nmeaDataBufferLength; i++) {
-    nmeaDataBuffer [i] = tempBuffer [i];
+  work();
+
+  for (size_t i = 0; i < threads.size(); i++) {
+    threads [i].join();
   }
 
-  Debug_Serial->print ("CSE_GNSS extractNMEA(): Found ");
-  Debug_Serial->print (nmeaDataBufferLength);
-  Debug_Serial->println (" valid characters.");
+  // Merge the epochs in order. An epoch without a time, or with the same time as the
+  // previous epoch, is the rest of the previous epoch from the other side of a boundary.
+  NMEA_Fix pendingEpoch = NMEA_Fix();
+  bool pending = false;
+  uint32_t epochCount = 0;
 
-  for (int i = 0; i < nmeaDataBufferLength; i++) {
-    if (nmeaDataBuffer [i] == '\n') {
-      Debug_Serial->println ("<LF>");
-    }
-    else if (nmeaDataBuffer [i] == '\r') {
-      Debug_Serial->print ("<CR>");
-    }
-    else {
-      Debug_Serial->print (nmeaDataBuffer [i]);
-    }
-  }
+  sentenceCount = 0;
+  checksumErrorCount = 0;
 
-  Debug_Serial->println();
+  for (size_t i = 0; i < chunks.size(); i++) {
+    sentenceCount += chunks [i].sentenceCount;
+    checksumErrorCount += chunks [i].checksumErrorCount;
 
-  return nmeaDataBufferLength;
-}
+    for (size_t j = 0; j < chunks [i].epochs.size(); j++) {
+      const NMEA_Fix& epoch = chunks [i].epochs [j];
 
-//======================================================================================//
-/**
- * @brief Add a new NMEA_0183_Data object to the data list on the fly and returns the
- * number of data objects in the list currently.
- * 
- * @param data The reference of the NMEA_0183_Data object to be added.
- * @return int The number of data objects in the list currently.
- */
-int CSE_GNSS:: addData (NMEA_0183_Data* data) {
-  dataList.push_back (data);
-  dataList [dataCount]->GNSS_Parent = this;  // Set parent GNSS object.
-  dataCount++;
-  return dataCount;
-}
+      if (pending && (!(epoch.flags & NMEA_Fix::FLAG_TIME) || !(pendingEpoch.flags & NMEA_Fix::FLAG_TIME) || (epoch.time == pendingEpoch.time))) {
+        NMEA_Epoch::merge (pendingEpoch, epoch);
+        continue;
+      }
 
-//======================================================================================//
-/**
- * @brief Returns the reference to the NMEA_0183_Data object with the given name. If no
- * data with the given name is found, a dummy data is returned.
- * 
- * @param name The name of the NMEA_0183_Data object. For example, "GPRMC".
- * @return CSE_GNSS::NMEA_0183_Data_Ref 
- */
-CSE_GNSS::NMEA_0183_Data_Ref CSE_GNSS:: getDataRef (String name) {
-  if (dataCount == 0) {
-    return *dummyData;
-  }
+      if (pending) {
+        if (handler != nullptr) {
+          handler (pendingEpoch, context);
+        }
 
-  for (int i = 0; i < dataCount; i++) {
-    if (dataList [i]->name == name) {
-      return *dataList [i];
+        epochCount++;
+      }
+
+      pendingEpoch = epoch;
+      pending = true;
     }
   }
 
-  return *dummyData;
-}
-
-//======================================================================================//
-/**
- * @brief Returns the reference to the NMEA_0183_Data object at the given index. The index
- * should be from 0 to dataCount - 1.
- * 
- * @param index The index of the NMEA_0183_Data object in the list. Index starts at 0.
- * @return CSE_GNSS::NMEA_0183_Data_Ref 
- */
-CSE_GNSS::NMEA_0183_Data_Ref CSE_GNSS:: getDataRef (int index) {
-  if (dataCount == 0) {
-    return *dummyData;
-  }
+  if (pending) {
+    if (handler != nullptr) {
+      handler (pendingEpoch, context);
+    }
 
-  if ((index >= 0) && (index < dataCount)) {
-    return *dataList [index];
+    epochCount++;
   }
 
-  return *dummyData;
+  return epochCount;
 }
 
-//======================================================================================//
-/**
- * @brief Returns the number of NMEA_0183_Data objects in the list.
- * 
- * @return int 
- */
-int CSE_GNSS:: getDataCount() {
-  return dataCount;
-}
+#endif
 
 //======================================================================================//
@@ -16,23 +16,508 @@
 #define CSE_GNSS_H
 
 #include <Arduino.h>
-#include <vector>
 
-// You can expand the software serial support here.
-#define SOFTWARE_SERIAL_REQUIRED defined(__AVR__) || defined(ESP8266)
+// You can expand the software serial support here. CSE_GNSS accepts any serial port type,
+// so this only decides if SoftwareSerial.h is included for the sketches.
+#if defined(__AVR__) || defined(ESP8266)
+  #define SOFTWARE_SERIAL_REQUIRED 1
+#else
+  #define SOFTWARE_SERIAL_REQUIRED 0
+#endif
 
 #if SOFTWARE_SERIAL_REQUIRED
   #include <SoftwareSerial.h> //software serial doesn't work with Arduino Due
 #endif
 
-#define   CONST_SERIAL_BUFFER_LENGTH     4096   // The buffer size for GNSS serial data and NMEA data.
-#define   CONST_MAX_NMEA_LINES_COUNT     64     // The maximum number of NMEA lines that will be scanned to find an occurrence.
-#define   CONST_MAX_NMEA_FIELDS_COUNT    64     // The maximum number of fields count in a NMEA sentence.
+// The memory footprint can be changed with build flags (eg. -DCONST_SERIAL_BUFFER_LENGTH=512).
+// All the storage is static and sized by these values. They must be the same for the sketch
+// and the library, so do not define them in the sketch. CSE_GNSS::begin() fails if they
+// differ. See the memory footprint section of the API reference.
+#ifndef CONST_SERIAL_BUFFER_LENGTH
+  #define   CONST_SERIAL_BUFFER_LENGTH     4096   // The buffer size for GNSS serial data and NMEA data.
+#endif
+
+#ifndef CONST_MAX_NMEA_LINES_COUNT
+  #define   CONST_MAX_NMEA_LINES_COUNT     64     // The maximum number of NMEA lines that will be scanned to find an occurrence.
+#endif
+
+#ifndef CONST_MAX_NMEA_FIELDS_COUNT
+  #define   CONST_MAX_NMEA_FIELDS_COUNT    64     // The maximum number of fields count in a NMEA sentence.
+#endif
+
+#ifndef CONST_MAX_NMEA_SENTENCE_LENGTH
+  #define   CONST_MAX_NMEA_SENTENCE_LENGTH 128    // The maximum length of a single NMEA sentence, including the '$' and the checksum.
+#endif
+
+#ifndef CONST_MAX_NMEA_DATA_COUNT
+  #define   CONST_MAX_NMEA_DATA_COUNT      16     // The maximum number of NMEA data objects that can be dispatched to.
+#endif
+
+#ifndef CONST_MAX_SATELLITES
+  #define   CONST_MAX_SATELLITES           64     // The maximum number of satellites in an NMEA_Satellite_Table.
+#endif
+
+#ifndef CONST_MAX_UBX_PAYLOAD_LENGTH
+  #define   CONST_MAX_UBX_PAYLOAD_LENGTH   512    // The longest UBX payload that a UBX_Framer can hold. NAV-SAT needs 8 + 12 per satellite.
+#endif
+
+#ifndef CONST_MAX_RTCM_FRAME_LENGTH
+  #define   CONST_MAX_RTCM_FRAME_LENGTH    1029   // The longest RTCM 3 frame that an RTCM_Framer can hold when it is split between the reads.
+#endif
+
+#ifndef CONST_AUTO_BAUD_WINDOW
+  #define   CONST_AUTO_BAUD_WINDOW         1100   // The time in milliseconds that detectBaud() listens at each baudrate.
+#endif
+
+#ifndef CONST_AUTO_BAUD_LOCK_COUNT
+  #define   CONST_AUTO_BAUD_LOCK_COUNT     2      // The number of valid sentences that lock detectBaud() on a baudrate.
+#endif
+
+// A hash of the sizes of the classes that the CONST_* macros change. The default argument
+// of CSE_GNSS::begin() takes it in the sketch and begin() compares it with the one in the
+// library, so that a sketch built with other values fails instead of corrupting memory.
+#define   CSE_GNSS_LAYOUT  (((((uint32_t) sizeof (CSE_GNSS) * 31 + (uint32_t) sizeof (NMEA_0183_Data)) * 31 + \
+                            (uint32_t) sizeof (NMEA_Satellite_Table)) * 31 + (uint32_t) sizeof (UBX_Framer)) * 31 + \
+                            (uint32_t) sizeof (RTCM_Framer))
+
+// The number of slots in the sentence dispatch table. Must be a power of 2 and larger than
+// CONST_MAX_NMEA_DATA_COUNT. By default it is the smallest power of 2 that keeps the table
+// at most half full.
+#ifndef CONST_DISPATCH_TABLE_SIZE
+  #define   CONST_DISPATCH_TABLE_SIZE      ((CONST_MAX_NMEA_DATA_COUNT <= 4) ? 8 : \
+                                            (CONST_MAX_NMEA_DATA_COUNT <= 8) ? 16 : \
+                                            (CONST_MAX_NMEA_DATA_COUNT <= 16) ? 32 : \
+                                            (CONST_MAX_NMEA_DATA_COUNT <= 32) ? 64 : \
+                                            (CONST_MAX_NMEA_DATA_COUNT <= 64) ? 128 : 256)
+#endif
+
+// Word-at-a-time (SWAR) checksum and scanning. Only enabled on the architectures that can
+// load unaligned words cheaply. It is only read in the library, so set it to 0 or 1 with a
+// build flag to override. Defining it in the sketch has no effect.
+#ifndef CSE_GNSS_SWAR_ENABLED
+  #if defined(__x86_64__) || defined(__i386__) || defined(__aarch64__) || defined(__ARM_FEATURE_UNALIGNED)
+    #define CSE_GNSS_SWAR_ENABLED 1
+  #else
+    #define CSE_GNSS_SWAR_ENABLED 0
+  #endif
+#endif
+
+// The runtime statistics of the ingestion pipeline, read with CSE_GNSS::getStats(). Set it
+// to 0 with a build flag to remove the counters from the hot path. It adds or removes members
+// of CSE_GNSS, so it must be the same for the sketch and the library. Do not define it in
+// the sketch.
+#ifndef CSE_GNSS_STATS_ENABLED
+  #define CSE_GNSS_STATS_ENABLED 1
+#endif
+
+// The latency histograms of the framing and the parsing. Off by default, as they read the
+// clock twice for every sentence. CSE_GNSS_STATS_CLOCK() can be set to a cycle counter, eg.
+// ESP.getCycleCount() on ESP32, for a finer resolution than micros(). Both are build flags
+// only, like CSE_GNSS_STATS_ENABLED. The clock is only read in the library.
+#if !CSE_GNSS_STATS_ENABLED
+  #undef CSE_GNSS_STATS_LATENCY
+  #define CSE_GNSS_STATS_LATENCY 0
+#elif !defined(CSE_GNSS_STATS_LATENCY)
+  #define CSE_GNSS_STATS_LATENCY 0
+#endif
+
+#ifndef CSE_GNSS_STATS_CLOCK
+  #define CSE_GNSS_STATS_CLOCK() micros()
+#endif
+
+// The counters of the NMEA_Ring_Buffer. Use std::atomic where it is available. On AVR, the
+// 8-bit loads and stores are atomic, so volatile bytes with a compiler barrier are enough.
+#if defined(__AVR__)
+  typedef uint8_t NMEA_Ring_Index;
+  typedef volatile uint8_t NMEA_Ring_Counter;
+
+  #define   CONST_RING_MAX_CAPACITY       128
+  #define   CSE_GNSS_RING_LOAD(counter, order)          (__asm__ __volatile__ ("" ::: "memory"), (NMEA_Ring_Index) (counter))
+  #define   CSE_GNSS_RING_STORE(counter, value, order)  do { __asm__ __volatile__ ("" ::: "memory"); (counter) = (value); } while (0)
+  #define   CSE_GNSS_FENCE(order)                       __asm__ __volatile__ ("" ::: "memory")
+#else
+  #include <atomic>
+
+  typedef uint32_t NMEA_Ring_Index;
+  typedef std::atomic <uint32_t> NMEA_Ring_Counter;
+
+  #define   CONST_RING_MAX_CAPACITY       0x80000000UL
+  #define   CSE_GNSS_RING_LOAD(counter, order)          ((counter).load (std::memory_order_##order))
+  #define   CSE_GNSS_RING_STORE(counter, value, order)  ((counter).store ((value), std::memory_order_##order))
+  #define   CSE_GNSS_FENCE(order)                       std::atomic_thread_fence (std::memory_order_##order)
+#endif
+
+// Log levels. The messages above CSE_GNSS_LOG_LEVEL are removed at compile time, so they
+// cost neither flash nor time. The library is compiled separately from the sketch, so set it
+// with a build flag (eg. -DCSE_GNSS_LOG_LEVEL=4) to change. Do not define it in the sketch.
+// The messages that are compiled in can be filtered further at run time with setLogLevel().
+#define   CSE_GNSS_LOG_LEVEL_NONE        0
+#define   CSE_GNSS_LOG_LEVEL_ERROR       1
+#define   CSE_GNSS_LOG_LEVEL_WARN        2
+#define   CSE_GNSS_LOG_LEVEL_INFO        3
+#define   CSE_GNSS_LOG_LEVEL_DEBUG       4
+
+#ifndef CSE_GNSS_LOG_LEVEL
+  #define CSE_GNSS_LOG_LEVEL CSE_GNSS_LOG_LEVEL_WARN
+#endif
+
+// Prints the arguments one after another to the debug port of the given CSE_GNSS object,
+// followed by a newline. Nothing is printed if the object is null.
+#define CSE_GNSS_LOG(gnss, level, ...) CSE_GNSS::log (gnss, level, __VA_ARGS__)
+
+#if CSE_GNSS_LOG_LEVEL >= CSE_GNSS_LOG_LEVEL_ERROR
+  #define CSE_GNSS_LOG_ERROR(gnss, ...) CSE_GNSS_LOG (gnss, CSE_GNSS_LOG_LEVEL_ERROR, __VA_ARGS__)
+#else
+  #define CSE_GNSS_LOG_ERROR(gnss, ...) do {} while (0)
+#endif
+
+#if CSE_GNSS_LOG_LEVEL >= CSE_GNSS_LOG_LEVEL_WARN
+  #define CSE_GNSS_LOG_WARN(gnss, ...) CSE_GNSS_LOG (gnss, CSE_GNSS_LOG_LEVEL_WARN, __VA_ARGS__)
+#else
+  #define CSE_GNSS_LOG_WARN(gnss, ...) do {} while (0)
+#endif
+
+#if CSE_GNSS_LOG_LEVEL >= CSE_GNSS_LOG_LEVEL_INFO
+  #define CSE_GNSS_LOG_INFO(gnss, ...) CSE_GNSS_LOG (gnss, CSE_GNSS_LOG_LEVEL_INFO, __VA_ARGS__)
+#else
+  #define CSE_GNSS_LOG_INFO(gnss, ...) do {} while (0)
+#endif
+
+#if CSE_GNSS_LOG_LEVEL >= CSE_GNSS_LOG_LEVEL_DEBUG
+  #define CSE_GNSS_LOG_DEBUG(gnss, ...) CSE_GNSS_LOG (gnss, CSE_GNSS_LOG_LEVEL_DEBUG, __VA_ARGS__)
+#else
+  #define CSE_GNSS_LOG_DEBUG(gnss, ...) do {} while (0)
+#endif
 
 //======================================================================================//
 // Forward declarations.
 
 class CSE_GNSS;
+class NMEA_0183_Data;
+class NMEA_Change_Tracker;
+struct NMEA_Fix;
+
+//======================================================================================//
+/**
+ * @brief The function type that starts a serial port at the given baudrate. CSE_GNSS keeps
+ * the GNSS port as a Stream and uses this to call the begin() of the actual port type.
+ * 
+ */
+typedef void (*NMEA_Port_Begin) (Stream* port, unsigned long baud);
+
+//======================================================================================//
+/**
+ * @brief The function type that receives the complete sentences from the framer. The
+ * sentence starts with the '$' and ends with the two checksum characters. It is not null
+ * terminated and is only valid until the next byte is fed to the framer.
+ * 
+ */
+typedef void (*NMEA_Sentence_Handler) (const char* sentence, uint16_t length, void* context);
+
+//======================================================================================//
+/**
+ * @brief The function type that decides whether the framer keeps a sentence, after seeing
+ * only its first NMEA_Framer::HeaderLength characters, eg. "$GPGSV". Return false to skip
+ * the rest of the sentence.
+ * 
+ */
+typedef bool (*NMEA_Sentence_Filter) (const char* header, void* context);
+
+//======================================================================================//
+/**
+ * @brief The function type of the clock that stamps the arrival of the sentences. Returns
+ * a free-running time in microseconds that wraps at 2^32, like micros().
+ * 
+ */
+typedef uint32_t (*NMEA_Clock) ();
+
+//======================================================================================//
+/**
+ * @brief The function type that receives the parsed sentences from CSE_GNSS. It is called
+ * as soon as a sentence is framed, its checksum is verified and its fields are parsed. The
+ * data object and its fields are only valid until the next sentence of the same type.
+ * 
+ */
+typedef void (*NMEA_Data_Handler) (NMEA_0183_Data& data, void* context);
+
+//======================================================================================//
+/**
+ * @brief The function type that receives the epochs published by an NMEA_Epoch or merged
+ * by an NMEA_Batch_Parser. The fix is only valid during the call.
+ * 
+ */
+typedef void (*NMEA_Epoch_Handler) (const NMEA_Fix& fix, void* context);
+
+//======================================================================================//
+/**
+ * @brief A resumable NMEA sentence framer. Bytes can be fed one at a time or in chunks of
+ * any size. The framing state is kept across the calls, so a sentence that is split between
+ * two reads is still framed correctly, and each complete sentence is emitted exactly once.
+ * 
+ */
+class NMEA_Framer {
+  private:
+    enum State : uint8_t {
+      STATE_IDLE, // Waiting for a '$'
+      STATE_BODY, // Collecting the sentence body until the '*'
+      STATE_CHECKSUM_1, // Waiting for the first checksum character
+      STATE_CHECKSUM_2  // Waiting for the second checksum character
+    };
+
+    State state; // The current framing state
+    char sentenceBuffer [CONST_MAX_NMEA_SENTENCE_LENGTH + 1]; // The sentence being framed
+    uint16_t sentenceLength; // The number of valid characters in the sentenceBuffer
+    uint8_t checksum; // Running XOR of the characters between the '$' and the '*'
+    uint8_t receivedChecksum; // The checksum value received after the '*'
+    NMEA_Sentence_Handler handler; // The function to call when a sentence is complete
+    void* handlerContext; // User pointer passed to the handler
+    uint32_t sentenceCount; // Number of valid sentences framed
+    uint32_t checksumErrorCount; // Number of sentences dropped due to checksum mismatch
+    NMEA_Sentence_Filter filter; // The function that accepts or rejects the sentence headers
+    void* filterContext; // User pointer passed to the filter
+    uint32_t filteredCount; // Number of sentences rejected by the filter
+    uint32_t oversizeCount; // Number of sentences dropped for being longer than CONST_MAX_NMEA_SENTENCE_LENGTH
+    uint32_t truncatedCount; // Number of sentences cut short before their checksum
+    uint32_t droppedByteCount; // Number of bytes in the dropped sentences
+    NMEA_Clock timeSource; // The clock that stamps the '$' of each sentence. nullptr to not stamp.
+    uint32_t sentenceTime; // The clock time when the '$' of the current sentence arrived
+    bool chunkFeeding; // True between beginChunk() and endChunk()
+    bool chunkStamped; // True when the clock has been read for the current chunk
+
+    void drop (uint32_t& counter) { counter++; droppedByteCount += sentenceLength; reset(); } // Count and discard the partial sentence
+
+  public:
+    static const uint8_t HeaderLength = 6; // The number of characters given to the filter, including the '$'
+
+    NMEA_Framer();
+    static uint8_t computeChecksum (const char* data, size_t length); // XOR of all the bytes
+    void setHandler (NMEA_Sentence_Handler handler, void* context = nullptr); // Set the sentence handler
+    void setFilter (NMEA_Sentence_Filter filter, void* context = nullptr); // Set the sentence header filter
+    void setClock (NMEA_Clock clock); // Set the clock that stamps the arrival of the sentences
+    static uint32_t getTime(); // Get the time of the default clock in microseconds
+    bool feed (char c); // Feed a single byte. Returns true if a sentence was completed.
+    uint16_t feed (const char* data, size_t length); // Feed a chunk of bytes. Returns the number of sentences completed.
+    size_t feedFrame (const char* data, size_t length); // Feed the bytes until the sentence ends. Returns the number of bytes used.
+    void beginChunk(); // Stamp the sentences that start until endChunk() with a single clock reading
+    void endChunk(); // Stamp each sentence again when its '$' is fed
+    void reset(); // Discard any partial sentence
+    bool isIdle() const { return state == STATE_IDLE; } // Check if the framer is between the sentences
+    const char* getSentence() const; // Get the last completed sentence (null terminated)
+    uint16_t getSentenceLength() const; // Get the length of the last completed sentence
+    uint32_t getSentenceTime() const { return sentenceTime; } // Get the clock time when the '$' of the last sentence arrived
+    uint32_t getSentenceCount() const; // Get the number of valid sentences framed
+    uint32_t getChecksumErrorCount() const; // Get the number of sentences dropped due to checksum mismatch
+    uint32_t getFilteredCount() const; // Get the number of sentences rejected by the filter
+    uint32_t getOversizeCount() const { return oversizeCount; } // Get the number of sentences that were too long
+    uint32_t getTruncatedCount() const { return truncatedCount; } // Get the number of sentences cut short before their checksum
+    uint32_t getDroppedByteCount() const { return droppedByteCount; } // Get the number of bytes in the dropped sentences
+    void resetCounts(); // Set all the counters to 0
+};
+
+//======================================================================================//
+/**
+ * @brief A lock-free single-producer, single-consumer ring buffer for the incoming bytes.
+ * One side, usually a UART interrupt, a DMA callback or another core, pushes the bytes
+ * while the loop pops them and feeds them to the framer. No locks or disabled interrupts
+ * are needed as long as there is exactly one producer and one consumer.
+ * 
+ * The head and tail are free-running counters and are only written by one side each. On
+ * the platforms with <atomic> they are std::atomic with acquire/release ordering. On AVR,
+ * where 8-bit loads and stores are already atomic, they are volatile 8-bit counters with a
+ * compiler barrier, which limits the capacity to 128 bytes there.
+ * 
+ * @tparam Capacity The number of bytes the buffer can hold. Must be a power of 2.
+ */
+template <size_t Capacity>
+class NMEA_Ring_Buffer {
+  private:
+    static_assert ((Capacity > 1) && ((Capacity & (Capacity - 1)) == 0), "NMEA_Ring_Buffer capacity must be a power of 2.");
+    static_assert (Capacity <= CONST_RING_MAX_CAPACITY, "NMEA_Ring_Buffer capacity is too large for the index type.");
+
+    static const NMEA_Ring_Index Mask = Capacity - 1;
+
+    char buffer [Capacity]; // The bytes
+    NMEA_Ring_Counter head; // Total bytes pushed. Only written by the producer.
+    NMEA_Ring_Counter tail; // Total bytes popped. Only written by the consumer.
+    NMEA_Ring_Counter overflowCount; // Bytes dropped because the buffer was full. Only written by the producer.
+
+  public:
+    NMEA_Ring_Buffer() : head (0), tail (0), overflowCount (0) {}
+
+    //==================================================================================//
+    // Producer side
+
+    // Push a single byte. Returns false and counts an overflow if the buffer is full.
+    bool push (char c) {
+      NMEA_Ring_Index h = CSE_GNSS_RING_LOAD (head, relaxed);
+
+      if ((NMEA_Ring_Index) (h - CSE_GNSS_RING_LOAD (tail, acquire)) >= Capacity) {
+        CSE_GNSS_RING_STORE (overflowCount, CSE_GNSS_RING_LOAD (overflowCount, relaxed) + 1, relaxed);
+        return false;
+      }
+
+      buffer [h & Mask] = c;
+      CSE_GNSS_RING_STORE (head, h + 1, release);
+      return true;
+    }
+
+    // Push a chunk of bytes. Returns the number of bytes pushed. The rest are counted as overflow.
+    size_t push (const char* data, size_t length) {
+      NMEA_Ring_Index h = CSE_GNSS_RING_LOAD (head, relaxed);
+      size_t space = Capacity - (NMEA_Ring_Index) (h - CSE_GNSS_RING_LOAD (tail, acquire));
+      size_t count = (length < space) ? length : space;
+      size_t offset = h & Mask;
+      size_t first = ((Capacity - offset) < count) ? (Capacity - offset) : count;
+
+      memcpy (buffer + offset, data, first);
+      memcpy (buffer, data + first, count - first);
+
+      if (count < length) {
+        CSE_GNSS_RING_STORE (overflowCount, CSE_GNSS_RING_LOAD (overflowCount, relaxed) + (length - count), relaxed);
+      }
+
+      CSE_GNSS_RING_STORE (head, h + count, release);
+      return count;
+    }
+
+    //==================================================================================//
+    // Consumer side
+
+    // Pop a single byte. Returns false if the buffer is empty.
+    bool pop (char& c) {
+      NMEA_Ring_Index t = CSE_GNSS_RING_LOAD (tail, relaxed);
+
+      if (CSE_GNSS_RING_LOAD (head, acquire) == t) {
+        return false;
+      }
+
+      c = buffer [t & Mask];
+      CSE_GNSS_RING_STORE (tail, t + 1, release);
+      return true;
+    }
+
+    // Get the longest contiguous run of bytes that can be read without copying. Call
+    // consume() after using them. Returns the number of bytes, 0 if the buffer is empty.
+    size_t peek (const char*& data) const {
+      NMEA_Ring_Index t = CSE_GNSS_RING_LOAD (tail, relaxed);
+      size_t count = (NMEA_Ring_Index) (CSE_GNSS_RING_LOAD (head, acquire) - t);
+      size_t offset = t & Mask;
+
+      data = buffer + offset;
+      return ((Capacity - offset) < count) ? (Capacity - offset) : count;
+    }
+
+    // Release the bytes read through peek() back to the producer.
+    void consume (size_t count) {
+      CSE_GNSS_RING_STORE (tail, CSE_GNSS_RING_LOAD (tail, relaxed) + count, release);
+    }
+
+    // Get the number of bytes waiting to be read.
+    size_t available() const {
+      return (NMEA_Ring_Index) (CSE_GNSS_RING_LOAD (head, acquire) - CSE_GNSS_RING_LOAD (tail, relaxed));
+    }
+
+    //==================================================================================//
+
+    static size_t getCapacity() { return Capacity; } // Get the capacity in bytes
+    uint32_t getOverflowCount() const { return CSE_GNSS_RING_LOAD (overflowCount, relaxed); } // Get the number of bytes dropped
+};
+
+//======================================================================================//
+/**
+ * @brief A byte source that reads from a buffer in memory, such as a log file loaded from
+ * an SD card. It is a Stream, so it can replace the serial port of a CSE_GNSS object, and
+ * it can also be passed to CSE_GNSS::feed() directly, which frames the bytes in place
+ * without copying them to the gnssDataBuffer. The buffer is not copied and must stay valid
+ * while the source is used.
+ * 
+ */
+class NMEA_Memory_Source : public Stream {
+  protected:
+    const char* data; // The first byte of the buffer
+    size_t length; // The number of bytes in the buffer
+    size_t position; // The number of bytes read so far
+
+  public:
+    NMEA_Memory_Source();
+    NMEA_Memory_Source (const char* data, size_t length);
+    void set (const char* data, size_t length); // Set a new buffer and start from its beginning
+    size_t getRemaining() const; // Get the number of bytes not read yet
+    const char* getData() const { return data + position; } // Get the first byte not read yet
+
+    // Zero-copy access used by CSE_GNSS::feed().
+    size_t peek (const char*& data) const; // Get the next run of bytes that can be read in place
+    void consume (size_t count); // Mark the bytes as read
+
+    // Stream interface
+    using Print::write;
+    int available() override;
+    int read() override;
+    int peek() override;
+    size_t write (uint8_t c) override; // The source is read-only
+};
+
+#if defined(__linux__)
+//======================================================================================//
+/**
+ * @brief A log file mapped to memory on Linux. The file is read directly from the page
+ * cache, so logs much larger than the RAM can be processed without copying. Pass the
+ * object to CSE_GNSS::feed() to parse the whole file.
+ * 
+ */
+class NMEA_Mapped_File : public NMEA_Memory_Source {
+  private:
+    void* mapping; // The start of the mapping. nullptr if no file is open.
+    size_t mappingLength; // The size of the mapping in bytes
+    bool opened; // True if a file is open. An empty file is open but not mapped.
+
+  public:
+    NMEA_Mapped_File();
+    NMEA_Mapped_File (const NMEA_Mapped_File&) = delete;
+    NMEA_Mapped_File& operator= (const NMEA_Mapped_File&) = delete;
+    ~NMEA_Mapped_File();
+
+    bool open (const char* path); // Map a file. Closes the previous one.
+    void close(); // Unmap the file
+    bool isOpen() const; // Check if a file is open
+};
+#endif
+
+//======================================================================================//
+/**
+ * @brief A lightweight view of a single field inside an NMEA sentence. The data points into
+ * the sentence buffer of the NMEA_0183_Data object and is not null terminated. The view is
+ * only valid until the next sentence is set to the object.
+ * 
+ */
+struct NMEA_Field {
+  const char* data; // The first character of the field
+  uint8_t length; // The number of characters in the field
+
+  bool isEmpty() const; // Check if the field has no characters
+  bool equals (const char* str) const; // Compare the field with a null terminated string
+  String toString() const; // Copy the field to a String
+};
+
+//======================================================================================//
+/**
+ * @brief The metadata of a built-in sentence schema. The instances are constant, so they
+ * are kept in flash (rodata) on most platforms instead of RAM.
+ * 
+ */
+struct NMEA_Schema_Info {
+  const char* type; // Sentence type without the talker. eg. "RMC"
+  const char* description; // User-readable sentence description
+  const char* sample; // A complete sample sentence with a valid checksum
+  const char* const* fieldNames; // Field names in the order they appear
+  uint8_t fieldCount; // Number of fields in the full sentence, including the header and checksum
+  uint8_t minFieldCount; // Number of fields in the shortest valid variant of the sentence
+
+  // Counts the commas in a string at compile time.
+  static constexpr uint8_t countCommas (const char* str) {
+    return (*str == 0) ? 0 : ((*str == ',') ? 1 : 0) + countCommas (str + 1);
+  }
+};
 
 //======================================================================================//
 /**
@@ -40,26 +525,1090 @@ class CSE_GNSS;
  * 
  */
 class NMEA_0183_Data {
+  private:
+    mutable uint16_t indexPosition; // Where the indexing of the fields stopped. Past the sentenceLength when all are indexed.
+    bool parsed; // True if the last parse() succeeded
+    bool lazy; // True if the fields are indexed on the first access instead of in parse()
+    bool verified; // True if the checksum of the sentence was verified by a framer before set()
+
+    bool indexFields (int index) const; // Index the fields up to the given index
+
   public:
     CSE_GNSS* GNSS_Parent; // The parent GNSS object
 
     String name; // NMEA sentence type/name
     String description; // User-readable NMEA sentence description
-    String sentence; // Comma separated NMEA sentence
     String sample; // NMEA sentence sample
     int dataCount; // Number of data in the NMEA sentence, including the header and separate checksum
+    int minDataCount; // Number of data in the shortest valid variant of the sentence
+    const NMEA_Schema_Info* schema; // The built-in schema of the sentence. nullptr if not built-in.
     const static int dataMax = CONST_MAX_NMEA_FIELDS_COUNT; // Maximum number of data fields in the NMEA sentence
-    String dataList [dataMax]; // NMEA data fields as an array of strings
-    String dataNameList [dataMax]; // NMEA data field names as an array of strings
+    const String* dataNameList; // NMEA data field names. Points to the array passed to the constructor.
+
+    char sentence [CONST_MAX_NMEA_SENTENCE_LENGTH + 1]; // Comma separated NMEA sentence, null terminated
+    uint16_t sentenceLength; // Number of characters in the sentence
+    mutable uint8_t fieldCount; // Number of fields indexed. In the lazy mode, only the ones up to the last field accessed.
+    mutable uint8_t fieldOffsets [dataMax]; // Position of each field in the sentence
+    mutable uint8_t fieldLengths [dataMax]; // Length of each field
+    NMEA_Data_Handler handler; // Called after each sentence is parsed. nullptr if not set.
+    void* handlerContext; // User pointer passed to the handler
+    NMEA_Change_Tracker* changeTracker; // Compares each parsed sentence with the previous one. nullptr if not set.
+    uint32_t arrivalTime; // The clock time when the '$' of the sentence arrived. 0 if it was not framed by CSE_GNSS.
 
     NMEA_0183_Data (String name, String description, int dataCount, String dataNames[], String sample);
+    NMEA_0183_Data (const char* talker, const NMEA_Schema_Info* schema);
     bool parse(); // Parse the NMEA sentence
     bool print(); // Print the NMEA sentence
     bool set (String line); // Set the NMEA sentence
+    bool set (const char* line, uint16_t length, bool verified = false); // Set the NMEA sentence from a character buffer
     bool check (String line); // Check if the NMEA sentence is valid
+    bool check (const char* line, uint16_t length); // Check if the NMEA sentence in a character buffer is valid
     bool find (String lines, int occurrence = 1); // Find the NMEA sentence in the lines
     int count (String lines); // Count the number of particular NMEA sentence in the lines
-    int getDataIndex (String dataName); // Get the index of the data field name
+    int getDataIndex (String dataName) const; // Get the index of the data field name
+    NMEA_Field getField (int index) const; // Get a parsed field by its index
+    NMEA_Field getField (String dataName) const; // Get a parsed field by its name
+    uint8_t getFieldCount() const; // Get the number of fields, indexing all of them in the lazy mode
+    bool isParsed() const { return parsed; } // Check if the last parse() succeeded
+    void setLazy (bool lazy); // Index the fields on the first access instead of in parse()
+    void setHandler (NMEA_Data_Handler handler, void* context = nullptr); // Set the handler for this sentence type
+    void setChangeTracker (NMEA_Change_Tracker* tracker); // Set the tracker that finds the fields changed since the previous sentence
+    bool isChanged (int index) const; // Check if a field changed since the previous sentence. Always true without a tracker.
+};
+
+static_assert ((CONST_DISPATCH_TABLE_SIZE & (CONST_DISPATCH_TABLE_SIZE - 1)) == 0, "CONST_DISPATCH_TABLE_SIZE must be a power of 2.");
+static_assert ((CONST_DISPATCH_TABLE_SIZE > CONST_MAX_NMEA_DATA_COUNT) && (CONST_DISPATCH_TABLE_SIZE <= 256), "CONST_DISPATCH_TABLE_SIZE must be larger than CONST_MAX_NMEA_DATA_COUNT and not exceed 256.");
+
+//======================================================================================//
+/**
+ * @brief A compact fix record with the decoded values in fixed-point integers. The fields
+ * are ordered by size so that there is no padding between them. The flags tell which
+ * fields hold a decoded value. Decoding more sentences into the same record merges them.
+ * 
+ */
+struct NMEA_Fix {
+  enum Flags : uint16_t {
+    FLAG_VALID = 0x01, // The receiver reported a valid fix (RMC/GLL status A, GGA quality > 0)
+    FLAG_POSITION = 0x02, // latitude and longitude are set
+    FLAG_ALTITUDE = 0x04, // altitude is set
+    FLAG_TIME = 0x08, // time is set
+    FLAG_DATE = 0x10, // date is set
+    FLAG_SPEED = 0x20, // speed is set
+    FLAG_COURSE = 0x40, // course is set
+    FLAG_QUALITY = 0x80, // quality, satellites and hdop are set
+    FLAG_DOP = 0x100, // fixMode, pdop, hdop and vdop are set
+    FLAG_SATELLITES_IN_VIEW = 0x200 // satellitesInView is set
+  };
+
+  int32_t latitude; // Degrees x 10^7. Positive is north.
+  int32_t longitude; // Degrees x 10^7. Positive is east.
+  int32_t altitude; // Altitude above the mean sea level in millimetres
+  uint32_t time; // UTC time in milliseconds since midnight
+  int32_t speed; // Ground speed in millimetres per second
+  uint16_t date; // UTC date in days since 01-01-1970
+  uint16_t course; // Course over ground in degrees x 100
+  uint16_t hdop; // Horizontal dilution of precision x 100
+  uint16_t pdop; // Position dilution of precision x 100
+  uint16_t vdop; // Vertical dilution of precision x 100
+  uint16_t flags; // Combination of the Flags
+  uint8_t quality; // GGA fix quality
+  uint8_t satellites; // Number of satellites used
+  uint8_t fixMode; // GSA fix type. 1 = No fix, 2 = 2D, 3 = 3D.
+  uint8_t satellitesInView; // Number of satellites in view
+
+  bool operator== (const NMEA_Fix& fix) const; // Compare all the fields
+  bool operator!= (const NMEA_Fix& fix) const { return !(*this == fix); }
+};
+
+//======================================================================================//
+/**
+ * @brief Converts the NMEA fields to fixed-point integers. The digits are converted with
+ * plain integer loops, without strtod() or floats, so they are fast and exact on the
+ * microcontrollers without an FPU. All the functions return false if the field is empty
+ * or not in the expected format, and leave the output unchanged in that case.
+ * 
+ */
+class NMEA_Decoder {
+  public:
+    static bool decodeFixed (NMEA_Field field, uint8_t decimals, int32_t& value); // "-12.345" to an integer scaled by 10^decimals
+    static bool decodeCoordinate (NMEA_Field value, NMEA_Field hemisphere, int32_t& degrees); // "ddmm.mmmm" + "N/S/E/W" to degrees x 10^7
+    static bool decodeTime (NMEA_Field field, uint32_t& time); // "hhmmss.sss" to milliseconds since midnight
+    static bool decodeDate (NMEA_Field field, uint16_t& date); // "ddmmyy" to days since 01-01-1970
+    static bool decodeDate (NMEA_Field day, NMEA_Field month, NMEA_Field year, uint16_t& date); // ZDA date to days since 01-01-1970
+    static bool decodeSpeedKnots (NMEA_Field field, int32_t& speed); // Knots to millimetres per second
+    static bool decodeSpeedKmh (NMEA_Field field, int32_t& speed); // km/h to millimetres per second
+    static bool decodeCourse (NMEA_Field field, uint16_t& course); // Degrees to degrees x 100
+    static int32_t getDaysFromCivil (int32_t year, uint8_t month, uint8_t day); // Days since 01-01-1970
+};
+
+//======================================================================================//
+// Built-in sentence schemas. The field indices are enumerations, so they are resolved at
+// compile time. The field tables and the samples are checked against each other with
+// static_assert. Trailing fields that are missing in the older NMEA versions are still
+// listed, and minFieldCount allows those shorter variants.
+
+/**
+ * @brief RMC - Recommended Minimum Specific GNSS Data.
+ * 
+ */
+struct NMEA_RMC {
+  enum Field : uint8_t {
+    Header, UTC, Status, Latitude, LatitudeDirection, Longitude, LongitudeDirection, Speed, Course,
+    Date, MagVariation, MagVariationDirection, Mode, NavigationStatus, Checksum
+  };
+
+  static const uint8_t FieldCount = Checksum + 1;
+  static constexpr const char* Sample = "$GNRMC,083559.00,A,4717.11437,N,00833.91522,E,0.004,77.52,091202,,,A,V*33";
+  static const NMEA_Schema_Info Info;
+
+  static bool decode (const NMEA_0183_Data& data, NMEA_Fix& fix); // Decode the fields to a fix
+};
+
+/**
+ * @brief GGA - Global Positioning System Fix Data.
+ * 
+ */
+struct NMEA_GGA {
+  enum Field : uint8_t {
+    Header, UTC, Latitude, LatitudeDirection, Longitude, LongitudeDirection, Quality, Satellites, HDOP,
+    Altitude, AltitudeUnit, Separation, SeparationUnit, DifferentialAge, DifferentialStation, Checksum
+  };
+
+  static const uint8_t FieldCount = Checksum + 1;
+  static constexpr const char* Sample = "$GNGGA,092725.00,4717.11399,N,00833.91590,E,1,08,1.01,499.6,M,48.0,M,,*45";
+  static const NMEA_Schema_Info Info;
+
+  static bool decode (const NMEA_0183_Data& data, NMEA_Fix& fix); // Decode the fields to a fix
+};
+
+/**
+ * @brief GSA - GNSS DOP and Active Satellites.
+ * 
+ */
+struct NMEA_GSA {
+  enum Field : uint8_t {
+    Header, Mode, FixType, Satellite1, Satellite2, Satellite3, Satellite4, Satellite5, Satellite6,
+    Satellite7, Satellite8, Satellite9, Satellite10, Satellite11, Satellite12, PDOP, HDOP, VDOP,
+    SystemId, Checksum
+  };
+
+  static const uint8_t FieldCount = Checksum + 1;
+  static constexpr const char* Sample = "$GNGSA,A,3,23,29,07,08,09,18,26,28,,,,,1.94,1.18,1.54,1*0E";
+  static const NMEA_Schema_Info Info;
+
+  static bool decode (const NMEA_0183_Data& data, NMEA_Fix& fix); // Decode the fields to a fix
+};
+
+/**
+ * @brief GSV - GNSS Satellites in View. A sentence carries up to four satellites.
+ * 
+ */
+struct NMEA_GSV {
+  enum Field : uint8_t {
+    Header, MessageCount, MessageNumber, SatellitesInView,
+    PRN1, Elevation1, Azimuth1, SNR1, PRN2, Elevation2, Azimuth2, SNR2,
+    PRN3, Elevation3, Azimuth3, SNR3, PRN4, Elevation4, Azimuth4, SNR4,
+    SignalId, Checksum
+  };
+
+  static const uint8_t FieldCount = Checksum + 1;
+  static constexpr const char* Sample = "$GPGSV,3,1,10,23,38,230,44,29,71,156,47,07,29,116,41,08,09,081,36,1*62";
+  static const NMEA_Schema_Info Info;
+
+  static bool decode (const NMEA_0183_Data& data, NMEA_Fix& fix); // Decode the fields to a fix
+  static NMEA_Field getField (const NMEA_0183_Data& data, uint8_t index); // Get a field by its index, with the signal ID after the last satellite
+};
+
+/**
+ * @brief VTG - Course Over Ground and Ground Speed.
+ * 
+ */
+struct NMEA_VTG {
+  enum Field : uint8_t {
+    Header, CourseTrue, CourseTrueUnit, CourseMagnetic, CourseMagneticUnit, SpeedKnots, SpeedKnotsUnit,
+    SpeedKmh, SpeedKmhUnit, Mode, Checksum
+  };
+
+  static const uint8_t FieldCount = Checksum + 1;
+  static constexpr const char* Sample = "$GNVTG,77.52,T,,M,0.004,N,0.008,K,A*18";
+  static const NMEA_Schema_Info Info;
+
+  static bool decode (const NMEA_0183_Data& data, NMEA_Fix& fix); // Decode the fields to a fix
+};
+
+/**
+ * @brief GLL - Geographic Position, Latitude/Longitude.
+ * 
+ */
+struct NMEA_GLL {
+  enum Field : uint8_t {
+    Header, Latitude, LatitudeDirection, Longitude, LongitudeDirection, UTC, Status, Mode, Checksum
+  };
+
+  static const uint8_t FieldCount = Checksum + 1;
+  static constexpr const char* Sample = "$GNGLL,4717.11364,N,00833.91565,E,092321.00,A,A*7E";
+  static const NMEA_Schema_Info Info;
+
+  static bool decode (const NMEA_0183_Data& data, NMEA_Fix& fix); // Decode the fields to a fix
+};
+
+/**
+ * @brief ZDA - Time and Date.
+ * 
+ */
+struct NMEA_ZDA {
+  enum Field : uint8_t {
+    Header, UTC, Day, Month, Year, LocalZoneHours, LocalZoneMinutes, Checksum
+  };
+
+  static const uint8_t FieldCount = Checksum + 1;
+  static constexpr const char* Sample = "$GNZDA,082710.00,16,09,2002,00,00*7A";
+  static const NMEA_Schema_Info Info;
+
+  static bool decode (const NMEA_0183_Data& data, NMEA_Fix& fix); // Decode the fields to a fix
+};
+
+static_assert (NMEA_Schema_Info::countCommas (NMEA_RMC::Sample) == (NMEA_RMC::FieldCount - 2), "NMEA_RMC fields do not match the sample.");
+static_assert (NMEA_Schema_Info::countCommas (NMEA_GGA::Sample) == (NMEA_GGA::FieldCount - 2), "NMEA_GGA fields do not match the sample.");
+static_assert (NMEA_Schema_Info::countCommas (NMEA_GSA::Sample) == (NMEA_GSA::FieldCount - 2), "NMEA_GSA fields do not match the sample.");
+static_assert (NMEA_Schema_Info::countCommas (NMEA_GSV::Sample) == (NMEA_GSV::FieldCount - 2), "NMEA_GSV fields do not match the sample.");
+static_assert (NMEA_Schema_Info::countCommas (NMEA_VTG::Sample) == (NMEA_VTG::FieldCount - 2), "NMEA_VTG fields do not match the sample.");
+static_assert (NMEA_Schema_Info::countCommas (NMEA_GLL::Sample) == (NMEA_GLL::FieldCount - 2), "NMEA_GLL fields do not match the sample.");
+static_assert (NMEA_Schema_Info::countCommas (NMEA_ZDA::Sample) == (NMEA_ZDA::FieldCount - 2), "NMEA_ZDA fields do not match the sample.");
+
+//======================================================================================//
+/**
+ * @brief An NMEA_0183_Data object built from one of the schemas above. The fields are
+ * accessed with get<>() using the schema's field names, so there are no string compares.
+ * For example, `NMEA_Sentence <NMEA_RMC> RMC ("GN")` and `RMC.get <NMEA_RMC::Latitude>()`.
+ * 
+ * @tparam Schema One of the NMEA_* schema structs.
+ */
+template <typename Schema>
+class NMEA_Sentence : public NMEA_0183_Data {
+  static_assert (Schema::FieldCount <= CONST_MAX_NMEA_FIELDS_COUNT, "The schema has more fields than CONST_MAX_NMEA_FIELDS_COUNT.");
+
+  private:
+    // The schemas whose fields are always in the same place. The shorter variants leave
+    // out the fields at the end.
+    NMEA_Field getSchemaField (uint8_t index, const void*) const {
+      if (index == Schema::Checksum) {
+        return getField (getFieldCount() - 1);
+      }
+
+      NMEA_Field field = getField (index);
+
+      // The field after the '*' is the checksum of a shorter variant.
+      if ((field.data > sentence) && (field.data [-1] == '*')) {
+        return getField (-1);
+      }
+
+      return field;
+    }
+
+    // A GSV sentence has 1 to 4 satellites, so the signal ID moves with the last one.
+    NMEA_Field getSchemaField (uint8_t index, const NMEA_GSV*) const {
+      return NMEA_GSV::getField (*this, index);
+    }
+
+  public:
+    NMEA_Sentence (const char* talker = "GN") : NMEA_0183_Data (talker, &Schema::Info) {}
+
+    // Get a field by its schema index. A field that is missing in a shorter variant of the
+    // sentence is returned empty, and the Checksum is always the last field.
+    template <uint8_t index>
+    NMEA_Field get() const {
+      static_assert (index < Schema::FieldCount, "Field index is out of range for this sentence.");
+      return getSchemaField (index, (const Schema*) nullptr);
+    }
+
+    // Decode the fields to a fix record. Available for all the built-in schemas.
+    bool decode (NMEA_Fix& fix) const {
+      return Schema::decode (*this, fix);
+    }
+};
+
+// The field offsets are saved as 8-bit values.
+static_assert (CONST_MAX_NMEA_SENTENCE_LENGTH <= 255, "CONST_MAX_NMEA_SENTENCE_LENGTH must not exceed 255.");
+
+//======================================================================================//
+/**
+ * @brief Finds the fields of a sentence type that changed since the previous sentence of
+ * the same type. A 32-bit hash of each field is kept instead of the sentence, and each new
+ * sentence sets a bit in the change mask for every field whose hash is different. The
+ * fields from MaxFields - 1 on share the last bit. The checksum is not compared, since it
+ * changes with any other field.
+ * 
+ * Attach a tracker to a data object with setChangeTracker(). It is then updated by every
+ * successful parse(), and CSE_GNSS does not call the handlers for the sentences in which
+ * only the ignored fields, such as the UTC time, changed.
+ * 
+ */
+class NMEA_Change_Tracker {
+  public:
+    static const uint8_t MaxFields = 32; // The number of bits in the change mask
+
+  private:
+    uint32_t fieldHashes [MaxFields]; // The hash of each field of the previous sentence
+    uint32_t changedFields; // One bit per field that changed in the last sentence
+    uint32_t ignoredFields; // One bit per field whose change does not count
+    uint32_t unchangedCount; // The number of sentences that had no change in the fields that count
+    uint8_t fieldCount; // The number of hashes saved from the previous sentence
+    bool compared; // True if there is a previous sentence
+
+  public:
+    NMEA_Change_Tracker (uint32_t ignoredFields = 0);
+    bool update (const NMEA_0183_Data& data); // Compare a parsed sentence with the previous one. Returns true if a field that counts changed.
+    void reset(); // Forget the previous sentence, so that all the fields of the next one are changed
+    void setIgnoredFields (uint32_t mask); // Set the fields whose change does not count, one bit per field index
+    bool isChanged() const; // Check if a field that counts changed in the last sentence
+    bool isChanged (int index) const; // Check if a field changed in the last sentence
+    uint32_t getChangedFields() const { return changedFields; } // Get one bit per field that changed in the last sentence
+    uint32_t getUnchangedCount() const { return unchangedCount; } // Get the number of sentences without a change that counts
+    static uint32_t getHash (NMEA_Field field, uint32_t hash = 2166136261UL); // FNV-1a hash of a field and its separator
+};
+
+//======================================================================================//
+/**
+ * @brief Groups the sentences of one navigation epoch into a single NMEA_Fix. A sentence
+ * with a UTC time different from the current epoch closes it, and so does the sentence
+ * type set with setLastSentence(). The closed epoch is published to one of two slots and
+ * a sequence counter is advanced, so that the readers, even on another core or task, get
+ * a consistent copy with read() without any locks. Only one thread may call add().
+ * 
+ */
+class NMEA_Epoch {
+  private:
+    NMEA_Fix working; // The epoch being assembled
+    NMEA_Fix slots [2]; // The published epochs. The latest one is in slots [sequence & 1].
+    NMEA_Ring_Counter sequence; // The number of epochs published
+    uint32_t gsvTalkers; // One bit per talker whose satellites in view are counted in the working epoch
+    char lastType [4]; // The sentence type that closes an epoch. Empty if not set.
+    bool pending; // True if the working epoch has data that is not published yet
+    NMEA_Epoch_Handler handler; // Called for each published epoch. nullptr if not set.
+    void* handlerContext; // User pointer passed to the handler
+    uint32_t positionThreshold; // The distance in millimetres that the position has to move to call the handler. 0 to call it for every epoch.
+    int32_t handledLatitude; // The latitude of the last epoch passed to the handler
+    int32_t handledLongitude; // The longitude of the last epoch passed to the handler
+    uint32_t skippedCount; // The number of epochs not passed to the handler
+    uint16_t handledFlags; // The valid and position flags of the last epoch passed to the handler
+    uint8_t handledQuality; // The quality of the last epoch passed to the handler
+    bool handled; // True if an epoch has been passed to the handler
+
+    bool isMoved (const NMEA_Fix& fix) const; // Check if an epoch has to be passed to the handler
+
+  public:
+    NMEA_Epoch();
+    void add (const NMEA_0183_Data& data); // Add a parsed sentence to the working epoch
+    void publish(); // Publish the working epoch and start a new one
+    void setLastSentence (const char* type); // Publish right after this sentence type, eg. "GGA"
+    bool read (NMEA_Fix& fix) const; // Copy the latest epoch. Returns false if none is published yet.
+    NMEA_Ring_Index getSequence() const; // Get the number of epochs published
+    void setHandler (NMEA_Epoch_Handler handler, void* context = nullptr); // Set the function called for each published epoch
+    void setPositionThreshold (uint32_t distance); // Call the handler only when the position moves by more than the distance in millimetres
+    uint32_t getSkippedCount() const { return skippedCount; } // Get the number of epochs not passed to the handler
+    static void merge (NMEA_Fix& fix, const NMEA_Fix& from); // Merge the values that are set in one fix into another
+};
+
+//======================================================================================//
+/**
+ * @brief Relates the UTC time in the sentences to the clock that stamps their arrival, to
+ * measure how late the sentences arrive and to convert the local clock times to UTC, eg.
+ * to align the fixes with the samples of other sensors.
+ * 
+ * Every sentence with a UTC time gives a pair of UTC and arrival times. The sentence that
+ * arrived with the least delay after its UTC time is kept as the anchor, since the delay
+ * of the others also includes the time spent in the queues and buffers. The delay of each
+ * sentence is measured from the anchor. The anchor is replaced by the least delayed
+ * sentence of each window of samples, so that the drift between the clock and UTC is
+ * followed. The anchor itself has the fixed delay of the receiver and the port, which can
+ * only be measured with a reference such as a PPS edge stamped with the same clock.
+ * 
+ */
+class NMEA_Time_Sync {
+  private:
+    uint32_t anchorUtc; // The UTC time of the anchor in milliseconds since midnight
+    uint32_t anchorTime; // The arrival time of the anchor in microseconds
+    uint32_t windowUtc; // The UTC time of the least delayed sample of the window
+    uint32_t windowTime; // The arrival time of the least delayed sample of the window
+    uint8_t windowCount; // The number of samples in the window
+    uint8_t windowLength; // The number of samples after which the anchor is replaced
+    uint32_t lastDelay; // The delay of the last sample from the anchor in microseconds
+    uint32_t maxDelay; // The longest delay since the reset
+    uint32_t sampleCount; // The number of samples added
+    int32_t latency; // The delay of the anchor from UTC in microseconds, set with setLatency()
+
+    static int32_t getUtcDifference (uint32_t utcTime, uint32_t fromUtc); // Get the difference of two UTC times across midnight
+    static int32_t getRelativeDelay (uint32_t utcTime, uint32_t arrivalTime, uint32_t fromUtc, uint32_t fromTime); // Get the delay of a sample from another
+
+  public:
+    static const uint8_t DefaultWindowLength = 16; // The default number of samples after which the anchor is replaced
+    static const int32_t MaxUtcDifference = 1800000; // The samples farther than this from the anchor, in milliseconds, start again
+
+    NMEA_Time_Sync();
+    void add (uint32_t utcTime, uint32_t arrivalTime); // Add the UTC time and the arrival time of a sentence
+    void reset(); // Remove all the samples
+    void setWindowLength (uint8_t length); // Set the number of samples after which the anchor is replaced
+    bool isValid() const { return sampleCount > 0; } // Check if any sample has been added
+    uint32_t getSampleCount() const { return sampleCount; } // Get the number of samples added
+    uint32_t getOffset() const; // Get the arrival time minus the UTC time of the anchor in microseconds, wrapping at 2^32
+    uint32_t getDelay() const { return lastDelay; } // Get the delay of the last sentence from the anchor in microseconds
+    uint32_t getMaxDelay() const { return maxDelay; } // Get the longest delay from the anchor in microseconds
+    int32_t getLatency (uint32_t referenceUtc, uint32_t referenceTime) const; // Get the delay of the anchor from a reference, eg. a PPS edge
+    void setLatency (int32_t latency); // Set the delay of the anchor from UTC, for toUtc()
+    bool toUtc (uint32_t time, uint32_t& utcTime, uint16_t* microseconds = nullptr) const; // Convert a clock time to UTC milliseconds since midnight
+};
+
+//======================================================================================//
+/**
+ * @brief The compact binary record of an NMEA_Fix, used by NMEA_Record_Writer and
+ * NMEA_Record_Reader. A record is:
+ * 
+ *   Sync (0xA5), Header, Payload, CRC-16 (high byte first)
+ * 
+ * The header has the key bit (0x80) and the payload length (0 to 127). The payload is the
+ * flags of the fix followed by the fields that the flags mark as set, in the order of
+ * Field. Each field is the difference from the same field in the last record that had it,
+ * zigzag encoded and packed as a varint of 7 bits per byte. A key record starts from 0,
+ * so it can be decoded without the previous records. The CRC-16/CCITT covers the header
+ * and the payload.
+ * 
+ */
+struct NMEA_Record {
+  enum Field : uint8_t {
+    Latitude, Longitude, Altitude, Time, Speed, Date, Course, HDOP, PDOP, VDOP, Quality,
+    Satellites, FixMode, SatellitesInView, FieldCount
+  };
+
+  static const uint8_t Sync = 0xA5; // The first byte of each record
+  static const uint8_t KeyBit = 0x80; // Set in the header of the key records
+  static const uint8_t MaxPayloadLength = 3 + (FieldCount * 5); // Flags and fields as varints
+  static const uint8_t MaxLength = 2 + MaxPayloadLength + 2; // Sync, header, payload and CRC
+
+  static uint16_t computeCrc (const uint8_t* data, size_t length, uint16_t crc = 0xFFFF); // CRC-16/CCITT
+  static bool hasField (uint16_t flags, uint8_t field); // Check if the fix flags mark a field as set
+  static uint32_t getField (const NMEA_Fix& fix, uint8_t field); // Get a field of a fix as 32 bits
+  static void setField (NMEA_Fix& fix, uint8_t field, uint32_t value); // Set a field of a fix from 32 bits
+};
+
+//======================================================================================//
+/**
+ * @brief Encodes fixes to compact binary records for logging or forwarding. A record of an
+ * epoch is usually 15 to 25 bytes, compared to several hundred bytes of NMEA text. A key
+ * record is written first and then at every key interval, so that a reader can start or
+ * recover in the middle of a stream.
+ * 
+ */
+class NMEA_Record_Writer {
+  private:
+    NMEA_Fix previous; // The last value of each field written
+    uint16_t keyInterval; // Records between the key records. 0 for the first record only.
+    uint16_t recordsSinceKey; // Records written since the last key record
+    bool keyPending; // True if the next record must be a key record
+
+  public:
+    NMEA_Record_Writer (uint16_t keyInterval = 60);
+    uint8_t encode (const NMEA_Fix& fix, uint8_t* buffer); // Encode a fix. The buffer must have NMEA_Record::MaxLength bytes.
+    void reset(); // Make the next record a key record
+    void setKeyInterval (uint16_t interval); // Set the number of records between the key records
+};
+
+//======================================================================================//
+/**
+ * @brief Decodes a stream of binary records back to fixes. The bytes can be fed one at a
+ * time or in chunks of any size, like the NMEA_Framer. A record with a wrong CRC is
+ * dropped, and so are the delta records after it until the next key record. Since the
+ * sync byte can also appear inside a record, the bytes after the sync of a dropped record
+ * are looked at again for the next sync.
+ * 
+ */
+class NMEA_Record_Reader {
+  private:
+    enum State : uint8_t {
+      STATE_SYNC, // Waiting for the sync byte
+      STATE_HEADER, // Waiting for the header
+      STATE_PAYLOAD, // Collecting the payload
+      STATE_CRC_1, // Waiting for the first CRC byte
+      STATE_CRC_2 // Waiting for the second CRC byte
+    };
+
+    enum Step : uint8_t {
+      STEP_NONE, // More bytes are needed, or the record was dropped
+      STEP_DECODED, // A record was decoded to the fix
+      STEP_FALSE_SYNC // The sync byte did not start a record
+    };
+
+    State state; // The current state
+    uint8_t record [NMEA_Record::MaxLength - 1]; // The header, the payload and the CRC of the record being read
+    uint8_t recordLength; // The number of bytes in the record buffer
+    bool synced; // True after a key record, until an error
+    NMEA_Fix previous; // The last value of each field read
+    NMEA_Fix fix; // The last decoded fix
+    NMEA_Epoch_Handler handler; // Called for each decoded fix. nullptr if not set.
+    void* handlerContext; // User pointer passed to the handler
+    uint32_t recordCount; // Records decoded
+    uint32_t errorCount; // Records dropped due to a wrong CRC or payload
+    uint32_t skippedCount; // Delta records dropped while waiting for a key record
+
+    Step step (uint8_t c); // Feed a single byte to the state machine
+    uint8_t rescan(); // Feed the bytes after a false sync again
+    bool decodePayload(); // Decode the payload to the fix
+
+  public:
+    NMEA_Record_Reader();
+    void setHandler (NMEA_Epoch_Handler handler, void* context = nullptr); // Set the function called for each fix
+    bool feed (uint8_t c); // Feed a single byte. Returns true if a fix was decoded.
+    uint32_t feed (const uint8_t* data, size_t length); // Feed a chunk of bytes. Returns the number of fixes decoded.
+    void reset(); // Discard any partial record and wait for a key record
+    const NMEA_Fix& getFix() const { return fix; } // Get the last decoded fix
+    uint32_t getRecordCount() const { return recordCount; } // Get the number of records decoded
+    uint32_t getErrorCount() const { return errorCount; } // Get the number of records with a wrong CRC or payload
+    uint32_t getSkippedCount() const { return skippedCount; } // Get the number of delta records dropped before a key record
+};
+
+#if defined(__linux__)
+//======================================================================================//
+/**
+ * @brief Parses a large NMEA log in memory on several threads. Linux only. The log is split
+ * into chunks that start at a "$G" sentence, and the chunks are framed, parsed and grouped
+ * into epochs by a pool of threads. The epochs are then merged in the order of the log,
+ * joining the epochs that were split at the chunk boundaries, and sent to a handler.
+ * 
+ */
+class NMEA_Batch_Parser {
+  private:
+    unsigned threadCount; // The number of threads used by parse()
+    uint32_t sentenceCount; // Sentences framed by the last parse()
+    uint32_t checksumErrorCount; // Sentences dropped by the last parse() due to checksum mismatch
+
+  public:
+    NMEA_Batch_Parser (unsigned threadCount = 0); // 0 uses one thread per core
+    uint32_t parse (const char* data, size_t length, NMEA_Epoch_Handler handler, void* context = nullptr); // Parse a log and send the epochs in order
+    void setThreadCount (unsigned threadCount); // Set the number of threads. 0 uses one thread per core.
+    unsigned getThreadCount() const { return threadCount; } // Get the number of threads
+    uint32_t getSentenceCount() const { return sentenceCount; } // Get the number of sentences framed by the last parse()
+    uint32_t getChecksumErrorCount() const { return checksumErrorCount; } // Get the checksum errors of the last parse()
+    static size_t findChunkStart (const char* data, size_t length, size_t position); // Find the next "$G" at or after a position
+};
+#endif
+
+static_assert ((CONST_MAX_SATELLITES > 0) && (CONST_MAX_SATELLITES <= 255), "CONST_MAX_SATELLITES must be between 1 and 255.");
+
+//======================================================================================//
+/**
+ * @brief The SNR statistics of one constellation in an NMEA_Satellite_Table.
+ * 
+ */
+struct NMEA_Snr_Stats {
+  uint8_t inView; // Number of satellites in the table
+  uint8_t tracked; // Number of satellites with an SNR
+  uint8_t minSnr; // Lowest SNR of the tracked satellites in dB-Hz. 0 if none.
+  uint8_t maxSnr; // Highest SNR of the tracked satellites in dB-Hz. 0 if none.
+  uint8_t meanSnr; // Mean SNR of the tracked satellites in dB-Hz. 0 if none.
+};
+
+//======================================================================================//
+/**
+ * @brief Reassembles the GSV sentence groups into a table of satellites. The values are kept
+ * in parallel arrays, so that a loop over one of them, such as the SNR, reads contiguous
+ * bytes. The parts of a group are collected as they arrive, and the satellites of the group
+ * replace those of the same constellation and signal only when the last part is added. A
+ * group with a missing part is dropped, so the table never holds a partial group.
+ * 
+ * The table is not thread-safe. The arrays are updated in place by add(), so read them
+ * from the same thread or task that adds the sentences, eg. the one that calls update().
+ * Unlike NMEA_Epoch, the table is not published through a sequence counter, which would
+ * need a second copy of the arrays. To share it with another core, copy the arrays after
+ * add() in that thread and pass the copy on.
+ * 
+ */
+class NMEA_Satellite_Table {
+  public:
+    enum System : uint8_t {
+      SYSTEM_GPS, // GP
+      SYSTEM_GLONASS, // GL
+      SYSTEM_GALILEO, // GA
+      SYSTEM_BEIDOU, // GB or BD
+      SYSTEM_QZSS, // GQ or QZ
+      SYSTEM_COUNT
+    };
+
+  private:
+    // The committed table
+    uint16_t prns [CONST_MAX_SATELLITES]; // Satellite ID numbers
+    int8_t elevations [CONST_MAX_SATELLITES]; // Degrees. -128 if not available.
+    uint16_t azimuths [CONST_MAX_SATELLITES]; // Degrees from the true north. 0xFFFF if not available.
+    uint8_t snrs [CONST_MAX_SATELLITES]; // dB-Hz. 0 if not tracked.
+    uint8_t systems [CONST_MAX_SATELLITES]; // One of the System values
+    uint8_t signals [CONST_MAX_SATELLITES]; // NMEA 4.10 signal ID. 0 if not sent.
+    uint8_t count; // Number of satellites in the table
+    NMEA_Snr_Stats stats [SYSTEM_COUNT]; // Updated when a group is committed
+    uint32_t commitCount; // Number of groups committed
+
+    // The group being collected
+    uint16_t groupPrns [CONST_MAX_SATELLITES];
+    int8_t groupElevations [CONST_MAX_SATELLITES];
+    uint16_t groupAzimuths [CONST_MAX_SATELLITES];
+    uint8_t groupSnrs [CONST_MAX_SATELLITES];
+    uint8_t groupCount; // Number of satellites collected
+    uint8_t groupSystem; // System of the group
+    uint8_t groupSignal; // Signal ID of the group
+    uint8_t groupParts; // Number of sentences in the group
+    uint8_t groupNext; // The next expected sentence number. 0 if no group is being collected.
+
+    void commit(); // Replace the satellites of the collected group in the table
+
+  public:
+    NMEA_Satellite_Table();
+    bool add (const NMEA_0183_Data& data); // Add a parsed GSV sentence
+    void clear(); // Remove all the satellites
+    uint8_t getCount() const { return count; } // Get the number of satellites in the table
+    const uint16_t* getPrns() const { return prns; } // Get the satellite ID array
+    const int8_t* getElevations() const { return elevations; } // Get the elevation array
+    const uint16_t* getAzimuths() const { return azimuths; } // Get the azimuth array
+    const uint8_t* getSnrs() const { return snrs; } // Get the SNR array
+    const uint8_t* getSystems() const { return systems; } // Get the System array
+    const uint8_t* getSignals() const { return signals; } // Get the signal ID array
+    const NMEA_Snr_Stats& getSnrStats (uint8_t system) const; // Get the SNR statistics of a System
+    uint32_t getCommitCount() const { return commitCount; } // Get the number of groups committed
+    static int8_t getSystem (const char* talker); // Get the System of a talker ID. -1 if not a GNSS.
+};
+
+//======================================================================================//
+/**
+ * @brief A UBX frame, as received by the UBX_Framer. The payload is not copied and is only
+ * valid until the next frame starts. The multi-byte fields are little-endian and may be
+ * unaligned, so they are read with the get functions.
+ * 
+ */
+struct UBX_Frame {
+  static const uint8_t Sync1 = 0xB5; // The first sync character
+  static const uint8_t Sync2 = 0x62; // The second sync character
+  static const uint8_t HeaderLength = 6; // The sync characters, the class, the ID and the length
+  static const uint8_t ChecksumLength = 2; // CK_A and CK_B after the payload
+
+  uint8_t messageClass; // The message class, eg. 0x01 for NAV
+  uint8_t id; // The message ID within the class
+  uint16_t length; // The number of payload bytes
+  const uint8_t* payload; // The payload
+
+  uint8_t getU1 (uint16_t offset) const { return payload [offset]; }
+  int8_t getI1 (uint16_t offset) const { return (int8_t) payload [offset]; }
+  uint16_t getU2 (uint16_t offset) const { return (uint16_t) (payload [offset] | (payload [offset + 1] << 8)); }
+  int16_t getI2 (uint16_t offset) const { return (int16_t) getU2 (offset); }
+  uint32_t getU4 (uint16_t offset) const { return (uint32_t) getU2 (offset) | ((uint32_t) getU2 (offset + 2) << 16); }
+  int32_t getI4 (uint16_t offset) const { return (int32_t) getU4 (offset); }
+};
+
+//======================================================================================//
+/**
+ * @brief The function type that receives the complete UBX frames from the UBX_Framer. The
+ * frame is only valid during the call.
+ * 
+ */
+typedef void (*UBX_Frame_Handler) (const UBX_Frame& frame, void* context);
+
+//======================================================================================//
+/**
+ * @brief A resumable UBX frame decoder. Like the NMEA_Framer, the bytes can be fed one at
+ * a time or in chunks of any size. A frame is:
+ * 
+ *   0xB5, 0x62, Class, ID, Length (2 bytes), Payload, CK_A, CK_B
+ * 
+ * The 8-bit Fletcher checksum covers the class, the ID, the length and the payload. Frames
+ * with a wrong checksum, and frames longer than CONST_MAX_UBX_PAYLOAD_LENGTH, are dropped
+ * and counted. The bytes after the first sync character of a dropped frame are looked at
+ * again, whether the frame was split between the chunks or not, so that false sync
+ * characters in the noise do not hide the frames after them. The ACK and NAK frames are
+ * also remembered, so that a command can wait for its ACK.
+ * 
+ */
+class UBX_Framer {
+  private:
+    enum State : uint8_t {
+      STATE_SYNC_1, // Waiting for 0xB5
+      STATE_SYNC_2, // Waiting for 0x62
+      STATE_CLASS, // Waiting for the class
+      STATE_ID, // Waiting for the ID
+      STATE_LENGTH_1, // Waiting for the low byte of the length
+      STATE_LENGTH_2, // Waiting for the high byte of the length
+      STATE_PAYLOAD, // Collecting the payload
+      STATE_CHECKSUM_A, // Waiting for CK_A
+      STATE_CHECKSUM_B // Waiting for CK_B
+    };
+
+    State state; // The current framing state
+    uint8_t frameBuffer [UBX_Frame::HeaderLength + CONST_MAX_UBX_PAYLOAD_LENGTH + UBX_Frame::ChecksumLength]; // The frame being read, from the sync characters to the checksum
+    uint16_t payloadCount; // The number of payload bytes read
+    UBX_Frame frame; // The frame being read, or the last complete frame
+    uint8_t checksumA; // Running Fletcher checksum
+    uint8_t checksumB;
+    UBX_Frame_Handler handler; // Called for each frame. nullptr if not set.
+    void* handlerContext; // User pointer passed to the handler
+    uint32_t frameCount; // Number of valid frames
+    uint32_t checksumErrorCount; // Number of frames dropped due to a checksum mismatch
+    uint32_t oversizeCount; // Number of frames dropped because they do not fit
+    uint32_t ackCount; // Number of ACK and NAK frames
+    uint8_t ackClass; // The class of the message in the last ACK or NAK
+    uint8_t ackId; // The ID of the message in the last ACK or NAK
+    bool ackAccepted; // True if the last one was an ACK, false if a NAK
+    uint16_t rescanLength; // The bytes after the first sync character of the split frame that was dropped, to be looked at again
+
+    void addChecksum (uint8_t c) { checksumA += c; checksumB += checksumA; }
+    void complete(); // Count the frame in the frame buffer, remember the ACK or NAK and pass the frame to the handler
+    bool step (uint8_t c); // Feed a single byte, leaving the bytes of a dropped split frame to the caller
+    uint16_t rescan(); // Feed the bytes of a dropped split frame again
+
+  public:
+    UBX_Framer();
+    static void computeChecksum (const uint8_t* data, size_t length, uint8_t& checksumA, uint8_t& checksumB); // 8-bit Fletcher
+    void setHandler (UBX_Frame_Handler handler, void* context = nullptr); // Set the frame handler
+    bool feed (uint8_t c); // Feed a single byte. Returns true if a frame was completed.
+    uint16_t feed (const uint8_t* data, size_t length); // Feed a chunk of bytes. Returns the number of frames completed.
+    size_t feedFrame (const uint8_t* data, size_t length); // Feed the bytes until the frame ends. Returns the number of bytes used.
+    uint16_t takeRescan (const uint8_t*& data); // Take the bytes that feedFrame() left to be looked at again. Returns the number of bytes.
+    void reset(); // Discard any partial frame
+    bool isIdle() const { return state == STATE_SYNC_1; } // Check if the framer is between the frames
+    const UBX_Frame& getFrame() const { return frame; } // Get the last complete frame
+    uint32_t getFrameCount() const { return frameCount; } // Get the number of valid frames
+    uint32_t getChecksumErrorCount() const { return checksumErrorCount; } // Get the number of frames with a wrong checksum
+    uint32_t getOversizeCount() const { return oversizeCount; } // Get the number of frames that did not fit
+    uint32_t getAckCount() const { return ackCount; } // Get the number of ACK and NAK frames
+    bool getLastAck (uint8_t& messageClass, uint8_t& id) const; // Get the message of the last ACK or NAK. Returns true for an ACK.
+};
+
+//======================================================================================//
+/**
+ * @brief A view of a UBX-NAV-PVT frame (0x01 0x07), the complete navigation solution in 92
+ * bytes. The values are read from the frame payload as they are requested, and are in the
+ * units of the u-blox interface description. decode() converts them to an NMEA_Fix.
+ * 
+ */
+class UBX_Nav_Pvt {
+  public:
+    static const uint8_t Class = 0x01;
+    static const uint8_t Id = 0x07;
+    static const uint16_t Length = 92;
+
+    const UBX_Frame& frame; // The frame. Only valid as long as the frame is.
+
+    explicit UBX_Nav_Pvt (const UBX_Frame& frame) : frame (frame) {}
+    bool isValid() const { return (frame.messageClass == Class) && (frame.id == Id) && (frame.length >= Length); }
+
+    uint32_t getITow() const { return frame.getU4 (0); } // GPS time of week in milliseconds
+    uint16_t getYear() const { return frame.getU2 (4); } // UTC
+    uint8_t getMonth() const { return frame.getU1 (6); }
+    uint8_t getDay() const { return frame.getU1 (7); }
+    uint8_t getHour() const { return frame.getU1 (8); }
+    uint8_t getMinute() const { return frame.getU1 (9); }
+    uint8_t getSecond() const { return frame.getU1 (10); }
+    uint8_t getValid() const { return frame.getU1 (11); } // Bit 0 = valid date, bit 1 = valid time
+    int32_t getNano() const { return frame.getI4 (16); } // Fraction of the second in nanoseconds, -1e9 to 1e9
+    uint8_t getFixType() const { return frame.getU1 (20); } // 0 = No fix, 2 = 2D, 3 = 3D, 4 = GNSS + DR, 5 = Time only
+    uint8_t getFlags() const { return frame.getU1 (21); } // Bit 0 = fix OK, bit 1 = differential, bits 6-7 = RTK
+    uint8_t getSatellites() const { return frame.getU1 (23); } // Number of satellites used
+    int32_t getLongitude() const { return frame.getI4 (24); } // Degrees x 10^7
+    int32_t getLatitude() const { return frame.getI4 (28); } // Degrees x 10^7
+    int32_t getHeight() const { return frame.getI4 (32); } // Millimetres above the ellipsoid
+    int32_t getAltitude() const { return frame.getI4 (36); } // Millimetres above the mean sea level
+    uint32_t getHorizontalAccuracy() const { return frame.getU4 (40); } // Millimetres
+    uint32_t getVerticalAccuracy() const { return frame.getU4 (44); } // Millimetres
+    int32_t getVelocityNorth() const { return frame.getI4 (48); } // Millimetres per second
+    int32_t getVelocityEast() const { return frame.getI4 (52); } // Millimetres per second
+    int32_t getVelocityDown() const { return frame.getI4 (56); } // Millimetres per second
+    int32_t getGroundSpeed() const { return frame.getI4 (60); } // Millimetres per second
+    int32_t getHeading() const { return frame.getI4 (64); } // Heading of motion in degrees x 10^5
+    uint16_t getPdop() const { return frame.getU2 (76); } // PDOP x 100
+
+    bool decode (NMEA_Fix& fix) const; // Decode the frame to a fix
+};
+
+//======================================================================================//
+/**
+ * @brief A view of a UBX-NAV-SAT frame (0x01 0x35), which has a block of 12 bytes for each
+ * satellite in view. The blocks are read in place.
+ * 
+ */
+class UBX_Nav_Sat {
+  public:
+    static const uint8_t Class = 0x01;
+    static const uint8_t Id = 0x35;
+    static const uint16_t HeaderLength = 8; // The bytes before the first satellite block
+    static const uint16_t BlockLength = 12; // The bytes of each satellite block
+
+    const UBX_Frame& frame; // The frame. Only valid as long as the frame is.
+
+    explicit UBX_Nav_Sat (const UBX_Frame& frame) : frame (frame) {}
+    bool isValid() const; // Check the class, the ID and that all the blocks are there
+
+    uint32_t getITow() const { return frame.getU4 (0); } // GPS time of week in milliseconds
+    uint8_t getCount() const { return frame.getU1 (5); } // Number of satellites
+    uint8_t getGnssId (uint8_t i) const { return frame.getU1 (HeaderLength + (i * BlockLength)); } // 0 = GPS, 1 = SBAS, 2 = Galileo, 3 = BeiDou, 5 = QZSS, 6 = GLONASS
+    uint8_t getSvId (uint8_t i) const { return frame.getU1 (HeaderLength + (i * BlockLength) + 1); } // Satellite ID within the GNSS
+    uint8_t getCno (uint8_t i) const { return frame.getU1 (HeaderLength + (i * BlockLength) + 2); } // Carrier to noise ratio in dB-Hz
+    int8_t getElevation (uint8_t i) const { return frame.getI1 (HeaderLength + (i * BlockLength) + 3); } // Degrees
+    int16_t getAzimuth (uint8_t i) const { return frame.getI2 (HeaderLength + (i * BlockLength) + 4); } // Degrees
+    uint32_t getFlags (uint8_t i) const { return frame.getU4 (HeaderLength + (i * BlockLength) + 8); } // Bit 3 = used in the solution
+};
+
+//======================================================================================//
+/**
+ * @brief A view of a UBX-ACK-ACK (0x05 0x01) or UBX-ACK-NAK (0x05 0x00) frame, the reply
+ * to a configuration message.
+ * 
+ */
+class UBX_Ack {
+  public:
+    static const uint8_t Class = 0x05;
+    static const uint8_t IdNak = 0x00;
+    static const uint8_t IdAck = 0x01;
+
+    const UBX_Frame& frame; // The frame. Only valid as long as the frame is.
+
+    explicit UBX_Ack (const UBX_Frame& frame) : frame (frame) {}
+    bool isValid() const { return (frame.messageClass == Class) && (frame.id <= IdAck) && (frame.length >= 2); }
+    bool isAccepted() const { return frame.id == IdAck; } // True for an ACK, false for a NAK
+    uint8_t getMessageClass() const { return frame.getU1 (0); } // The class of the acknowledged message
+    uint8_t getMessageId() const { return frame.getU1 (1); } // The ID of the acknowledged message
+};
+
+//======================================================================================//
+/**
+ * @brief The function type that receives the complete RTCM 3 frames from the RTCM_Framer.
+ * The frame includes the preamble, the length and the CRC, so that it can be forwarded as
+ * it is, eg. to the correction input of an RTK receiver. It points into the fed bytes when
+ * the whole frame was fed in one chunk, and is only valid during the call.
+ * 
+ */
+typedef void (*RTCM_Frame_Handler) (const uint8_t* frame, uint16_t length, void* context);
+
+//======================================================================================//
+/**
+ * @brief A resumable RTCM 3 frame decoder, for passing the correction messages through. A
+ * frame is:
+ * 
+ *   0xD3, 6 reserved bits + 10-bit length, Payload, CRC-24Q (3 bytes)
+ * 
+ * The CRC covers the preamble, the length and the payload. The payload is not decoded. A
+ * frame that is fed in one chunk is checked and passed to the handler in place, without
+ * being copied. Only the frames that are split between the chunks are collected in the
+ * frame buffer. Frames with a wrong CRC, and split frames longer than
+ * CONST_MAX_RTCM_FRAME_LENGTH, are dropped and counted. The bytes after the preamble of a
+ * frame with a wrong CRC are looked at again, whether the frame was split or not, so the
+ * frames found do not depend on how the stream is chunked.
+ * 
+ */
+class RTCM_Framer {
+  private:
+    enum State : uint8_t {
+      STATE_PREAMBLE, // Waiting for 0xD3
+      STATE_LENGTH_1, // Waiting for the reserved bits and the high bits of the length
+      STATE_LENGTH_2, // Waiting for the low byte of the length
+      STATE_BODY // Collecting the payload and the CRC
+    };
+
+    State state; // The current framing state
+    uint8_t frameBuffer [CONST_MAX_RTCM_FRAME_LENGTH]; // The frame being collected
+    uint16_t frameLength; // The length of the whole frame being collected
+    uint16_t bufferCount; // The number of bytes in the frameBuffer
+    RTCM_Frame_Handler handler; // Called for each frame. nullptr if not set.
+    void* handlerContext; // User pointer passed to the handler
+    uint32_t frameCount; // Number of valid frames
+    uint32_t crcErrorCount; // Number of frames dropped due to a CRC mismatch
+    uint32_t oversizeCount; // Number of frames dropped because they do not fit
+    uint16_t lastMessageType; // The message type of the last valid frame
+    uint16_t rescanLength; // The bytes after the preamble of the split frame that failed its CRC, to be looked at again
+
+    bool complete (const uint8_t* frame, uint16_t length); // Check the CRC and pass the frame to the handler
+    bool step (uint8_t c); // Feed a single byte, leaving the bytes of a failed split frame to the caller
+    uint16_t rescan(); // Feed the bytes of a failed split frame again
+
+  public:
+    static const uint8_t Preamble = 0xD3; // The first byte of a frame
+    static const uint8_t HeaderLength = 3; // The preamble and the length
+    static const uint8_t CrcLength = 3; // The CRC-24Q after the payload
+
+    RTCM_Framer();
+    static uint32_t computeCrc (const uint8_t* data, size_t length, uint32_t crc = 0); // CRC-24Q
+    static uint16_t getMessageType (const uint8_t* frame, uint16_t length); // Get the message type of a frame. 0 if it has no payload.
+    void setHandler (RTCM_Frame_Handler handler, void* context = nullptr); // Set the frame handler
+    bool feed (uint8_t c); // Feed a single byte. Returns true if a frame was completed.
+    uint16_t feed (const uint8_t* data, size_t length); // Feed a chunk of bytes. Returns the number of frames completed.
+    size_t feedFrame (const uint8_t* data, size_t length); // Feed the bytes until the frame ends. Returns the number of bytes used.
+    uint16_t takeRescan (const uint8_t*& data); // Take the bytes that feedFrame() left to be looked at again. Returns the number of bytes.
+    void reset(); // Discard any partial frame
+    bool isIdle() const { return state == STATE_PREAMBLE; } // Check if the framer is between the frames
+    uint32_t getFrameCount() const { return frameCount; } // Get the number of valid frames
+    uint32_t getCrcErrorCount() const { return crcErrorCount; } // Get the number of frames with a wrong CRC
+    uint32_t getOversizeCount() const { return oversizeCount; } // Get the number of split frames that did not fit
+    uint16_t getLastMessageType() const { return lastMessageType; } // Get the message type of the last valid frame, eg. 1005
+};
+
+//======================================================================================//
+/**
+ * @brief Splits a byte stream that mixes NMEA, UBX and RTCM 3 frames, as on the port of an
+ * RTK receiver, in a single pass. Between the frames, the bytes are scanned once for the
+ * first byte of a frame of the attached framers ('$', 0xB5 or 0xD3). The frame is then
+ * fed to its framer only, which checks it with its own checksum or CRC and calls its
+ * handler. When a frame breaks before its checksum, the byte that broke it is looked at
+ * again, so a frame that cuts into another one is not lost. The bytes after the first byte
+ * of a dropped UBX or RTCM frame are split again, even when the frame came in several
+ * chunks, so the frames found do not depend on how the stream is chunked.
+ * 
+ */
+class GNSS_Demux {
+  public:
+    // The protocols of the frames
+    enum Protocol : uint8_t {
+      PROTOCOL_NONE, // The bytes between the frames, such as line endings and noise
+      PROTOCOL_NMEA,
+      PROTOCOL_UBX,
+      PROTOCOL_RTCM,
+      PROTOCOL_COUNT
+    };
+
+  private:
+    NMEA_Framer* nmeaFramer; // nullptr if not set
+    UBX_Framer* ubxFramer; // nullptr if not set
+    RTCM_Framer* rtcmFramer; // nullptr if not set
+    Protocol protocol; // The protocol of the frame being read. PROTOCOL_NONE between the frames.
+    uint32_t byteCounts [PROTOCOL_COUNT]; // The number of bytes of each protocol
+
+    Protocol getStartProtocol (uint8_t c) const; // Get the protocol of an attached framer whose frames start with the byte
+    size_t findStart (const uint8_t* data, size_t length) const; // Find the first byte that starts a frame
+    size_t feedFrame (const uint8_t* data, size_t length, uint16_t& completedCount); // Feed the bytes to the framer of the current frame
+    uint16_t split (const uint8_t* data, size_t length); // Split the bytes between the framers
+
+  public:
+    GNSS_Demux();
+    void setNmeaFramer (NMEA_Framer* framer); // Set the NMEA framer. nullptr to remove.
+    void setUbxFramer (UBX_Framer* framer); // Set the UBX framer. nullptr to remove.
+    void setRtcmFramer (RTCM_Framer* framer); // Set the RTCM framer. nullptr to remove.
+    NMEA_Framer* getNmeaFramer() const { return nmeaFramer; }
+    UBX_Framer* getUbxFramer() const { return ubxFramer; }
+    RTCM_Framer* getRtcmFramer() const { return rtcmFramer; }
+    bool feed (uint8_t c); // Feed a single byte. Returns true if a frame was completed.
+    uint16_t feed (const uint8_t* data, size_t length); // Feed a chunk of bytes. Returns the number of frames completed.
+    void reset(); // Discard the partial frames of all the framers
+    uint32_t getByteCount (Protocol protocol) const; // Get the number of bytes of a protocol
+    void resetByteCounts(); // Set the byte counts to 0
+};
+
+//======================================================================================//
+/**
+ * @brief A histogram of latencies in powers of 2 of the CSE_GNSS_STATS_CLOCK() ticks, which
+ * are microseconds by default. Bucket 0 counts the times of 0, bucket i counts the times
+ * from 2^(i - 1) to 2^i - 1, and the last bucket also counts all the longer ones.
+ * 
+ */
+struct GNSS_Latency_Histogram {
+  static const uint8_t BucketCount = 16;
+
+  uint32_t buckets [BucketCount]; // The number of times in each bucket
+  uint32_t count; // The number of times added
+  uint32_t maxTime; // The longest time added
+
+  void add (uint32_t time); // Add a time
+  void clear(); // Remove all the times
+  uint32_t getPercentile (uint8_t percent) const; // Get the upper bound of the bucket that holds the percentile
+};
+
+//======================================================================================//
+/**
+ * @brief A snapshot of the runtime statistics of the ingestion pipeline of CSE_GNSS, to
+ * tell the causes of the missing fixes apart in the field. The counts are since begin() or
+ * since the last CSE_GNSS::resetStats().
+ * 
+ * The byte, sentence and error counts come from the demultiplexer and the framer, which
+ * always keep them. The type counts, the high-water marks, the times and the histograms
+ * are only kept if CSE_GNSS_STATS_ENABLED is 1, and are 0 otherwise.
+ * 
+ */
+struct GNSS_Stats {
+  // The indexes of the typeCounts
+  enum Type : uint8_t {
+    TYPE_GGA,
+    TYPE_GLL,
+    TYPE_GSA,
+    TYPE_GSV,
+    TYPE_RMC,
+    TYPE_VTG,
+    TYPE_ZDA,
+    TYPE_OTHER, // The other standard types and the proprietary sentences
+    TYPE_COUNT
+  };
+
+  uint32_t bytesIn; // Bytes given to feed(), update() and extractNMEA()
+  uint32_t bytesUnframed; // Bytes between the sentences and frames, such as the line endings and noise
+  uint32_t bytesDropped; // Bytes of the sentences that the framer dropped
+  uint32_t sentenceCount; // Valid sentences
+  uint32_t typeCounts [TYPE_COUNT]; // Valid sentences of each type
+  uint32_t checksumErrorCount; // Sentences dropped due to a checksum mismatch
+  uint32_t oversizeCount; // Sentences dropped for being longer than CONST_MAX_NMEA_SENTENCE_LENGTH
+  uint32_t truncatedCount; // Sentences cut short by binary data, a line ending or a '$' before their checksum
+  uint32_t filteredCount; // Sentences rejected by the filter
+  uint32_t shortReadCount; // read() calls that returned fewer bytes than asked for
+  uint16_t sentenceHighWater; // The longest valid sentence, out of CONST_MAX_NMEA_SENTENCE_LENGTH
+  uint16_t readHighWater; // The most bytes returned by a read(), out of CONST_SERIAL_BUFFER_LENGTH
+  uint16_t nmeaBufferHighWater; // The most bytes in the nmeaDataBuffer after an extractNMEA()
+  uint16_t availableHighWater; // The most bytes waiting in the GNSS port at an update(), out of its receive buffer
+  uint32_t lastByteTime; // millis() when the last bytes were received. 0 if none yet.
+  uint32_t lastSentenceTime; // millis() of the last valid sentence. 0 if none yet.
+
+  #if CSE_GNSS_STATS_LATENCY
+    GNSS_Latency_Histogram framing; // The time of each feed() chunk, update() and extractNMEA(), with the parsing
+    GNSS_Latency_Histogram parsing; // The time to dispatch and parse each sentence, with the handlers
+  #endif
+
+  static Type getType (const char* sentence, uint16_t length); // Get the type of a sentence
+};
+
+//======================================================================================//
+/**
+ * @brief Builds an NMEA command sentence, such as a PMTK, PUBX or PCAS configuration
+ * request, and appends the checksum. For example, `NMEA_Command ("PMTK220").add (1000)`
+ * followed by finish() gives "$PMTK220,1000*1F\r\n". The sentence is kept in the object.
+ * 
+ */
+class NMEA_Command {
+  public:
+    // The receiver families that CSE_GNSS can configure
+    enum Receiver : uint8_t {
+      RECEIVER_MTK, // MediaTek and compatible (PMTK)
+      RECEIVER_UBLOX, // u-blox (PUBX and UBX)
+      RECEIVER_CASIC // CASIC/AT6558 and compatible (PCAS)
+    };
+
+    // The standard sentences that can be turned on or off with setSentenceMask()
+    enum Sentence : uint8_t {
+      SENTENCE_GGA = 0x01,
+      SENTENCE_GLL = 0x02,
+      SENTENCE_GSA = 0x04,
+      SENTENCE_GSV = 0x08,
+      SENTENCE_RMC = 0x10,
+      SENTENCE_VTG = 0x20,
+      SENTENCE_ZDA = 0x40
+    };
+
+  private:
+    char buffer [CONST_MAX_NMEA_SENTENCE_LENGTH + 3]; // The sentence, the line ending and the null
+    uint16_t length; // The number of characters in the buffer
+    bool overflow; // True if a field did not fit
+    bool finished; // True after the checksum is added
+
+    void append (const char* data, size_t count); // Append the characters if they fit
+
+  public:
+    NMEA_Command (const char* id = ""); // Start a command with the ID, eg. "PMTK314"
+    void start (const char* id); // Discard the command and start a new one
+    NMEA_Command& add (const char* field); // Add a text field
+    NMEA_Command& add (long value); // Add a decimal field
+    NMEA_Command& add (unsigned long value); // Add a decimal field
+    NMEA_Command& add (int value) { return add ((long) value); } // Add a decimal field
+    NMEA_Command& add (unsigned int value) { return add ((unsigned long) value); } // Add a decimal field
+    bool finish(); // Add the checksum and the line ending. Returns false if the command is too long.
+    const char* getSentence() const { return buffer; } // Get the sentence (null terminated)
+    uint16_t getLength() const { return length; } // Get the length of the sentence
 };
 
 //======================================================================================//
@@ -74,22 +1623,85 @@ class CSE_GNSS {
 
     HardwareSerial* Debug_Serial; // The serial port of the debug monitor.
 
-    #if SOFTWARE_SERIAL_REQUIRED
-      SoftwareSerial* GNSS_Serial; // The serial port of the GNSS module.
-    #else
-      HardwareSerial* GNSS_Serial; // The serial port of the GNSS module.
-    #endif
+    Stream* GNSS_Serial; // The serial port or other byte source of the GNSS module.
+    NMEA_Port_Begin gnssBegin; // Starts the GNSS port. nullptr if the source has no begin().
 
     uint64_t gnssBaud; // The baudrate of the GNSS module.
     uint64_t debugBaud; // The baudrate of the debug port.
     bool inited;  // True if the GNSS module serial port is initialized.
-    std::vector <NMEA_0183_Data*> dataList;  // List of NMEA data objects.
+    NMEA_0183_Data* dataList [CONST_MAX_NMEA_DATA_COUNT];  // List of NMEA data objects.
     int dataCount; // The number of NMEA data objects in the dataList.
+    NMEA_Framer framer; // The framer that splits the incoming bytes into NMEA sentences.
+    bool extracting; // True while extractNMEA() is feeding the framer.
+    uint8_t logLevel; // The messages above this level are not printed.
+
+    NMEA_Data_Handler handler; // The catch-all handler. nullptr if not set.
+    void* handlerContext; // User pointer passed to the catch-all handler
+    NMEA_Epoch* epoch; // Receives every parsed sentence. nullptr if not set.
+    NMEA_Satellite_Table* satelliteTable; // Receives the GSV sentences. nullptr if not set.
+    NMEA_Time_Sync* timeSync; // Receives the UTC and arrival times of the sentences. nullptr if not set.
+    NMEA_0183_Data genericData; // Parses the sentences that have no data object, for the handler, epoch and satellite table
+    const char* waitPrefix; // The sentence start that waitForSentence() is waiting for. nullptr if not waiting.
+    bool waitMatched; // True when a sentence with the waitPrefix has been received
+    uint32_t startTime; // millis() at begin() or detectBaud()
+    uint32_t firstSentenceTime; // The time from startTime to the first valid sentence, in milliseconds
+    bool firstSentenceSeen; // True when a valid sentence has been received after startTime
+    uint8_t filterMode; // One of the Filter_Mode values
+    const char* const* filterTypes; // The allow or deny list. Not copied.
+    uint8_t filterTypeCount; // The number of entries in the filterTypes
+    GNSS_Demux demux; // Splits the incoming bytes between the NMEA framer and the UBX and RTCM framers
+
+    #if CSE_GNSS_STATS_ENABLED
+      GNSS_Stats stats; // The statistics that the framer and the demux do not keep
+    #endif
+
+    NMEA_0183_Data* dispatchTable [CONST_DISPATCH_TABLE_SIZE]; // Data objects indexed by the hash of their sentence key
+    uint32_t dispatchKeys [CONST_DISPATCH_TABLE_SIZE]; // The sentence key of each slot in the dispatchTable
+
+    // The constructor that the public constructors delegate to.
+    CSE_GNSS (Stream* gnssSerial, NMEA_Port_Begin gnssBegin, HardwareSerial* debugSerial, uint64_t gnssBaud, uint64_t debugBaud);
+
+    // Call the begin() of the actual port type.
+    template <typename Serial_Type>
+    static void beginPort (Stream* port, unsigned long baud) {
+      static_cast <Serial_Type*> (port)->begin (baud);
+    }
 
+    static void onSentence (const char* sentence, uint16_t length, void* context); // Framer handler
+    void dispatchSentence (const char* sentence, uint16_t length); // Send a sentence to the matching data object
+    void syncTime (const char* sentence, uint16_t length); // Add the UTC time and the arrival time of a sentence to the timeSync
+    static uint8_t getDispatchSlot (uint32_t key); // Get the first table slot for a sentence key
+    NMEA_0183_Data* findData (const char* id, uint8_t length); // Find a data object by its sentence ID
+    bool sendAndWait (NMEA_Command& command, const char* ack, uint32_t timeout); // Send a command and wait for its ACK
+    static bool onFilter (const char* header, void* context); // Framer filter
+    bool isRegistered (const char* id, uint8_t length) const; // Check if a sentence ID has a consumer
+
+    // Print the log arguments one by one. The NMEA_Field overload writes the field characters.
+    void logPrint() {}
+    void logValue (const NMEA_Field& field) { Debug_Serial->write (field.data, field.length); }
+
+    template <typename T>
+    void logValue (const T& value) {
+      Debug_Serial->print (value);
+    }
+
+    template <typename T, typename... Args>
+    void logPrint (const T& value, const Args&... args) {
+      logValue (value);
+      logPrint (args...);
+    }
 
   public:
     typedef NMEA_0183_Data& NMEA_0183_Data_Ref;
 
+    // The ways to filter the sentences as they are framed
+    enum Filter_Mode : uint8_t {
+      FILTER_NONE, // Keep all the sentences
+      FILTER_REGISTERED, // Keep the sentences that have a data object, or that the epoch, the satellite table, the time sync or the catch-all handler uses
+      FILTER_ALLOW, // Keep only the sentences in the list
+      FILTER_DENY // Keep all the sentences except the ones in the list
+    };
+
     NMEA_0183_Data* dummyData; // A dummy NMEA data object to return if the requested data is not found.
 
     char gnssDataBuffer [CONST_SERIAL_BUFFER_LENGTH] = {0}; // A buffer to store the GNSS serial data.
@@ -98,23 +1710,93 @@ class CSE_GNSS {
     uint16_t gnssDataBufferLength = 0;  // Indicates how many valid bytes are in the GNSS serial buffer.
     uint16_t nmeaDataBufferLength = 0; // Indicates how many valid lines are in the NMEA data buffer.
 
-    // Constructor using two hardware serial ports.
-    CSE_GNSS (HardwareSerial* gnssSerial, HardwareSerial* debugSerial, uint64_t gnssBaud = 0, uint64_t debugBaud = 0);
+    // Constructor using any serial port type with a begin (baud) function for the GNSS,
+    // such as HardwareSerial or SoftwareSerial. Other streams use the Stream constructor.
+    template <typename Serial_Type, typename = decltype (static_cast <Serial_Type*> (nullptr)->begin (0UL))>
+    CSE_GNSS (Serial_Type* gnssSerial, HardwareSerial* debugSerial, uint64_t gnssBaud = 0, uint64_t debugBaud = 0) :
+      CSE_GNSS (gnssSerial, &beginPort <Serial_Type>, debugSerial, gnssBaud, debugBaud) {}
 
-    // Constructor using one hardware serial port and one software serial port.
-    #if SOFTWARE_SERIAL_REQUIRED
-      CSE_GNSS (SoftwareSerial* gnssSerial, HardwareSerial* debugSerial, uint64_t gnssBaud = 0, uint64_t debugBaud = 0);
-    #endif
+    // Constructor using a plain Stream for the GNSS, such as an NMEA_Memory_Source. The
+    // stream is not started by begin().
+    CSE_GNSS (Stream* gnssSerial, HardwareSerial* debugSerial, uint64_t gnssBaud = 0, uint64_t debugBaud = 0);
 
-    bool begin(); // Initialize the serial ports if necessary.
+    bool begin (uint32_t layout = CSE_GNSS_LAYOUT); // Initialize the serial ports if necessary. Leave the layout as the default.
     uint16_t read (int byteCount);  // Read a specified number of bytes from the GNSS serial port.
     uint16_t extractNMEA(); // Extract NMEA data from the GNSS serial buffer. This will remove any redundant or unsupported data.
     String getNmeaDataString(); // Converts the NMEA data lines buffer to a Arduino String.
+    uint16_t feed (char c); // Feed a single byte to the framer.
+    uint16_t feed (const char* data, size_t length); // Feed a chunk of bytes to the framer.
+    uint16_t update(); // Feed all the bytes available in the GNSS serial port without blocking.
+
+    // Feed all the bytes of a zero-copy source to the framer, such as an NMEA_Ring_Buffer,
+    // an NMEA_Memory_Source or an NMEA_Mapped_File. Any type with peek (const char*&) and
+    // consume (size_t) can be used. The bytes are framed in place and then consumed, so
+    // a ring buffer releases them to the producer. Returns the number of sentences completed.
+    template <typename Source>
+    auto feed (Source& source) -> decltype (source.consume (0), uint32_t()) {
+      uint32_t sentenceCount = 0;
+      const char* data;
+      size_t length;
+
+      while ((length = source.peek (data)) > 0) {
+        sentenceCount += feed (data, length);
+        source.consume (length);
+      }
+
+      return sentenceCount;
+    }
 
+    static uint32_t getSentenceKey (const char* id, uint8_t length); // Pack a sentence ID into a 32-bit key
     int addData (NMEA_0183_Data* data); // Add an NMEA data object to the dataList.
     int getDataCount(); // Get the number of NMEA data objects in the dataList.
     NMEA_0183_Data_Ref getDataRef (String name);  // Get the reference of the NMEA data object.
     NMEA_0183_Data_Ref getDataRef (int index);  // Get the reference of the NMEA data object.
+    void setHandler (NMEA_Data_Handler handler, void* context = nullptr); // Set the handler for all the sentences.
+    void setEpoch (NMEA_Epoch* epoch); // Set the epoch assembler for all the sentences.
+    void setSatelliteTable (NMEA_Satellite_Table* table); // Set the table that reassembles the GSV sentences.
+    void setTimeSync (NMEA_Time_Sync* sync); // Set the object that relates the UTC time of the sentences to their arrival.
+    void setClock (NMEA_Clock clock); // Set the clock that stamps the arrival of the sentences. nullptr to not stamp.
+    uint32_t getSentenceTime() const { return framer.getSentenceTime(); } // Get the clock time when the last sentence arrived.
+
+    // Receiver configuration
+    bool send (NMEA_Command& command); // Send a command to the GNSS module.
+    bool sendCommand (const char* body); // Send a command given without the '$' and the checksum, eg. "PMTK220,1000".
+    bool waitForSentence (const char* prefix, uint32_t timeout); // Wait for a sentence that starts with the prefix.
+    bool setSentenceMask (NMEA_Command::Receiver receiver, uint8_t mask, uint32_t timeout = 1000); // Turn the standard sentences on or off.
+    bool setOutputRate (NMEA_Command::Receiver receiver, uint16_t interval, uint32_t timeout = 1000); // Set the fix interval in milliseconds.
+    bool setReceiverBaud (NMEA_Command::Receiver receiver, uint32_t baud, uint32_t timeout = 2000); // Change the baudrate of the module and the port.
+    uint32_t detectBaud (uint32_t window = CONST_AUTO_BAUD_WINDOW); // Find the baudrate of the module and start the port at it.
+    uint32_t getBaud() const; // Get the baudrate of the GNSS port.
+    int32_t getFirstSentenceTime() const; // Get the time to the first valid sentence in milliseconds. -1 if none yet.
+
+    void setFilter (Filter_Mode mode, const char* const* types = nullptr, uint8_t count = 0); // Drop the unwanted sentences while framing.
+    uint32_t getFilteredCount() const; // Get the number of sentences dropped by the filter.
+
+    // UBX and RTCM binary protocols
+    void setUbxFramer (UBX_Framer* framer); // Set the UBX framer for the UBX frames in the stream.
+    void setRtcmFramer (RTCM_Framer* framer); // Set the RTCM framer for the RTCM 3 frames in the stream.
+    const GNSS_Demux& getDemux() const { return demux; } // Get the demultiplexer, for the byte count of each protocol.
+
+    GNSS_Stats getStats() const; // Get a snapshot of the runtime statistics.
+    void resetStats(); // Set the runtime statistics to 0.
+    bool sendUbx (uint8_t messageClass, uint8_t id, const uint8_t* payload, uint16_t length); // Send a UBX message.
+    bool waitForUbxAck (uint8_t messageClass, uint8_t id, uint32_t timeout); // Wait for the ACK of a UBX message.
+    bool setUbxMessageRate (uint8_t messageClass, uint8_t id, uint8_t rate, uint32_t timeout = 1000); // Set the output rate of a UBX or NMEA message.
+
+    void setLogLevel (uint8_t level); // Set the runtime log level.
+    uint8_t getLogLevel() const; // Get the runtime log level.
+
+    // Print a log message if the level is enabled. Use the CSE_GNSS_LOG_* macros instead,
+    // so that the disabled levels are removed at compile time.
+    template <typename... Args>
+    static void log (CSE_GNSS* gnss, uint8_t level, const Args&... args) {
+      if ((gnss == nullptr) || (level > gnss->logLevel) || (gnss->Debug_Serial == nullptr)) {
+        return;
+      }
+
+      gnss->logPrint (args...);
+      gnss->Debug_Serial->println();
+    }
 };
 
 //======================================================================================//